@@ -29,11 +29,82 @@ CXXPORTHELPER_TOP_DIR := $(call cxxph-normalize-path, $(MY_DIR)/../../../..)
 
 LOCAL_PATH := $(CXXPORTHELPER_TOP_DIR)
 
-include $(CLEAR_VARS)
-
-# clear local variables
 SHARED_C_INCLUDES := $(LOCAL_PATH)/include
-SHARED_CFLAGS := 
+SHARED_CFLAGS := $(CXXPH_CFLAGS_$(TARGET_ARCH_ABI))
+
+#
+# multi-ISA kernels
+#
+# The sources in source/kernels are compiled once per ISA level (one static
+# library each) and the best build is selected at runtime, the same way as
+# CMakeLists.txt does (see include/cxxporthelper/impl/kernel_isa.hpp).
+#
+CXXPH_KERNEL_SRC_FILES := $(subst $(LOCAL_PATH)/,, $(wildcard $(LOCAL_PATH)/source/kernels/*.cpp))
+CXXPH_KERNEL_MODULES :=
+CXXPH_KERNEL_ISA_CFLAGS :=
+
+# $(1): build name, $(2): ISA level macro, $(3): compiler flags
+define cxxph-add-kernel-isa-build
+include $$(CLEAR_VARS)
+LOCAL_MODULE := cxxporthelper_kernels_$(1)
+LOCAL_SRC_FILES := $$(CXXPH_KERNEL_SRC_FILES)
+LOCAL_C_INCLUDES := $$(SHARED_C_INCLUDES)
+LOCAL_CFLAGS := $$(SHARED_CFLAGS) -DCXXPH_KERNEL_ISA=$(2) $(3)
+include $$(BUILD_STATIC_LIBRARY)
+CXXPH_KERNEL_MODULES += cxxporthelper_kernels_$(1)
+ifneq ($(1),generic)
+CXXPH_KERNEL_ISA_CFLAGS += -D$(2)_ENABLED=1
+endif
+endef
+
+# the baseline build (same flags as the other sources)
+$(eval $(call cxxph-add-kernel-isa-build,generic,CXXPH_KERNEL_ISA_GENERIC,))
+
+# if $(TARGET_ARCH_ABI) == {armeabi-v7a | armeabi-v7a-hard}
+ifneq (, $(filter armeabi-v7a armeabi-v7a-hard, $(TARGET_ARCH_ABI)))
+    $(eval $(call cxxph-add-kernel-isa-build,arm_neon,CXXPH_KERNEL_ISA_ARM_NEON,-mfpu=neon))
+endif
+
+# if $(TARGET_ARCH_ABI) == arm64-v8a (NEON is always available)
+ifneq (, $(filter arm64-v8a, $(TARGET_ARCH_ABI)))
+    $(eval $(call cxxph-add-kernel-isa-build,arm_neon,CXXPH_KERNEL_ISA_ARM_NEON,))
+endif
+
+# if $(TARGET_ARCH_ABI) == {x86 | x86_64}
+ifneq (, $(filter x86 x86_64, $(TARGET_ARCH_ABI)))
+    CXXPH_KERNEL_FLAGS_X86_SSE4_2 := -msse4.2 -mpopcnt
+    CXXPH_KERNEL_FLAGS_X86_AVX2 := $(CXXPH_KERNEL_FLAGS_X86_SSE4_2) -mavx2 -mfma -mf16c -mbmi -mbmi2 -mlzcnt -mmovbe
+    CXXPH_KERNEL_FLAGS_X86_AVX512 := \
+        $(CXXPH_KERNEL_FLAGS_X86_AVX2) -mavx512f -mavx512cd -mavx512dq -mavx512bw -mavx512vl
+
+    $(eval $(call cxxph-add-kernel-isa-build,x86_sse4_2,CXXPH_KERNEL_ISA_X86_SSE4_2,$(CXXPH_KERNEL_FLAGS_X86_SSE4_2)))
+    $(eval $(call cxxph-add-kernel-isa-build,x86_avx2,CXXPH_KERNEL_ISA_X86_AVX2,$(CXXPH_KERNEL_FLAGS_X86_AVX2)))
+    $(eval $(call cxxph-add-kernel-isa-build,x86_avx512,CXXPH_KERNEL_ISA_X86_AVX512,$(CXXPH_KERNEL_FLAGS_X86_AVX512)))
+endif
+
+#
+# ARMv8 CRC32 instructions (crc32c, selected at runtime by support_arm_crc32())
+#
+# ndk-build has no per-file flags, so crc32c_arm.cpp is compiled as a separate
+# module with the CRC32 extension enabled, the same as CMakeLists.txt does.
+#
+CXXPH_CRC32C_ARM_MODULE :=
+CXXPH_CRC32C_ARM_CFLAGS :=
+
+# if $(TARGET_ARCH_ABI) == {armeabi-v7a | armeabi-v7a-hard | arm64-v8a}
+ifneq (, $(filter armeabi-v7a armeabi-v7a-hard arm64-v8a, $(TARGET_ARCH_ABI)))
+    include $(CLEAR_VARS)
+    LOCAL_MODULE := cxxporthelper_crc32c_arm
+    LOCAL_SRC_FILES := source/arm__arm64/crc32c_arm.cpp
+    LOCAL_C_INCLUDES := $(SHARED_C_INCLUDES)
+    LOCAL_CFLAGS := $(SHARED_CFLAGS) -march=armv8-a+crc
+    include $(BUILD_STATIC_LIBRARY)
+
+    CXXPH_CRC32C_ARM_MODULE := cxxporthelper_crc32c_arm
+    CXXPH_CRC32C_ARM_CFLAGS := -DCXXPH_CRC32C_ARM_CRC32_ENABLED=1
+endif
+
+include $(CLEAR_VARS)
 
 LOCAL_MODULE := cxxporthelper_static
 LOCAL_MODULE_FILENAME := cxxporthelper
@@ -42,7 +113,8 @@ LOCAL_C_INCLUDES := $(SHARED_C_INCLUDES)
 
 # if $(TARGET_ARCH_ABI) == {armeabi | armeabi-v7a | armeabi-v7a-hard | arm64-v8a}
 ifneq (, $(filter armeabi armeabi-v7a armeabi-v7a-hard arm64-v8a, $(TARGET_ARCH_ABI)))
-    LOCAL_SRC_FILES += $(wildcard $(LOCAL_PATH)/source/arm__arm64/*.cpp)
+    LOCAL_SRC_FILES += \
+        $(filter-out %/crc32c_arm.cpp, $(wildcard $(LOCAL_PATH)/source/arm__arm64/*.cpp))
 endif
 
 # if $(TARGET_ARCH_ABI) == {x86 | x86_64}
@@ -53,16 +125,16 @@ endif
 # remove unnecessary $(LOCAL_PATH)
 LOCAL_SRC_FILES := $(subst $(LOCAL_PATH)/,, $(LOCAL_SRC_FILES))
 
-SHARED_CFLAGS += $(CXXPH_CFLAGS_$(TARGET_ARCH_ABI))
-
 LOCAL_C_INCLUDES := \
     $(SHARED_C_INCLUDES) \
     $(NDK_ROOT)/sources/android/cpufeatures
 
 LOCAL_CFLAGS := \
-    $(SHARED_CFLAGS)
+    $(SHARED_CFLAGS) \
+    $(CXXPH_KERNEL_ISA_CFLAGS) \
+    $(CXXPH_CRC32C_ARM_CFLAGS)
 
-LOCAL_STATIC_LIBRARIES := cpufeatures
+LOCAL_STATIC_LIBRARIES := $(CXXPH_KERNEL_MODULES) $(CXXPH_CRC32C_ARM_MODULE) cpufeatures
 
 # export
 LOCAL_EXPORT_C_INCLUDES := $(SHARED_C_INCLUDES)
@@ -76,5 +148,10 @@ endif
 # clear local variables
 SHARED_C_INCLUDES :=
 SHARED_CFLAGS := 
+CXXPH_KERNEL_SRC_FILES :=
+CXXPH_KERNEL_MODULES :=
+CXXPH_KERNEL_ISA_CFLAGS :=
+CXXPH_CRC32C_ARM_MODULE :=
+CXXPH_CRC32C_ARM_CFLAGS :=
 
 include $(BUILD_STATIC_LIBRARY)
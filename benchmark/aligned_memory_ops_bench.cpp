@@ -0,0 +1,167 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+//
+// aligned_memory_ops vs. C library benchmark
+//
+// Measures fill / copy / move of cache line aligned blocks for every kernel
+// build the CPU supports and for memset() / memcpy() / memmove(), so the
+// crossover (CXXPH_CONFIG_ALIGNED_MEMORY_OPS_LIBC_THRESHOLD) can be checked
+// on the target. The threshold is compiled into the library, so configure
+// the library itself with it set to 0 to measure the kernels below the
+// default threshold too, ex.
+//
+//   cmake -DCXXPH_BUILD_BENCHMARKS=ON -DCMAKE_CXX_FLAGS=-DCXXPH_CONFIG_ALIGNED_MEMORY_OPS_LIBC_THRESHOLD=0 ..
+//
+//   usage: cxxporthelper_aligned_memory_ops_bench [min_time_ms]
+//
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <cxxporthelper/aligned_memory.hpp>
+#include <cxxporthelper/aligned_memory_ops.hpp>
+#include <cxxporthelper/dispatch.hpp>
+
+using namespace cxxporthelper;
+
+namespace {
+
+typedef std::chrono::steady_clock clock_type;
+
+enum op_t { OP_FILL, OP_COPY, OP_MOVE, NUM_OPS };
+
+const char *const op_names[NUM_OPS] = { "fill", "copy", "move" };
+
+// NOTE: called through volatile pointers so the compiler can not inline or drop the calls
+void *(*volatile libc_memset)(void *, int, std::size_t) = &std::memset;
+void *(*volatile libc_memcpy)(void *, const void *, std::size_t) = &std::memcpy;
+void *(*volatile libc_memmove)(void *, const void *, std::size_t) = &std::memmove;
+
+void run_once(op_t op, bool libc, unsigned char *dest, const unsigned char *src, std::size_t size, int i)
+{
+    switch (op) {
+    case OP_FILL:
+        if (libc) {
+            libc_memset(dest, i, size);
+        } else {
+            aligned_memory_ops::fill(dest, i, size);
+        }
+        break;
+    case OP_COPY:
+        if (libc) {
+            libc_memcpy(dest, src, size);
+        } else {
+            aligned_memory_ops::copy(dest, src, size);
+        }
+        break;
+    case OP_MOVE:
+        // overlapped by one cache line (dest > src, backward copy)
+        if (libc) {
+            libc_memmove(dest, dest - aligned_memory_ops::REQUIRED_ALIGNMENT, size);
+        } else {
+            aligned_memory_ops::move(dest, dest - aligned_memory_ops::REQUIRED_ALIGNMENT, size);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+// [ns / call]
+double measure(op_t op, bool libc, unsigned char *dest, const unsigned char *src, std::size_t size, double min_time_ms)
+{
+    std::size_t iterations = 1;
+
+    for (;;) {
+        const clock_type::time_point start = clock_type::now();
+
+        for (std::size_t i = 0; i < iterations; ++i) {
+            run_once(op, libc, dest, src, size, static_cast<int>(i));
+        }
+
+        const double elapsed_ns = std::chrono::duration<double, std::nano>(clock_type::now() - start).count();
+
+        if (elapsed_ns >= (min_time_ms * 1e6)) {
+            return elapsed_ns / iterations;
+        }
+
+        iterations *= 2;
+    }
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    static const std::size_t sizes[] = { 64,        128,       256,         512,         1024,     2048,
+                                         4096,      8192,      16 * 1024,   64 * 1024,   256 * 1024,
+                                         1024 * 1024, 4 * 1024 * 1024, 16 * 1024 * 1024 };
+    static const dispatch::isa_level_t levels[] = { dispatch::ISA_LEVEL_GENERIC, dispatch::ISA_LEVEL_X86_SSE4_2,
+                                                    dispatch::ISA_LEVEL_X86_AVX2, dispatch::ISA_LEVEL_X86_AVX512,
+                                                    dispatch::ISA_LEVEL_ARM_NEON };
+    const std::size_t num_sizes = sizeof(sizes) / sizeof(sizes[0]);
+    const std::size_t num_levels = sizeof(levels) / sizeof(levels[0]);
+    const std::size_t max_size = sizes[num_sizes - 1];
+    const std::size_t margin = aligned_memory_ops::REQUIRED_ALIGNMENT;
+    const double min_time_ms = (argc >= 2) ? std::atof(argv[1]) : 50.0;
+
+    aligned_memory<unsigned char> dest_buffer(max_size + margin, margin);
+    aligned_memory<unsigned char> src_buffer(max_size + 2048, margin);
+    unsigned char *dest = dest_buffer.get() + margin;
+    // NOTE: src is offset by 2 KiB from dest (mod 4 KiB) to avoid 4K aliasing between the loads and stores
+    const unsigned char *src = src_buffer.get() + ((2048 + margin) & 4095);
+
+    // NOTE: the values the library is built with, not the ones of this program
+    std::printf("libc threshold: %u bytes, non-temporal threshold: %u bytes\n",
+                static_cast<unsigned int>(aligned_memory_ops::get_libc_threshold()),
+                static_cast<unsigned int>(aligned_memory_ops::get_non_temporal_store_threshold()));
+
+    for (int op = 0; op < NUM_OPS; ++op) {
+        std::printf("\n[%s] ns/call (ratio to libc)\n", op_names[op]);
+        std::printf("%10s %10s", "size", "libc");
+        for (std::size_t j = 0; j < num_levels; ++j) {
+            if (dispatch::is_isa_level_supported(levels[j]) && dispatch::is_isa_level_built(levels[j])) {
+                std::printf(" %20s", dispatch::get_isa_level_name(levels[j]));
+            }
+        }
+        std::printf("\n");
+
+        for (std::size_t i = 0; i < num_sizes; ++i) {
+            const std::size_t size = sizes[i];
+            const double libc_ns = measure(static_cast<op_t>(op), true, dest, src, size, min_time_ms);
+
+            std::printf("%10u %10.1f", static_cast<unsigned int>(size), libc_ns);
+
+            for (std::size_t j = 0; j < num_levels; ++j) {
+                if (!(dispatch::is_isa_level_supported(levels[j]) && dispatch::is_isa_level_built(levels[j]))) {
+                    continue;
+                }
+
+                dispatch::set_isa_level_limit(levels[j]);
+                dispatch::resolve_all_dispatchers();
+
+                const double ns = measure(static_cast<op_t>(op), false, dest, src, size, min_time_ms);
+                std::printf(" %12.1f (%5.2f)", ns, ns / libc_ns);
+            }
+            std::printf("\n");
+        }
+    }
+
+    return 0;
+}
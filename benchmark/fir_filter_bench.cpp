@@ -0,0 +1,136 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+//
+// fir_filter::process() benchmark
+//
+// Measures the direct form FIR filter for some tap counts and block sizes at
+// every kernel build the CPU supports. Build it with
+// CXXPH_ENABLE_ARM64_NEON_INLINE_ASM=ON and =OFF and compare the ARM NEON
+// columns to see the effect of the inline assembly lane operations on AArch64
+// (see run_arm64_lane_ops_bench.sh).
+//
+//   usage: cxxporthelper_fir_filter_bench [min_time_ms]
+//
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <cxxporthelper/arm_neon.hpp>
+#include <cxxporthelper/dispatch.hpp>
+#include <cxxporthelper/fir_filter.hpp>
+
+using namespace cxxporthelper;
+
+namespace {
+
+#if defined(CXXPH_ARM64_NEON_LANE_OPS_USE_INLINE_ASM)
+const char *const lane_ops_name = (CXXPH_ARM64_NEON_LANE_OPS_USE_INLINE_ASM) ? "inline asm" : "intrinsics";
+#else
+const char *const lane_ops_name = "n/a (not AArch64)";
+#endif
+
+typedef std::chrono::steady_clock clock_type;
+
+// [ns / output sample]
+double measure(float *dest, const float *src, const float *coeffs, std::size_t num_taps, std::size_t n,
+               double min_time_ms)
+{
+    std::size_t iterations = 1;
+
+    for (;;) {
+        const clock_type::time_point start = clock_type::now();
+
+        for (std::size_t i = 0; i < iterations; ++i) {
+            fir_filter::process(dest, src, coeffs, num_taps, n);
+        }
+
+        const double elapsed_ns = std::chrono::duration<double, std::nano>(clock_type::now() - start).count();
+
+        if (elapsed_ns >= (min_time_ms * 1e6)) {
+            return elapsed_ns / iterations / n;
+        }
+
+        iterations *= 2;
+    }
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    static const std::size_t tap_counts[] = { 4, 8, 16, 31, 64, 128 };
+    static const std::size_t block_sizes[] = { 64, 256, 1024 };
+    static const dispatch::isa_level_t levels[] = { dispatch::ISA_LEVEL_GENERIC, dispatch::ISA_LEVEL_X86_SSE4_2,
+                                                    dispatch::ISA_LEVEL_X86_AVX2, dispatch::ISA_LEVEL_X86_AVX512,
+                                                    dispatch::ISA_LEVEL_ARM_NEON };
+    const std::size_t num_tap_counts = sizeof(tap_counts) / sizeof(tap_counts[0]);
+    const std::size_t num_block_sizes = sizeof(block_sizes) / sizeof(block_sizes[0]);
+    const std::size_t num_levels = sizeof(levels) / sizeof(levels[0]);
+    const std::size_t max_taps = tap_counts[num_tap_counts - 1];
+    const std::size_t max_block_size = block_sizes[num_block_sizes - 1];
+    const double min_time_ms = (argc >= 2) ? std::atof(argv[1]) : 50.0;
+
+    std::vector<float> src((max_taps - 1) + max_block_size);
+    std::vector<float> dest(max_block_size);
+    std::vector<float> coeffs(max_taps);
+
+    for (std::size_t i = 0; i < src.size(); ++i) {
+        src[i] = static_cast<float>(static_cast<int>(i % 97) - 48) * (1.0f / 48);
+    }
+
+    for (std::size_t i = 0; i < coeffs.size(); ++i) {
+        coeffs[i] = 1.0f / static_cast<float>(i + 1);
+    }
+
+    std::printf("AArch64 NEON lane ops: %s\n", lane_ops_name);
+
+    std::printf("\n[process] ns/sample\n");
+    std::printf("%6s %6s", "taps", "n");
+    for (std::size_t j = 0; j < num_levels; ++j) {
+        if (dispatch::is_isa_level_supported(levels[j]) && dispatch::is_isa_level_built(levels[j])) {
+            std::printf(" %12s", dispatch::get_isa_level_name(levels[j]));
+        }
+    }
+    std::printf("\n");
+
+    for (std::size_t t = 0; t < num_tap_counts; ++t) {
+        for (std::size_t b = 0; b < num_block_sizes; ++b) {
+            const std::size_t num_taps = tap_counts[t];
+            const std::size_t n = block_sizes[b];
+            // NOTE: the history samples of the longest filter are skipped for the shorter ones
+            const float *s = &src[max_taps - num_taps];
+
+            std::printf("%6u %6u", static_cast<unsigned int>(num_taps), static_cast<unsigned int>(n));
+
+            for (std::size_t j = 0; j < num_levels; ++j) {
+                if (!(dispatch::is_isa_level_supported(levels[j]) && dispatch::is_isa_level_built(levels[j]))) {
+                    continue;
+                }
+
+                dispatch::set_isa_level_limit(levels[j]);
+                dispatch::resolve_all_dispatchers();
+
+                std::printf(" %12.3f", measure(&dest[0], s, &coeffs[0], num_taps, n, min_time_ms));
+            }
+            std::printf("\n");
+        }
+    }
+
+    return 0;
+}
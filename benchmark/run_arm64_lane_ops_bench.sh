@@ -0,0 +1,48 @@
+#!/bin/bash
+#
+#    Copyright (C) 2014 Haruki Hasegawa
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+#    limitations under the License.
+#
+
+#
+# Builds cxxporthelper_fir_filter_bench with CXXPH_ENABLE_ARM64_NEON_INLINE_ASM=OFF (intrinsics)
+# and =ON (inline asm) and runs both, to compare the AArch64 NEON lane operations.
+#
+#   usage: run_arm64_lane_ops_bench.sh [build_dir] [min_time_ms] [extra cmake args...]
+#
+
+set -e
+
+SOURCE_DIR=$(cd "$(dirname "$0")/.." && pwd)
+BUILD_DIR=${1:-build_lane_ops_bench}
+MIN_TIME_MS=${2:-50}
+shift $(( $# < 2 ? $# : 2 ))
+
+mkdir -p "${BUILD_DIR}"
+BUILD_DIR=$(cd "${BUILD_DIR}" && pwd)
+
+# NOTE: configured from inside the build directory (cmake -S / -B requires CMake 3.13)
+for ASM in OFF ON; do
+    mkdir -p "${BUILD_DIR}/inline_asm_${ASM}"
+    (cd "${BUILD_DIR}/inline_asm_${ASM}" && \
+        cmake "${SOURCE_DIR}" -DCMAKE_BUILD_TYPE=Release \
+            -DCXXPH_BUILD_BENCHMARKS=ON -DCXXPH_ENABLE_ARM64_NEON_INLINE_ASM=${ASM} "$@" > /dev/null && \
+        cmake --build . --target cxxporthelper_fir_filter_bench > /dev/null)
+done
+
+for ASM in OFF ON; do
+    echo "=== CXXPH_ENABLE_ARM64_NEON_INLINE_ASM=${ASM}"
+    "${BUILD_DIR}/inline_asm_${ASM}/benchmark/cxxporthelper_fir_filter_bench" "${MIN_TIME_MS}"
+    echo
+done
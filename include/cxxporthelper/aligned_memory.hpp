@@ -20,6 +20,7 @@
 #include <new>
 
 #include <cxxporthelper/cstddef>
+#include <cxxporthelper/cstdint>
 #include <cxxporthelper/type_traits>
 #include <cxxporthelper/utility>
 #include <cxxporthelper/memory>
@@ -74,12 +75,35 @@ struct aligned_memory_deleter<T[]> {
     }
 };
 
+/**
+ * Prefetch a memory range.
+ *
+ * Issues one prefetch per cache line in [addr, addr + size).
+ *
+ * @tparam RW 0: read, 1: write
+ * @tparam Locality CXXPH_PREFETCH_LOCALITY_xxx
+ * @param addr [in] start address
+ * @param size [in] size of the range [bytes]
+ */
+template <int RW, int Locality>
+inline void prefetch_range(const void *addr, std::size_t size) CXXPH_NOEXCEPT
+{
+    const uintptr_t line_mask = ~static_cast<uintptr_t>(CXXPH_PLATFORM_CACHE_LINE_SIZE - 1);
+    const uintptr_t start = reinterpret_cast<uintptr_t>(addr) & line_mask;
+    const uintptr_t end = reinterpret_cast<uintptr_t>(addr) + size;
+
+    for (uintptr_t p = start; p < end; p += CXXPH_PLATFORM_CACHE_LINE_SIZE) {
+        CXXPH_PREFETCH(reinterpret_cast<const char *>(p), RW, Locality);
+    }
+}
+
 /**
  * Aligned memory allocator.
  *
  * @tparam T data type
+ * @tparam D deleter type (ex. aligned_memory_deferred_deleter<T[]>)
  */
-template <typename T>
+template <typename T, typename D = aligned_memory_deleter<T[]> >
 class aligned_memory {
 
     /// @cond INTERNAL_FIELD
@@ -106,7 +130,7 @@ public:
     /**
      * Deleter type.
      */
-    typedef aligned_memory_deleter<T[]> deleter_type;
+    typedef D deleter_type;
 
     enum { DEFAULT_ALIGNMENT = CXXPH_PLATFORM_CACHE_LINE_SIZE };
 
@@ -127,10 +151,31 @@ public:
         allocate(size, alignment, zero_clear);
     }
 
+    /**
+     * Constructor.
+     *
+     * @param deleter [in] deleter used to release the buffer
+     */
+    explicit aligned_memory(const deleter_type &deleter) CXXPH_NOEXCEPT : ptr_(nullptr, deleter), size_(0) {}
+
+    /**
+     * Constructor.
+     *
+     * @param size [in] size of allocation block (unit: data_type element)
+     * @param alignment [in] memory alignment [bytes]
+     * @param zero_clear [in] zero filling
+     * @param deleter [in] deleter used to release the buffer
+     */
+    aligned_memory(size_type size, std::size_t alignment, bool zero_clear, const deleter_type &deleter)
+        : ptr_(nullptr, deleter), size_(0)
+    {
+        allocate(size, alignment, zero_clear);
+    }
+
     /**
      * Move constructor
      */
-    aligned_memory(aligned_memory &&other) CXXPH_NOEXCEPT : ptr_(), size_(0) { move(other); }
+    aligned_memory(aligned_memory &&other) CXXPH_NOEXCEPT : ptr_(), size_(0) { move(std::move(other)); }
 
     /**
      * Destructor.
@@ -208,6 +253,39 @@ public:
      */
     explicit operator bool() const CXXPH_NOEXCEPT { return static_cast<bool>(ptr_); }
 
+    /**
+     * Prefetch a part of the buffer for reading.
+     *
+     * @param offset [in] start index (unit: data_type element)
+     * @param count [in] number of elements
+     */
+    void prefetch_read(size_type offset, size_type count) const CXXPH_NOEXCEPT
+    {
+        prefetch_range<0, CXXPH_PREFETCH_LOCALITY_HIGH>(get() + offset, sizeof(T) * count);
+    }
+
+    /**
+     * Prefetch a part of the buffer for writing.
+     *
+     * @param offset [in] start index (unit: data_type element)
+     * @param count [in] number of elements
+     */
+    void prefetch_write(size_type offset, size_type count) const CXXPH_NOEXCEPT
+    {
+        prefetch_range<1, CXXPH_PREFETCH_LOCALITY_HIGH>(get() + offset, sizeof(T) * count);
+    }
+
+    /**
+     * Get deleter.
+     *
+     * @returns reference to the deleter used to release the buffer
+     */
+    /// @{
+    deleter_type &get_deleter() CXXPH_NOEXCEPT { return ptr_.get_deleter(); }
+
+    const deleter_type &get_deleter() const CXXPH_NOEXCEPT { return ptr_.get_deleter(); }
+    /// @}
+
     /**
      * Move operation.
      */
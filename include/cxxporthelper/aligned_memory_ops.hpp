@@ -0,0 +1,101 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#ifndef CXXPORTHELPER_ALIGNED_MEMORY_OPS_HPP_
+#define CXXPORTHELPER_ALIGNED_MEMORY_OPS_HPP_
+
+//
+// Bulk fill / copy / move of cache line aligned memory blocks
+//
+// Replacements of memset() / memcpy() / memmove() for buffers allocated by
+// aligned_memory (or any buffer aligned to CXXPH_PLATFORM_CACHE_LINE_SIZE):
+// the blocks are processed with aligned vector loads and stores of the best
+// kernel build for the CPU, without the alignment prologue of the C library
+// functions. Blocks of CXXPH_CONFIG_NON_TEMPORAL_STORE_THRESHOLD bytes or
+// larger are written with non-temporal stores (x86 only) to keep them from
+// evicting the working set from the caches. Blocks smaller than
+// CXXPH_CONFIG_ALIGNED_MEMORY_OPS_LIBC_THRESHOLD bytes are forwarded to the
+// C library functions, which are as fast or faster there.
+//
+// The size does not have to be a multiple of the cache line size, the
+// remaining bytes are processed by the C library functions.
+//
+
+#include <cxxporthelper/compiler.hpp>
+#include <cxxporthelper/cstddef>
+#include <cxxporthelper/impl/cxxporthelper_config.hpp>
+
+namespace cxxporthelper {
+namespace aligned_memory_ops {
+
+enum {
+    /**
+     * Required alignment of the dest / src pointers [bytes]
+     */
+    REQUIRED_ALIGNMENT = CXXPH_PLATFORM_CACHE_LINE_SIZE
+};
+
+/**
+ * Fill memory block (memset() equivalent)
+ *
+ * @param dest [out] destination (aligned to REQUIRED_ALIGNMENT)
+ * @param value [in] byte value
+ * @param size [in] size of the block [bytes]
+ */
+void fill(void *dest, int value, std::size_t size);
+
+/**
+ * Zero-clear memory block
+ *
+ * @param dest [out] destination (aligned to REQUIRED_ALIGNMENT)
+ * @param size [in] size of the block [bytes]
+ */
+inline void zero(void *dest, std::size_t size) { fill(dest, 0, size); }
+
+/**
+ * Copy memory block (memcpy() equivalent, the blocks must not overlap)
+ *
+ * @param dest [out] destination (aligned to REQUIRED_ALIGNMENT)
+ * @param src [in] source (aligned to REQUIRED_ALIGNMENT)
+ * @param size [in] size of the block [bytes]
+ */
+void copy(void *dest, const void *src, std::size_t size);
+
+/**
+ * Move memory block (memmove() equivalent, the blocks may overlap)
+ *
+ * @param dest [out] destination (aligned to REQUIRED_ALIGNMENT)
+ * @param src [in] source (aligned to REQUIRED_ALIGNMENT)
+ * @param size [in] size of the block [bytes]
+ */
+void move(void *dest, const void *src, std::size_t size);
+
+/**
+ * Get the size below which the blocks are forwarded to the C library functions [bytes]
+ * (CXXPH_CONFIG_ALIGNED_MEMORY_OPS_LIBC_THRESHOLD of the library build, 0: never)
+ */
+std::size_t get_libc_threshold() CXXPH_NOEXCEPT;
+
+/**
+ * Get the size from which the blocks are written with non-temporal stores [bytes]
+ * (CXXPH_CONFIG_NON_TEMPORAL_STORE_THRESHOLD of the library build, 0: never)
+ */
+std::size_t get_non_temporal_store_threshold() CXXPH_NOEXCEPT;
+
+} // namespace aligned_memory_ops
+} // namespace cxxporthelper
+
+#endif // CXXPORTHELPER_ALIGNED_MEMORY_OPS_HPP_
@@ -0,0 +1,154 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#ifndef CXXPORTHELPER_ALIGNED_MEMORY_RECLAIMER_HPP_
+#define CXXPORTHELPER_ALIGNED_MEMORY_RECLAIMER_HPP_
+
+#include <cxxporthelper/cstddef>
+#include <cxxporthelper/aligned_memory.hpp>
+#include <cxxporthelper/compiler.hpp>
+
+namespace cxxporthelper {
+
+/**
+ * Deferred reclamation queue for aligned memory blocks.
+ *
+ * Realtime threads hand blocks over with enqueue() (lock-free, no allocation),
+ * and a background thread (or any non-realtime thread calling reclaim())
+ * releases them with free_aligned().
+ */
+class aligned_memory_reclaimer {
+
+    /// @cond INTERNAL_FIELD
+    aligned_memory_reclaimer(const aligned_memory_reclaimer &) = delete;
+    aligned_memory_reclaimer &operator=(const aligned_memory_reclaimer &) = delete;
+    /// @endcond
+
+public:
+    enum { DEFAULT_CAPACITY = 1024, DEFAULT_INTERVAL_MS = 10 };
+
+    /**
+     * Constructor.
+     *
+     * @param capacity [in] max number of pending blocks (rounded up to power of two)
+     */
+    explicit aligned_memory_reclaimer(std::size_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * Destructor.
+     *
+     * Stops the background thread and releases all pending blocks.
+     */
+    ~aligned_memory_reclaimer();
+
+    /**
+     * Start the background thread.
+     *
+     * @param interval_ms [in] polling interval [milliseconds]
+     * @returns whether the background thread is running
+     */
+    bool start(unsigned int interval_ms = DEFAULT_INTERVAL_MS);
+
+    /**
+     * Stop the background thread.
+     *
+     * Pending blocks are released before returning.
+     */
+    void stop();
+
+    /**
+     * Enqueue a block allocated by aligned_memory_static_impl::alloc_aligned().
+     *
+     * This function is lock-free and never allocates memory, so it can be
+     * called from realtime threads.
+     *
+     * @param ptr [in] pointer to the block
+     * @returns whether the block is enqueued (false: the queue is full)
+     */
+    bool enqueue(void *ptr) CXXPH_NOEXCEPT;
+
+    /**
+     * Release all pending blocks.
+     *
+     * @returns number of released blocks
+     */
+    std::size_t reclaim() CXXPH_NOEXCEPT;
+
+    /**
+     * Get capacity of the queue.
+     *
+     * @returns max number of pending blocks
+     */
+    std::size_t capacity() const CXXPH_NOEXCEPT;
+
+private:
+    /// @cond INTERNAL_FIELD
+    class impl;
+    impl *impl_;
+    /// @endcond
+};
+
+/**
+ * Deleter which hands blocks over to an aligned_memory_reclaimer.
+ *
+ * The block is released immediately when no reclaimer is bound or the
+ * queue is full.
+ */
+template <typename T>
+struct aligned_memory_deferred_deleter {
+    aligned_memory_deferred_deleter() CXXPH_NOEXCEPT : reclaimer_(nullptr) {}
+
+    explicit aligned_memory_deferred_deleter(aligned_memory_reclaimer *reclaimer) CXXPH_NOEXCEPT
+        : reclaimer_(reclaimer)
+    {
+    }
+
+    void operator()(T *ptr) const CXXPH_NOEXCEPT
+    {
+        if (ptr) {
+            if (!(reclaimer_ && reclaimer_->enqueue(ptr))) {
+                aligned_memory_static_impl::free_aligned(ptr);
+            }
+        }
+    }
+
+    aligned_memory_reclaimer *reclaimer_;
+};
+
+template <typename T>
+struct aligned_memory_deferred_deleter<T[]> {
+    aligned_memory_deferred_deleter() CXXPH_NOEXCEPT : reclaimer_(nullptr) {}
+
+    explicit aligned_memory_deferred_deleter(aligned_memory_reclaimer *reclaimer) CXXPH_NOEXCEPT
+        : reclaimer_(reclaimer)
+    {
+    }
+
+    void operator()(T *ptr) const CXXPH_NOEXCEPT
+    {
+        if (ptr) {
+            if (!(reclaimer_ && reclaimer_->enqueue(ptr))) {
+                aligned_memory_static_impl::free_aligned(ptr);
+            }
+        }
+    }
+
+    aligned_memory_reclaimer *reclaimer_;
+};
+
+} // namespace cxxporthelper
+
+#endif // CXXPORTHELPER_ALIGNED_MEMORY_RECLAIMER_HPP_
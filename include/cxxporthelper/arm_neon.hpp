@@ -18,6 +18,7 @@
 #define CXXPORTHELPER_ARM_NEON_HPP_
 
 #include <cxxporthelper/compiler.hpp>
+#include <cxxporthelper/impl/cxxporthelper_config.hpp>
 
 #if CXXPH_COMPILER_SUPPORTS_ARM_NEON
 #include <arm_neon.h>
@@ -29,6 +30,16 @@
 
 #elif(CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM64)
 
+// NOTE:
+// GCC can not schedule, unroll or fuse across asm statements, so the lane
+// operations use the intrinsics by default. The inline assembly is kept for
+// old toolchains (GCC < 5) with incomplete AArch64 lane intrinsics.
+#if CXXPH_COMPILER_IS_GCC && (CXXPH_CONFIG_ARM64_NEON_USE_INLINE_ASM || (CXXPH_GCC_VERSION < 50000))
+#define CXXPH_ARM64_NEON_LANE_OPS_USE_INLINE_ASM 1
+#else
+#define CXXPH_ARM64_NEON_LANE_OPS_USE_INLINE_ASM 0
+#endif
+
 template <int C>
 struct vmulq_lane_f32_compat_wrapper {
     static float32x4_t op(float32x4_t a, float32x2_t b) CXXPH_NOEXCEPT
@@ -37,6 +48,8 @@ struct vmulq_lane_f32_compat_wrapper {
 
 #if CXXPH_COMPILER_IS_CLANG
         result = a * __builtin_shufflevector(b, b, C, C, C, C);
+#elif !CXXPH_ARM64_NEON_LANE_OPS_USE_INLINE_ASM
+        result = vmulq_lane_f32(a, b, C);
 #else
         asm("fmul %[result].4s, %[a].4s, %[b].2s[%[c]]\n\t"
             : [result] "=w"(result)
@@ -55,6 +68,8 @@ struct vmulq_lane_f32_ex_wrapper {
 
 #if CXXPH_COMPILER_IS_CLANG
         result = a * __builtin_shufflevector(b, b, C, C, C, C);
+#elif !CXXPH_ARM64_NEON_LANE_OPS_USE_INLINE_ASM
+        result = vmulq_laneq_f32(a, b, C);
 #else
         asm("fmul %[result].4s, %[a].4s, %[b].4s[%[c]]\n\t"
             : [result] "=w"(result)
@@ -76,6 +91,8 @@ struct vmlaq_lane_f32_compat_wrapper {
         result = a + b * __builtin_shufflevector(c, c, D, D, D, D);
 
         return result;
+#elif !CXXPH_ARM64_NEON_LANE_OPS_USE_INLINE_ASM
+        return vfmaq_lane_f32(a, b, c, D);
 #else
 #if 0
         float32x4_t result;
@@ -107,6 +124,8 @@ struct vmlaq_lane_f32_ex_wrapper {
         result = a + b * __builtin_shufflevector(c, c, D, D, D, D);
 
         return result;
+#elif !CXXPH_ARM64_NEON_LANE_OPS_USE_INLINE_ASM
+        return vfmaq_laneq_f32(a, b, c, D);
 #else
 #if 0
         float32x4_t result;
@@ -135,6 +154,161 @@ struct vmlaq_lane_f32_ex_wrapper {
 
 #endif
 
+namespace cxxporthelper {
+namespace armneon {
+//
+// load & store operators
+//
+// These have the same static load()/store() interface as the ones in
+// x86_intrinsics.hpp. NEON does not require alignment, the *_aligned variants
+// only pass the 16 bytes alignment hint to the compiler.
+//
+// interleaved loaders/stores (vld2/vld4, vst2/vst4) de-interleave/interleave
+// 2 or 4 element structures.
+//
+
+/// @cond INTERNAL_FIELD
+#if CXXPH_COMPILER_IS_GCC || CXXPH_COMPILER_IS_CLANG
+template <typename T>
+inline T *neon_assume_aligned(T *p) CXXPH_NOEXCEPT
+{
+    return static_cast<T *>(__builtin_assume_aligned(p, 16));
+}
+#define CXXPH_NEON_ASSUME_ALIGNED(p) ::cxxporthelper::armneon::neon_assume_aligned(p)
+#else
+#define CXXPH_NEON_ASSUME_ALIGNED(p) (p)
+#endif
+/// @endcond
+
+struct neon_f32x4_load_unaligned {
+    static float32x4_t load(const float32_t *mem_addr) CXXPH_NOEXCEPT { return vld1q_f32(mem_addr); }
+};
+
+struct neon_f32x4_load_aligned {
+    static float32x4_t load(const float32_t *mem_addr) CXXPH_NOEXCEPT
+    {
+        return vld1q_f32(CXXPH_NEON_ASSUME_ALIGNED(mem_addr));
+    }
+};
+
+struct neon_f32x4_store_unaligned {
+    static void store(float32_t *mem_addr, const float32x4_t &a) CXXPH_NOEXCEPT { vst1q_f32(mem_addr, a); }
+    static void fence() CXXPH_NOEXCEPT {}
+};
+
+struct neon_f32x4_store_aligned {
+    static void store(float32_t *mem_addr, const float32x4_t &a) CXXPH_NOEXCEPT
+    {
+        vst1q_f32(CXXPH_NEON_ASSUME_ALIGNED(mem_addr), a);
+    }
+    static void fence() CXXPH_NOEXCEPT {}
+};
+
+struct neon_s16x8_load_unaligned {
+    static int16x8_t load(const int16_t *mem_addr) CXXPH_NOEXCEPT { return vld1q_s16(mem_addr); }
+};
+
+struct neon_s16x8_load_aligned {
+    static int16x8_t load(const int16_t *mem_addr) CXXPH_NOEXCEPT
+    {
+        return vld1q_s16(CXXPH_NEON_ASSUME_ALIGNED(mem_addr));
+    }
+};
+
+struct neon_s16x8_store_unaligned {
+    static void store(int16_t *mem_addr, const int16x8_t &a) CXXPH_NOEXCEPT { vst1q_s16(mem_addr, a); }
+    static void fence() CXXPH_NOEXCEPT {}
+};
+
+struct neon_s16x8_store_aligned {
+    static void store(int16_t *mem_addr, const int16x8_t &a) CXXPH_NOEXCEPT
+    {
+        vst1q_s16(CXXPH_NEON_ASSUME_ALIGNED(mem_addr), a);
+    }
+    static void fence() CXXPH_NOEXCEPT {}
+};
+
+struct neon_s32x4_load_unaligned {
+    static int32x4_t load(const int32_t *mem_addr) CXXPH_NOEXCEPT { return vld1q_s32(mem_addr); }
+};
+
+struct neon_s32x4_load_aligned {
+    static int32x4_t load(const int32_t *mem_addr) CXXPH_NOEXCEPT
+    {
+        return vld1q_s32(CXXPH_NEON_ASSUME_ALIGNED(mem_addr));
+    }
+};
+
+struct neon_s32x4_store_unaligned {
+    static void store(int32_t *mem_addr, const int32x4_t &a) CXXPH_NOEXCEPT { vst1q_s32(mem_addr, a); }
+    static void fence() CXXPH_NOEXCEPT {}
+};
+
+struct neon_s32x4_store_aligned {
+    static void store(int32_t *mem_addr, const int32x4_t &a) CXXPH_NOEXCEPT
+    {
+        vst1q_s32(CXXPH_NEON_ASSUME_ALIGNED(mem_addr), a);
+    }
+    static void fence() CXXPH_NOEXCEPT {}
+};
+
+struct neon_f32x4x2_load_interleaved {
+    static float32x4x2_t load(const float32_t *mem_addr) CXXPH_NOEXCEPT { return vld2q_f32(mem_addr); }
+};
+
+struct neon_f32x4x2_store_interleaved {
+    static void store(float32_t *mem_addr, const float32x4x2_t &a) CXXPH_NOEXCEPT { vst2q_f32(mem_addr, a); }
+    static void fence() CXXPH_NOEXCEPT {}
+};
+
+struct neon_f32x4x4_load_interleaved {
+    static float32x4x4_t load(const float32_t *mem_addr) CXXPH_NOEXCEPT { return vld4q_f32(mem_addr); }
+};
+
+struct neon_f32x4x4_store_interleaved {
+    static void store(float32_t *mem_addr, const float32x4x4_t &a) CXXPH_NOEXCEPT { vst4q_f32(mem_addr, a); }
+    static void fence() CXXPH_NOEXCEPT {}
+};
+
+struct neon_s16x8x2_load_interleaved {
+    static int16x8x2_t load(const int16_t *mem_addr) CXXPH_NOEXCEPT { return vld2q_s16(mem_addr); }
+};
+
+struct neon_s16x8x2_store_interleaved {
+    static void store(int16_t *mem_addr, const int16x8x2_t &a) CXXPH_NOEXCEPT { vst2q_s16(mem_addr, a); }
+    static void fence() CXXPH_NOEXCEPT {}
+};
+
+struct neon_s16x8x4_load_interleaved {
+    static int16x8x4_t load(const int16_t *mem_addr) CXXPH_NOEXCEPT { return vld4q_s16(mem_addr); }
+};
+
+struct neon_s16x8x4_store_interleaved {
+    static void store(int16_t *mem_addr, const int16x8x4_t &a) CXXPH_NOEXCEPT { vst4q_s16(mem_addr, a); }
+    static void fence() CXXPH_NOEXCEPT {}
+};
+
+struct neon_s32x4x2_load_interleaved {
+    static int32x4x2_t load(const int32_t *mem_addr) CXXPH_NOEXCEPT { return vld2q_s32(mem_addr); }
+};
+
+struct neon_s32x4x2_store_interleaved {
+    static void store(int32_t *mem_addr, const int32x4x2_t &a) CXXPH_NOEXCEPT { vst2q_s32(mem_addr, a); }
+    static void fence() CXXPH_NOEXCEPT {}
+};
+
+struct neon_s32x4x4_load_interleaved {
+    static int32x4x4_t load(const int32_t *mem_addr) CXXPH_NOEXCEPT { return vld4q_s32(mem_addr); }
+};
+
+struct neon_s32x4x4_store_interleaved {
+    static void store(int32_t *mem_addr, const int32x4x4_t &a) CXXPH_NOEXCEPT { vst4q_s32(mem_addr, a); }
+    static void fence() CXXPH_NOEXCEPT {}
+};
+
+} // namespace armneon
+} // namespace cxxporthelper
+
 #endif // CXXPH_COMPILER_SUPPORTS_ARM_NEON
 
 #endif // CXXPORTHELPER_ARM_NEON_HPP_
@@ -0,0 +1,123 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#ifndef CXXPORTHELPER_BIT_OPS_HPP_
+#define CXXPORTHELPER_BIT_OPS_HPP_
+
+//
+// Bulk bit manipulation
+//
+// Bitmap scans (arrays of uint64_t words, bit i is bit (i % 64) of word
+// i / 64) and element-wise bit counts, computed by the best kernel build for
+// the CPU (POPCNT / TZCNT / LZCNT, AVX2 byte lookups, AVX-512CD, NEON vcnt /
+// vclz, or portable code).
+//
+// The arrays do not have to be aligned.
+//
+
+#include <cxxporthelper/compiler.hpp>
+#include <cxxporthelper/cstddef>
+#include <cxxporthelper/cstdint>
+
+namespace cxxporthelper {
+namespace bit_ops {
+
+/**
+ * Bit index returned when no bit matches
+ */
+const std::size_t npos = static_cast<std::size_t>(-1);
+
+/// @cond INTERNAL_FIELD
+std::size_t count_ones_bitmap(const uint64_t *bitmap, std::size_t num_words);
+void count_ones_elementwise(uint32_t *dest, const uint32_t *src, std::size_t n);
+/// @endcond
+
+//
+// bitmaps
+//
+
+/**
+ * Count the set bits of a bitmap
+ *
+ * @param bitmap [in] bitmap words
+ * @param num_words [in] number of words
+ * @returns number of set bits
+ */
+inline std::size_t count_ones(const uint64_t *bitmap, std::size_t num_words)
+{
+    return count_ones_bitmap(bitmap, num_words);
+}
+
+/**
+ * Find the lowest set bit of a bitmap
+ *
+ * @param bitmap [in] bitmap words
+ * @param num_words [in] number of words
+ * @returns bit index, or npos if all bits are clear
+ */
+std::size_t find_first_set(const uint64_t *bitmap, std::size_t num_words);
+
+/**
+ * Find the lowest clear bit of a bitmap (ex. a free slot of an allocation bitmap)
+ *
+ * @param bitmap [in] bitmap words
+ * @param num_words [in] number of words
+ * @returns bit index, or npos if all bits are set
+ */
+std::size_t find_first_clear(const uint64_t *bitmap, std::size_t num_words);
+
+/**
+ * Find the highest set bit of a bitmap
+ *
+ * @param bitmap [in] bitmap words
+ * @param num_words [in] number of words
+ * @returns bit index, or npos if all bits are clear
+ */
+std::size_t find_last_set(const uint64_t *bitmap, std::size_t num_words);
+
+/**
+ * Collect the indices of the set bits of a bitmap (in ascending order)
+ *
+ * @param dest [out] bit indices (count_ones(bitmap, num_words) elements)
+ * @param bitmap [in] bitmap words
+ * @param num_words [in] number of words
+ * @returns number of set bits
+ */
+std::size_t collect_set_bits(uint32_t *dest, const uint64_t *bitmap, std::size_t num_words);
+
+//
+// element-wise
+//
+
+/**
+ * dest[i] = number of set bits of src[i]
+ */
+inline void count_ones(uint32_t *dest, const uint32_t *src, std::size_t n) { count_ones_elementwise(dest, src, n); }
+
+/**
+ * dest[i] = number of leading zero bits of src[i] (32 for 0)
+ */
+void count_leading_zeros(uint32_t *dest, const uint32_t *src, std::size_t n);
+
+/**
+ * dest[i] = number of trailing zero bits of src[i] (32 for 0)
+ */
+void count_trailing_zeros(uint32_t *dest, const uint32_t *src, std::size_t n);
+
+} // namespace bit_ops
+} // namespace cxxporthelper
+
+#endif // CXXPORTHELPER_BIT_OPS_HPP_
@@ -111,6 +111,20 @@
 #define CXXPH_ATTR_NOINLINE __attribute__((noinline))
 #endif
 
+// "always_inline" attribute
+#if CXXPH_COMPILER_IS_MSVC
+#define CXXPH_FORCEINLINE __forceinline
+#else
+#define CXXPH_FORCEINLINE inline __attribute__((always_inline))
+#endif
+
+// thread local storage (POD types only)
+#if CXXPH_COMPILER_IS_MSVC
+#define CXXPH_THREAD_LOCAL __declspec(thread)
+#else
+#define CXXPH_THREAD_LOCAL __thread
+#endif
+
 // likely() & unlikely
 #if CXXPH_COMPILER_IS_GCC || CXXPH_COMPILER_IS_CLANG
 #define CXXPH_LIKELY(x) __builtin_expect(!!(x), true)
@@ -326,6 +340,13 @@
 #define CXXPH_COMPILER_SUPPORTS_X86_FMA 0
 #endif
 
+#if ((CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)) &&                            \
+    (CXXPH_COMPILER_IS_MSVC || defined(__F16C__))
+#define CXXPH_COMPILER_SUPPORTS_X86_F16C 1
+#else
+#define CXXPH_COMPILER_SUPPORTS_X86_F16C 0
+#endif
+
 #if ((CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)) &&                            \
     (CXXPH_COMPILER_IS_MSVC || defined(__FMA4__))
 #define CXXPH_COMPILER_SUPPORTS_X86_FMA4 1
@@ -367,6 +388,45 @@
 #define CXXPH_ARM_ARCH_VERSION 0
 #endif
 
+//
+// Software prefetch
+//
+// CXXPH_PREFETCH(addr, rw, locality)
+//   rw: 0 = read, 1 = write
+//   locality: CXXPH_PREFETCH_LOCALITY_xxx (compile-time constant)
+//
+// GCC and Clang emit prefetcht0/t1/t2/nta (x86) or prfm pld/pst l1keep/l2keep/l3keep/l1strm (AArch64)
+// for __builtin_prefetch(), so only Visual Studio needs explicit intrinsics.
+//
+#define CXXPH_PREFETCH_LOCALITY_NONE 0 // non-temporal
+#define CXXPH_PREFETCH_LOCALITY_LOW 1
+#define CXXPH_PREFETCH_LOCALITY_MODERATE 2
+#define CXXPH_PREFETCH_LOCALITY_HIGH 3
+
+#if CXXPH_COMPILER_IS_GCC || CXXPH_COMPILER_IS_CLANG
+#define CXXPH_PREFETCH(addr, rw, locality) __builtin_prefetch((addr), (rw), (locality))
+#elif CXXPH_COMPILER_IS_MSVC &&                                                                                        \
+    ((CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64))
+#include <intrin.h>
+// NOTE: MSVC defines _MM_HINT_NTA(0), _MM_HINT_T0(1), _MM_HINT_T1(2) and _MM_HINT_T2(3) (not in the GCC order),
+// so map each locality value explicitly
+#define CXXPH_PREFETCH_MSVC_HINT(locality)                                                                             \
+    (((locality) == 3) ? _MM_HINT_T0 : ((locality) == 2) ? _MM_HINT_T1 : ((locality) == 1) ? _MM_HINT_T2 : _MM_HINT_NTA)
+#define CXXPH_PREFETCH(addr, rw, locality)                                                                             \
+    ((rw) ? _m_prefetchw((const void *)(addr))                                                                         \
+          : _mm_prefetch((const char *)(addr), CXXPH_PREFETCH_MSVC_HINT(locality)))
+#elif CXXPH_COMPILER_IS_MSVC && ((CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM64))
+#include <intrin.h>
+#define CXXPH_PREFETCH(addr, rw, locality) __prefetch((const void *)(addr))
+#else
+#define CXXPH_PREFETCH(addr, rw, locality) ((void)(addr))
+#endif
+
+#define CXXPH_PREFETCH_READ(addr) CXXPH_PREFETCH((addr), 0, CXXPH_PREFETCH_LOCALITY_HIGH)
+#define CXXPH_PREFETCH_WRITE(addr) CXXPH_PREFETCH((addr), 1, CXXPH_PREFETCH_LOCALITY_HIGH)
+#define CXXPH_PREFETCH_READ_NT(addr) CXXPH_PREFETCH((addr), 0, CXXPH_PREFETCH_LOCALITY_NONE)
+#define CXXPH_PREFETCH_WRITE_NT(addr) CXXPH_PREFETCH((addr), 1, CXXPH_PREFETCH_LOCALITY_NONE)
+
 //
 // Workarounds
 //
@@ -0,0 +1,219 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#ifndef CXXPORTHELPER_COMPLEX_MATH_HPP_
+#define CXXPORTHELPER_COMPLEX_MATH_HPP_
+
+//
+// Array-wise complex arithmetic
+//
+// The inner loops of spectral processing, computed by the best kernel build
+// for the CPU. Every function is provided for both layouts:
+//
+//   interleaved : std::complex<float> arrays (real, imag, real, imag, ...)
+//   split       : separate real and imaginary planes (split_complex<float>,
+//                 see split_complex_array.hpp); no shuffles are needed, so
+//                 this is the faster layout for long multiply-accumulate loops
+//
+// interleave() / deinterleave() convert between the layouts.
+//
+// The arrays do not have to be aligned, but aligned arrays (see
+// aligned_memory.hpp) avoid loads crossing cache lines. dest may be the same
+// as a source array (but must not partially overlap).
+//
+// Products are computed as (ar * br - ai * bi, ar * bi + ai * br) without the
+// special handling of inf/NaN that std::complex applies (Annex G), and the
+// fused multiply-add is used where available, so the results may differ from
+// the std::complex operators in the last bit.
+//
+
+#include <cxxporthelper/compiler.hpp>
+#include <cxxporthelper/cstddef>
+#include <cxxporthelper/complex>
+#include <cxxporthelper/split_complex_array.hpp>
+
+namespace cxxporthelper {
+namespace complex_math {
+
+/// @cond INTERNAL_FIELD
+// NOTE: the kernels take float * (interleaved real / imaginary parts),
+// std::complex<float> arrays are array-compatible with them
+void multiply_interleaved(float *dest, const float *a, const float *b, std::size_t n);
+void multiply_conj_interleaved(float *dest, const float *a, const float *b, std::size_t n);
+void multiply_accumulate_interleaved(float *dest, const float *a, const float *b, std::size_t n);
+void magnitude_interleaved(float *dest, const float *src, std::size_t n);
+void squared_magnitude_interleaved(float *dest, const float *src, std::size_t n);
+void phase_interleaved(float *dest, const float *src, std::size_t n);
+
+void multiply_split(float *dest_re, float *dest_im, const float *a_re, const float *a_im, const float *b_re,
+                    const float *b_im, std::size_t n);
+void multiply_conj_split(float *dest_re, float *dest_im, const float *a_re, const float *a_im, const float *b_re,
+                         const float *b_im, std::size_t n);
+void multiply_accumulate_split(float *dest_re, float *dest_im, const float *a_re, const float *a_im,
+                               const float *b_re, const float *b_im, std::size_t n);
+void magnitude_split(float *dest, const float *src_re, const float *src_im, std::size_t n);
+void squared_magnitude_split(float *dest, const float *src_re, const float *src_im, std::size_t n);
+void phase_split(float *dest, const float *src_re, const float *src_im, std::size_t n);
+
+void interleaved_to_split(float *dest_re, float *dest_im, const float *src, std::size_t n);
+void split_to_interleaved(float *dest, const float *src_re, const float *src_im, std::size_t n);
+/// @endcond
+
+//
+// layout conversion
+//
+
+/**
+ * Convert interleaved complex data to the split layout
+ *
+ * @param dest [out] destination planes
+ * @param src [in] source array
+ * @param n [in] number of complex elements
+ */
+inline void deinterleave(split_complex<float> dest, const std::complex<float> *src, std::size_t n)
+{
+    interleaved_to_split(dest.real, dest.imag, reinterpret_cast<const float *>(src), n);
+}
+
+/**
+ * Convert split complex data to the interleaved layout
+ *
+ * @param dest [out] destination array
+ * @param src [in] source planes
+ * @param n [in] number of complex elements
+ */
+inline void interleave(std::complex<float> *dest, split_complex<const float> src, std::size_t n)
+{
+    split_to_interleaved(reinterpret_cast<float *>(dest), src.real, src.imag, n);
+}
+
+//
+// interleaved layout
+//
+
+/**
+ * dest[i] = a[i] * b[i]
+ */
+inline void multiply(std::complex<float> *dest, const std::complex<float> *a, const std::complex<float> *b,
+                     std::size_t n)
+{
+    multiply_interleaved(reinterpret_cast<float *>(dest), reinterpret_cast<const float *>(a),
+                         reinterpret_cast<const float *>(b), n);
+}
+
+/**
+ * dest[i] = a[i] * conj(b[i])
+ */
+inline void multiply_conj(std::complex<float> *dest, const std::complex<float> *a, const std::complex<float> *b,
+                          std::size_t n)
+{
+    multiply_conj_interleaved(reinterpret_cast<float *>(dest), reinterpret_cast<const float *>(a),
+                              reinterpret_cast<const float *>(b), n);
+}
+
+/**
+ * dest[i] += a[i] * b[i]
+ */
+inline void multiply_accumulate(std::complex<float> *dest, const std::complex<float> *a,
+                                const std::complex<float> *b, std::size_t n)
+{
+    multiply_accumulate_interleaved(reinterpret_cast<float *>(dest), reinterpret_cast<const float *>(a),
+                                    reinterpret_cast<const float *>(b), n);
+}
+
+/**
+ * dest[i] = abs(src[i]) (computed as sqrt(norm(src[i])), overflows above 1.8e19)
+ */
+inline void magnitude(float *dest, const std::complex<float> *src, std::size_t n)
+{
+    magnitude_interleaved(dest, reinterpret_cast<const float *>(src), n);
+}
+
+/**
+ * dest[i] = norm(src[i]) (= real^2 + imag^2)
+ */
+inline void squared_magnitude(float *dest, const std::complex<float> *src, std::size_t n)
+{
+    squared_magnitude_interleaved(dest, reinterpret_cast<const float *>(src), n);
+}
+
+/**
+ * dest[i] = arg(src[i]) (see simd_math.hpp for the accuracy of atan2())
+ */
+inline void phase(float *dest, const std::complex<float> *src, std::size_t n)
+{
+    phase_interleaved(dest, reinterpret_cast<const float *>(src), n);
+}
+
+//
+// split layout
+//
+
+/**
+ * dest[i] = a[i] * b[i]
+ */
+inline void multiply(split_complex<float> dest, split_complex<const float> a, split_complex<const float> b,
+                     std::size_t n)
+{
+    multiply_split(dest.real, dest.imag, a.real, a.imag, b.real, b.imag, n);
+}
+
+/**
+ * dest[i] = a[i] * conj(b[i])
+ */
+inline void multiply_conj(split_complex<float> dest, split_complex<const float> a, split_complex<const float> b,
+                          std::size_t n)
+{
+    multiply_conj_split(dest.real, dest.imag, a.real, a.imag, b.real, b.imag, n);
+}
+
+/**
+ * dest[i] += a[i] * b[i]
+ */
+inline void multiply_accumulate(split_complex<float> dest, split_complex<const float> a,
+                                split_complex<const float> b, std::size_t n)
+{
+    multiply_accumulate_split(dest.real, dest.imag, a.real, a.imag, b.real, b.imag, n);
+}
+
+/**
+ * dest[i] = abs(src[i]) (computed as sqrt(norm(src[i])), overflows above 1.8e19)
+ */
+inline void magnitude(float *dest, split_complex<const float> src, std::size_t n)
+{
+    magnitude_split(dest, src.real, src.imag, n);
+}
+
+/**
+ * dest[i] = norm(src[i]) (= real^2 + imag^2)
+ */
+inline void squared_magnitude(float *dest, split_complex<const float> src, std::size_t n)
+{
+    squared_magnitude_split(dest, src.real, src.imag, n);
+}
+
+/**
+ * dest[i] = arg(src[i]) (see simd_math.hpp for the accuracy of atan2())
+ */
+inline void phase(float *dest, split_complex<const float> src, std::size_t n)
+{
+    phase_split(dest, src.real, src.imag, n);
+}
+
+} // namespace complex_math
+} // namespace cxxporthelper
+
+#endif // CXXPORTHELPER_COMPLEX_MATH_HPP_
@@ -0,0 +1,66 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#ifndef CXXPORTHELPER_CRC32C_HPP_
+#define CXXPORTHELPER_CRC32C_HPP_
+
+//
+// CRC-32C (Castagnoli) checksum
+//
+// The CRC used by iSCSI, SCTP, ext4 and others (reflected polynomial
+// 0x82f63b78, initial value and final XOR 0xffffffff). Computed by the SSE4.2
+// crc32 instruction on x86 (3 interleaved streams for large buffers), by the
+// CRC32 extension on ARMv8 when the CPU has it (support_arm_crc32()), and by
+// a table driven fallback (slicing-by-8) elsewhere.
+//
+// Checksums can be continued over several buffers:
+//
+//   uint32_t crc = crc32c::compute(a, a_size);
+//   crc = crc32c::update(crc, b, b_size); // == compute() of a followed by b
+//
+// The data does not have to be aligned.
+//
+
+#include <cxxporthelper/compiler.hpp>
+#include <cxxporthelper/cstddef>
+#include <cxxporthelper/cstdint>
+
+namespace cxxporthelper {
+namespace crc32c {
+
+/**
+ * Continue a checksum
+ *
+ * @param crc [in] checksum of the preceding data (0 to start a new checksum)
+ * @param data [in] data
+ * @param size [in] size of data [bytes]
+ * @returns checksum of the preceding data followed by data
+ */
+uint32_t update(uint32_t crc, const void *data, std::size_t size);
+
+/**
+ * Compute a checksum
+ *
+ * @param data [in] data
+ * @param size [in] size of data [bytes]
+ * @returns checksum of data (ex. "123456789" -> 0xe3069283)
+ */
+inline uint32_t compute(const void *data, std::size_t size) { return update(0, data, size); }
+
+} // namespace crc32c
+} // namespace cxxporthelper
+
+#endif // CXXPORTHELPER_CRC32C_HPP_
@@ -0,0 +1,127 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#ifndef CXXPORTHELPER_DENORMAL_MODE_HPP_
+#define CXXPORTHELPER_DENORMAL_MODE_HPP_
+
+//
+// Denormal (subnormal) floating point handling control
+//
+// Arithmetic on denormal numbers is very slow on many CPUs (ex. decaying
+// IIR filter states and reverb tails). These functions change how the
+// calling thread handles them:
+//
+//   MODE_FLUSH_TO_ZERO       denormal results are replaced by zero
+//                            (x86: MXCSR.FTZ, ARM: FPCR/FPSCR.FZ)
+//   MODE_DENORMALS_ARE_ZERO  denormal operands are treated as zero
+//                            (x86: MXCSR.DAZ, ARM: FPCR/FPSCR.FZ)
+//
+// On ARM both modes are controlled by a single FZ bit, so they can not be
+// set independently (setting either one enables both). On x86 only the
+// SSE/AVX instructions are affected, not the x87 FPU. The mode is per
+// thread; threads created afterwards do not inherit it on all platforms.
+//
+//   void process(float *buffer, std::size_t n)
+//   {
+//       denormal_mode::scoped_mode ftz; // flush-to-zero + denormals-are-zero
+//       ...
+//   } // previous mode restored
+//
+
+#include <cxxporthelper/compiler.hpp>
+
+namespace cxxporthelper {
+namespace denormal_mode {
+
+/**
+ * Denormal handling mode flags
+ */
+enum mode_flag_t {
+    /** Denormal results are flushed to zero */
+    MODE_FLUSH_TO_ZERO = (1 << 0),
+    /** Denormal inputs are treated as zero */
+    MODE_DENORMALS_ARE_ZERO = (1 << 1),
+};
+
+/**
+ * Get the modes which can be set on this CPU.
+ *
+ * @returns combination of mode_flag_t (0 if not supported)
+ */
+unsigned int get_supported_modes() CXXPH_NOEXCEPT;
+
+/**
+ * Get the mode of the calling thread.
+ *
+ * @returns combination of mode_flag_t
+ */
+unsigned int get_mode() CXXPH_NOEXCEPT;
+
+/**
+ * Set the mode of the calling thread.
+ *
+ * Unsupported flags are ignored.
+ *
+ * @param mode [in] combination of mode_flag_t
+ * @returns previous mode
+ */
+unsigned int set_mode(unsigned int mode) CXXPH_NOEXCEPT;
+
+/**
+ * Check whether denormal results are flushed to zero on the calling thread.
+ */
+inline bool is_flush_to_zero_enabled() CXXPH_NOEXCEPT { return (get_mode() & MODE_FLUSH_TO_ZERO) != 0; }
+
+/**
+ * Check whether denormal inputs are treated as zero on the calling thread.
+ */
+inline bool is_denormals_are_zero_enabled() CXXPH_NOEXCEPT { return (get_mode() & MODE_DENORMALS_ARE_ZERO) != 0; }
+
+/**
+ * Scoped denormal handling mode
+ */
+class scoped_mode {
+    /// @cond INTERNAL_FIELD
+    scoped_mode(const scoped_mode &) = delete;
+    scoped_mode &operator=(const scoped_mode &) = delete;
+    /// @endcond
+
+public:
+    /**
+     * Constructor.
+     *
+     * @param mode [in] combination of mode_flag_t
+     */
+    explicit scoped_mode(unsigned int mode = (MODE_FLUSH_TO_ZERO | MODE_DENORMALS_ARE_ZERO)) CXXPH_NOEXCEPT
+        : prev_mode_(set_mode(mode))
+    {
+    }
+
+    /**
+     * Destructor.
+     */
+    ~scoped_mode() { set_mode(prev_mode_); }
+
+private:
+    /// @cond INTERNAL_FIELD
+    unsigned int prev_mode_;
+    /// @endcond
+};
+
+} // namespace denormal_mode
+} // namespace cxxporthelper
+
+#endif // CXXPORTHELPER_DENORMAL_MODE_HPP_
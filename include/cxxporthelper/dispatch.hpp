@@ -0,0 +1,429 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#ifndef CXXPORTHELPER_DISPATCH_HPP_
+#define CXXPORTHELPER_DISPATCH_HPP_
+
+//
+// Runtime ISA dispatch
+//
+// A kernel provides a table of variants (best first), and the first one
+// supported by the CPU is bound to a function pointer on the first call.
+// After that, a call costs one indirect jump.
+//
+//   // header
+//   void vector_add(float *dest, const float *a, const float *b, std::size_t n);
+//
+//   // source
+//   static const cxxporthelper::dispatch::kernel_variant<void (*)(float *, const float *, const float *, std::size_t)>
+//   vector_add_variants[] = {
+//       { cxxporthelper::dispatch::ISA_LEVEL_X86_AVX2, &vector_add_avx2 },
+//       { cxxporthelper::dispatch::ISA_LEVEL_GENERIC, &vector_add_generic },
+//   };
+//
+//   CXXPH_DISPATCH_DEFINE_FUNCTION(void, vector_add, (float *dest, const float *a, const float *b, std::size_t n),
+//                                  (dest, a, b, n), vector_add_variants)
+//
+// The last entry of a variant table should be ISA_LEVEL_GENERIC.
+//
+// When CXXPH_CONFIG_USE_IFUNC_DISPATCH is 1 and the target is Linux/ELF x86,
+// the function is defined as an IFUNC symbol instead, and the dynamic loader
+// binds the selected variant directly (no dispatcher load on each call).
+// The selection is made from the same CPUID feature bits as
+// platform_info_provider, but before main() runs, so set_isa_level_limit()
+// and resolve_all_dispatchers() do not affect IFUNC bound functions.
+//
+
+#include <cxxporthelper/impl/cxxporthelper_config.hpp>
+#include <cxxporthelper/compiler.hpp>
+#include <cxxporthelper/cstddef>
+#include <cxxporthelper/atomic>
+
+#if CXXPH_CONFIG_USE_IFUNC_DISPATCH && (CXXPH_COMPILER_IS_GCC || CXXPH_COMPILER_IS_CLANG) &&                         \
+    (CXXPH_TARGET_PLATFORM == CXXPH_PLATFORM_LINUX) && defined(__ELF__) &&                                             \
+    ((CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64))
+#define CXXPH_DISPATCH_USE_IFUNC 1
+#else
+#define CXXPH_DISPATCH_USE_IFUNC 0
+#endif
+
+namespace cxxporthelper {
+namespace dispatch {
+
+/**
+ * ISA level
+ */
+enum isa_level_t {
+    ISA_LEVEL_GENERIC,    // portable C++ code
+    ISA_LEVEL_X86_SSE4_2, // SSE2, SSE3, SSSE3, SSE4.1, SSE4.2, POPCNT
+    ISA_LEVEL_X86_AVX2,   // ISA_LEVEL_X86_SSE4_2 + AVX, AVX2, FMA, F16C, BMI1, BMI2, LZCNT, MOVBE
+    ISA_LEVEL_X86_AVX512, // ISA_LEVEL_X86_AVX2 + AVX-512 F, CD, DQ, BW, VL
+    ISA_LEVEL_ARM_NEON,   // NEON (Advanced SIMD)
+
+    NUM_ISA_LEVELS,
+};
+
+/**
+ * Check whether the specified ISA level is supported by the CPU.
+ *
+ * @param level [in] ISA level
+ */
+bool is_isa_level_supported(isa_level_t level) CXXPH_NOEXCEPT;
+
+/**
+ * Check whether the specified ISA level can be selected by dispatchers.
+ * (supported, and not above the limit set by set_isa_level_limit())
+ *
+ * @param level [in] ISA level
+ */
+bool is_isa_level_enabled(isa_level_t level) CXXPH_NOEXCEPT;
+
+/**
+ * Get the best enabled ISA level.
+ */
+isa_level_t get_best_isa_level() CXXPH_NOEXCEPT;
+
+/**
+ * Get the name of the ISA level. (ex. "x86_avx2")
+ *
+ * @param level [in] ISA level
+ * @returns name, or "unknown" for invalid values
+ */
+const char *get_isa_level_name(isa_level_t level) CXXPH_NOEXCEPT;
+
+/**
+ * Limit the ISA levels selected by dispatchers.
+ *
+ * Levels above the limit within the same architecture are not selected.
+ * (ex. ISA_LEVEL_X86_SSE4_2 disables the AVX2 and AVX-512 variants,
+ * ISA_LEVEL_GENERIC disables all the non-generic variants)
+ * Dispatchers already resolved keep their selection until
+ * resolve_all_dispatchers() is called.
+ *
+ * @param level [in] maximum ISA level (NUM_ISA_LEVELS: no limit)
+ */
+void set_isa_level_limit(isa_level_t level) CXXPH_NOEXCEPT;
+
+/**
+ * Get the ISA level limit.
+ *
+ * @returns maximum ISA level (NUM_ISA_LEVELS: no limit, default)
+ */
+isa_level_t get_isa_level_limit() CXXPH_NOEXCEPT;
+
+/**
+ * Check whether the library kernels are built for the specified ISA level.
+ * (see CXXPH_ENABLE_MULTI_ISA_KERNELS in CMakeLists.txt)
+ *
+ * @param level [in] ISA level
+ */
+bool is_isa_level_built(isa_level_t level) CXXPH_NOEXCEPT;
+
+/**
+ * Get the ISA level of the library kernels selected at runtime.
+ */
+isa_level_t get_kernels_isa_level() CXXPH_NOEXCEPT;
+
+/**
+ * Kernel variant
+ */
+template <typename Fn>
+struct kernel_variant {
+    isa_level_t level; // required ISA level
+    Fn fn;             // implementation
+};
+
+/**
+ * Dispatcher information (introspection)
+ */
+class dispatcher_info {
+public:
+    /// @cond INTERNAL_FIELD
+    typedef void (*resolve_func_t)(dispatcher_info *self);
+
+    CXXPH_OPTIONAL_CONSTEXPR dispatcher_info(const char *name, resolve_func_t resolve_func) CXXPH_NOEXCEPT
+        : name_(name),
+          resolve_func_(resolve_func),
+          selected_level_(static_cast<int>(NUM_ISA_LEVELS)),
+          next_(nullptr),
+          registered_(false)
+    {
+    }
+    /// @endcond
+
+    /**
+     * Get the kernel name.
+     */
+    const char *name() const CXXPH_NOEXCEPT { return name_; }
+
+    /**
+     * Check whether a variant has been selected.
+     */
+    bool is_resolved() const CXXPH_NOEXCEPT
+    {
+        return selected_level_.load(std::memory_order_acquire) != static_cast<int>(NUM_ISA_LEVELS);
+    }
+
+    /**
+     * Get the ISA level of the selected variant.
+     *
+     * @returns ISA level, or NUM_ISA_LEVELS if not resolved yet
+     */
+    isa_level_t selected_isa_level() const CXXPH_NOEXCEPT
+    {
+        return static_cast<isa_level_t>(selected_level_.load(std::memory_order_acquire));
+    }
+
+    /**
+     * Check whether the function is bound by the dynamic loader (IFUNC).
+     */
+    bool is_bound_at_load_time() const CXXPH_NOEXCEPT { return (resolve_func_ == nullptr); }
+
+    /**
+     * Select the variant (again) with the current ISA level limit.
+     * (does nothing if bound at load time)
+     */
+    void resolve() CXXPH_NOEXCEPT
+    {
+        if (resolve_func_) {
+            resolve_func_(this);
+        }
+    }
+
+    /**
+     * Get the next registered dispatcher.
+     */
+    const dispatcher_info *next() const CXXPH_NOEXCEPT { return next_; }
+
+protected:
+    /// @cond INTERNAL_FIELD
+    void set_selected_level(isa_level_t level) CXXPH_NOEXCEPT
+    {
+        selected_level_.store(static_cast<int>(level), std::memory_order_release);
+    }
+    /// @endcond
+
+private:
+    /// @cond INTERNAL_FIELD
+    dispatcher_info(const dispatcher_info &) = delete;
+    dispatcher_info &operator=(const dispatcher_info &) = delete;
+
+    friend void register_dispatcher(dispatcher_info *info) CXXPH_NOEXCEPT;
+
+    const char *name_;
+    resolve_func_t resolve_func_;
+    std::atomic<int> selected_level_;
+    dispatcher_info *next_;
+    bool registered_;
+    /// @endcond
+};
+
+/// @cond INTERNAL_FIELD
+void register_dispatcher(dispatcher_info *info) CXXPH_NOEXCEPT;
+
+// returns the index of the first enabled variant (or the last one if none is enabled)
+int select_kernel_variant(const isa_level_t *levels, std::size_t stride, std::size_t num_variants) CXXPH_NOEXCEPT;
+
+// same as select_kernel_variant(), but safe to call from IFUNC resolvers (ignores the ISA level limit)
+int select_kernel_variant_at_load_time(const isa_level_t *levels, std::size_t stride,
+                                       std::size_t num_variants) CXXPH_NOEXCEPT;
+/// @endcond
+
+/**
+ * Get the first registered dispatcher.
+ *
+ * Dispatchers are registered during static initialization.
+ */
+const dispatcher_info *get_first_dispatcher() CXXPH_NOEXCEPT;
+
+/**
+ * Find a registered dispatcher by kernel name.
+ *
+ * @param name [in] kernel name
+ * @returns dispatcher, or nullptr if not found
+ */
+const dispatcher_info *find_dispatcher(const char *name) CXXPH_NOEXCEPT;
+
+/**
+ * Resolve all the registered dispatchers.
+ *
+ * Call this at startup to keep the (one time) resolution cost off
+ * realtime threads, or after set_isa_level_limit() to select again.
+ */
+void resolve_all_dispatchers() CXXPH_NOEXCEPT;
+
+/**
+ * Kernel dispatcher
+ *
+ * Construct with CXXPH_DISPATCH_DEFINE_FUNCTION(). The function pointer
+ * initially points to a trampoline which resolves the dispatcher, so the
+ * dispatcher can be called before static initialization completes.
+ */
+template <typename Fn>
+class kernel_dispatcher : public dispatcher_info {
+public:
+    typedef Fn function_type;
+    typedef kernel_variant<Fn> variant_type;
+
+    /**
+     * Constructor.
+     *
+     * @param name [in] kernel name
+     * @param variants [in] variant table (best first)
+     * @param num_variants [in] number of variants
+     * @param trampoline [in] function which calls resolve_and_get()
+     */
+    CXXPH_OPTIONAL_CONSTEXPR kernel_dispatcher(const char *name, const variant_type *variants, std::size_t num_variants,
+                                               Fn trampoline) CXXPH_NOEXCEPT
+        : dispatcher_info(name, &kernel_dispatcher::resolve_thunk),
+          variants_(variants),
+          num_variants_(num_variants),
+          fn_(trampoline)
+    {
+    }
+
+    /**
+     * Get the bound function.
+     */
+    CXXPH_FORCEINLINE Fn get() CXXPH_NOEXCEPT
+    {
+#if CXXPH_COMPILER_SUPPORTS_CONSTEXPR
+        return fn_.load(std::memory_order_relaxed);
+#else
+        // fn_ may not be initialized yet when called during static initialization
+        const Fn fn = fn_.load(std::memory_order_relaxed);
+        return (fn) ? fn : resolve_and_get();
+#endif
+    }
+
+    /**
+     * Resolve and get the bound function.
+     */
+    Fn resolve_and_get() CXXPH_NOEXCEPT
+    {
+        const int index = select_kernel_variant(&(variants_[0].level), sizeof(variant_type), num_variants_);
+        const Fn fn = variants_[index].fn;
+
+        fn_.store(fn, std::memory_order_relaxed);
+        set_selected_level(variants_[index].level);
+
+        return fn;
+    }
+
+private:
+    /// @cond INTERNAL_FIELD
+    static void resolve_thunk(dispatcher_info *self) CXXPH_NOEXCEPT
+    {
+        static_cast<kernel_dispatcher *>(self)->resolve_and_get();
+    }
+
+    const variant_type *variants_;
+    std::size_t num_variants_;
+    std::atomic<Fn> fn_;
+    /// @endcond
+};
+
+#if CXXPH_DISPATCH_USE_IFUNC
+/**
+ * IFUNC kernel dispatcher
+ *
+ * Construct with CXXPH_DISPATCH_DEFINE_FUNCTION(). Only keeps the variant
+ * table and the selection result; the call itself goes through the PLT.
+ */
+template <typename Fn>
+class ifunc_dispatcher : public dispatcher_info {
+public:
+    typedef Fn function_type;
+    typedef kernel_variant<Fn> variant_type;
+
+    /**
+     * Constructor.
+     *
+     * @param name [in] kernel name
+     * @param variants [in] variant table (best first)
+     * @param num_variants [in] number of variants
+     */
+    CXXPH_OPTIONAL_CONSTEXPR ifunc_dispatcher(const char *name, const variant_type *variants,
+                                              std::size_t num_variants) CXXPH_NOEXCEPT
+        : dispatcher_info(name, nullptr),
+          variants_(variants),
+          num_variants_(num_variants)
+    {
+    }
+
+    /**
+     * Select the variant (called from the IFUNC resolver).
+     */
+    CXXPH_FORCEINLINE Fn resolve_at_load_time() CXXPH_NOEXCEPT
+    {
+        const int index =
+            select_kernel_variant_at_load_time(&(variants_[0].level), sizeof(variant_type), num_variants_);
+
+        set_selected_level(variants_[index].level);
+
+        return variants_[index].fn;
+    }
+
+private:
+    /// @cond INTERNAL_FIELD
+    const variant_type *variants_;
+    std::size_t num_variants_;
+    /// @endcond
+};
+#endif
+
+/// @cond INTERNAL_FIELD
+struct dispatcher_registrar {
+    explicit dispatcher_registrar(dispatcher_info *info) CXXPH_NOEXCEPT { register_dispatcher(info); }
+};
+/// @endcond
+
+} // namespace dispatch
+} // namespace cxxporthelper
+
+/**
+ * Define a dispatched function
+ *
+ * @param ret return type
+ * @param name function name
+ * @param params parenthesized parameter list (ex. (float *dest, std::size_t n))
+ * @param args parenthesized argument list (ex. (dest, n))
+ * @param variants variant table (array of kernel_variant<ret(*) params>)
+ */
+#if CXXPH_DISPATCH_USE_IFUNC
+#define CXXPH_DISPATCH_DEFINE_FUNCTION(ret, name, params, args, variants)                                              \
+    typedef ret(*name##_dispatch_function_t) params;                                                                   \
+    static ::cxxporthelper::dispatch::ifunc_dispatcher<name##_dispatch_function_t> name##_dispatcher(                  \
+        #name, (variants), (sizeof(variants) / sizeof((variants)[0])));                                                \
+    static const ::cxxporthelper::dispatch::dispatcher_registrar name##_dispatch_registrar(&name##_dispatcher);        \
+    extern "C" {                                                                                                       \
+    static name##_dispatch_function_t name##_dispatch_ifunc_resolver()                                                 \
+    {                                                                                                                  \
+        return name##_dispatcher.resolve_at_load_time();                                                               \
+    }                                                                                                                  \
+    }                                                                                                                  \
+    ret name params __attribute__((ifunc(#name "_dispatch_ifunc_resolver")));
+#else
+#define CXXPH_DISPATCH_DEFINE_FUNCTION(ret, name, params, args, variants)                                              \
+    static ret name##_dispatch_trampoline params;                                                                      \
+    static ::cxxporthelper::dispatch::kernel_dispatcher<ret(*) params> name##_dispatcher(                              \
+        #name, (variants), (sizeof(variants) / sizeof((variants)[0])), &name##_dispatch_trampoline);                   \
+    static const ::cxxporthelper::dispatch::dispatcher_registrar name##_dispatch_registrar(&name##_dispatcher);        \
+    static ret name##_dispatch_trampoline params { return (name##_dispatcher.resolve_and_get()) args; }                \
+    ret name params { return (name##_dispatcher.get()) args; }
+#endif
+
+#endif // CXXPORTHELPER_DISPATCH_HPP_
@@ -0,0 +1,106 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+
+#ifndef CXXPORTHELPER_FIR_FILTER_HPP_
+#define CXXPORTHELPER_FIR_FILTER_HPP_
+
+//
+// FIR filter kernels
+//
+// Single rate FIR filters (float), computed by the best kernel build for the
+// CPU (fused multiply-add on AVX2 and later, multiply-accumulate by lane on
+// NEON). The coefficients are given in the usual order:
+//
+//   y[i] = sum(coeffs[k] * x[i - k]) for k in [0, num_taps)
+//
+// process() / process_interleaved() are direct form filters, that read the
+// past input from the num_taps - 1 history samples before the block. They
+// are the fastest when the caller keeps the input in a buffer with history
+// anyway (ex. overlapping blocks, resampling).
+//
+// process_transposed() is a block transposed form filter, that carries the
+// past input as num_taps - 1 partial sums in a state buffer instead. It does
+// not need the history samples and works in place. The direct form is faster
+// for short filters (less than about 64 taps).
+//
+// The arrays do not have to be aligned.
+//
+
+#include <cxxporthelper/compiler.hpp>
+#include <cxxporthelper/cstddef>
+
+namespace cxxporthelper {
+namespace fir_filter {
+
+/// @cond INTERNAL_FIELD
+void direct_form(float *dest, const float *src, std::size_t stride, const float *coeffs, std::size_t num_taps,
+                 std::size_t n);
+/// @endcond
+
+/**
+ * Direct form FIR filter
+ *
+ * dest[i] = sum(coeffs[k] * src[num_taps - 1 + i - k]) for k in [0, num_taps)
+ *
+ * @param dest [out] output samples (n samples, must not overlap src)
+ * @param src [in] num_taps - 1 history samples followed by the n input samples
+ * @param coeffs [in] coefficients (num_taps)
+ * @param num_taps [in] number of taps (> 0)
+ * @param n [in] number of output samples
+ */
+inline void process(float *dest, const float *src, const float *coeffs, std::size_t num_taps, std::size_t n)
+{
+    direct_form(dest, src, 1, coeffs, num_taps, n);
+}
+
+/**
+ * Direct form FIR filter (interleaved multichannel frames, same coefficients for all the channels)
+ *
+ * dest[i * num_channels + c] = sum(coeffs[k] * src[(num_taps - 1 + i - k) * num_channels + c]) for k in [0, num_taps)
+ *
+ * @param dest [out] output frames (num_frames frames, must not overlap src)
+ * @param src [in] num_taps - 1 history frames followed by the num_frames input frames
+ * @param num_channels [in] number of channels
+ * @param coeffs [in] coefficients (num_taps)
+ * @param num_taps [in] number of taps (> 0)
+ * @param num_frames [in] number of output frames
+ */
+inline void process_interleaved(float *dest, const float *src, std::size_t num_channels, const float *coeffs,
+                                std::size_t num_taps, std::size_t num_frames)
+{
+    direct_form(dest, src, num_channels, coeffs, num_taps, num_frames * num_channels);
+}
+
+/**
+ * Block transposed form FIR filter
+ *
+ * Same output as process(), with the past input kept in state.
+ *
+ * @param dest [out] output samples (n samples, may be the same as src)
+ * @param src [in] input samples (n samples)
+ * @param coeffs [in] coefficients (num_taps)
+ * @param num_taps [in] number of taps (> 0)
+ * @param state [in, out] partial sums (num_taps - 1 elements, zero-clear before the first call)
+ * @param n [in] number of samples
+ */
+void process_transposed(float *dest, const float *src, const float *coeffs, std::size_t num_taps, float *state,
+                        std::size_t n);
+
+} // namespace fir_filter
+} // namespace cxxporthelper
+
+#endif // CXXPORTHELPER_FIR_FILTER_HPP_
@@ -0,0 +1,124 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#ifndef CXXPORTHELPER_FIXED_POINT_HPP_
+#define CXXPORTHELPER_FIXED_POINT_HPP_
+
+//
+// Array-wise fixed-point arithmetic
+//
+// Q15 (int16_t, [-1.0, 1.0) in steps of 2^-15) and Q31 (int32_t, steps of
+// 2^-31) arithmetic for pipelines that stay in integer samples end to end,
+// computed by the best kernel build for the CPU (SSSE3 pmulhrsw / NEON
+// vqrdmulh for Q15, NEON vqrdmulh / SSE4.1 64-bit products for Q31).
+//
+// Products are rounded to nearest ((a * b + 2^14) >> 15 for Q15) and all
+// results saturate (-1.0 * -1.0 gives the largest positive value), so the
+// results are the same on every CPU.
+//
+// The arrays do not have to be aligned. dest may be the same as a source
+// array (but must not partially overlap).
+//
+
+#include <cxxporthelper/compiler.hpp>
+#include <cxxporthelper/cstddef>
+#include <cxxporthelper/cstdint>
+
+namespace cxxporthelper {
+namespace fixed_point {
+
+/// @cond INTERNAL_FIELD
+void multiply_q15(int16_t *dest, const int16_t *a, const int16_t *b, std::size_t n);
+void multiply_accumulate_q15(int16_t *dest, const int16_t *a, const int16_t *b, std::size_t n);
+void add_q15(int16_t *dest, const int16_t *a, const int16_t *b, std::size_t n);
+void subtract_q15(int16_t *dest, const int16_t *a, const int16_t *b, std::size_t n);
+void scale_q15(int16_t *dest, const int16_t *src, int16_t gain, std::size_t n);
+
+void multiply_q31(int32_t *dest, const int32_t *a, const int32_t *b, std::size_t n);
+void multiply_accumulate_q31(int32_t *dest, const int32_t *a, const int32_t *b, std::size_t n);
+void add_q31(int32_t *dest, const int32_t *a, const int32_t *b, std::size_t n);
+void subtract_q31(int32_t *dest, const int32_t *a, const int32_t *b, std::size_t n);
+void scale_q31(int32_t *dest, const int32_t *src, int32_t gain, std::size_t n);
+/// @endcond
+
+//
+// Q15
+//
+
+/**
+ * dest[i] = a[i] * b[i] (rounded, saturated)
+ */
+inline void multiply(int16_t *dest, const int16_t *a, const int16_t *b, std::size_t n) { multiply_q15(dest, a, b, n); }
+
+/**
+ * dest[i] += a[i] * b[i] (the product is rounded, the sum saturated)
+ */
+inline void multiply_accumulate(int16_t *dest, const int16_t *a, const int16_t *b, std::size_t n)
+{
+    multiply_accumulate_q15(dest, a, b, n);
+}
+
+/**
+ * dest[i] = a[i] + b[i] (saturated)
+ */
+inline void add(int16_t *dest, const int16_t *a, const int16_t *b, std::size_t n) { add_q15(dest, a, b, n); }
+
+/**
+ * dest[i] = a[i] - b[i] (saturated)
+ */
+inline void subtract(int16_t *dest, const int16_t *a, const int16_t *b, std::size_t n) { subtract_q15(dest, a, b, n); }
+
+/**
+ * dest[i] = src[i] * gain (rounded, saturated)
+ */
+inline void scale(int16_t *dest, const int16_t *src, int16_t gain, std::size_t n) { scale_q15(dest, src, gain, n); }
+
+//
+// Q31
+//
+
+/**
+ * dest[i] = a[i] * b[i] (rounded, saturated)
+ */
+inline void multiply(int32_t *dest, const int32_t *a, const int32_t *b, std::size_t n) { multiply_q31(dest, a, b, n); }
+
+/**
+ * dest[i] += a[i] * b[i] (the product is rounded, the sum saturated)
+ */
+inline void multiply_accumulate(int32_t *dest, const int32_t *a, const int32_t *b, std::size_t n)
+{
+    multiply_accumulate_q31(dest, a, b, n);
+}
+
+/**
+ * dest[i] = a[i] + b[i] (saturated)
+ */
+inline void add(int32_t *dest, const int32_t *a, const int32_t *b, std::size_t n) { add_q31(dest, a, b, n); }
+
+/**
+ * dest[i] = a[i] - b[i] (saturated)
+ */
+inline void subtract(int32_t *dest, const int32_t *a, const int32_t *b, std::size_t n) { subtract_q31(dest, a, b, n); }
+
+/**
+ * dest[i] = src[i] * gain (rounded, saturated)
+ */
+inline void scale(int32_t *dest, const int32_t *src, int32_t gain, std::size_t n) { scale_q31(dest, src, gain, n); }
+
+} // namespace fixed_point
+} // namespace cxxporthelper
+
+#endif // CXXPORTHELPER_FIXED_POINT_HPP_
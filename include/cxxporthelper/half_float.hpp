@@ -0,0 +1,63 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#ifndef CXXPORTHELPER_HALF_FLOAT_HPP_
+#define CXXPORTHELPER_HALF_FLOAT_HPP_
+
+//
+// Half-precision storage conversion
+//
+// Bulk conversion between float and IEEE 754 binary16 (stored as uint16_t bit
+// patterns), for buffers that are kept in half precision and processed in
+// float. Computed by the best kernel build for the CPU: F16C on x86 (the AVX2
+// level), fcvtl/fcvtn on AArch64, and bit-exact vector code elsewhere.
+//
+// float -> half rounds to nearest even; values beyond the half range become
+// infinity, and subnormal halves are kept. NaNs stay NaNs (quieted, upper
+// payload bits kept). half -> float is exact.
+//
+// The arrays do not have to be aligned.
+//
+
+#include <cxxporthelper/compiler.hpp>
+#include <cxxporthelper/cstddef>
+#include <cxxporthelper/cstdint>
+
+namespace cxxporthelper {
+namespace half_float {
+
+/**
+ * Convert half-precision values to float
+ *
+ * @param dest [out] destination array (n elements)
+ * @param src [in] half-precision values (n elements)
+ * @param n [in] number of elements
+ */
+void to_float(float *dest, const uint16_t *src, std::size_t n);
+
+/**
+ * Convert float values to half-precision
+ *
+ * @param dest [out] destination array (n elements)
+ * @param src [in] source array (n elements)
+ * @param n [in] number of elements
+ */
+void from_float(uint16_t *dest, const float *src, std::size_t n);
+
+} // namespace half_float
+} // namespace cxxporthelper
+
+#endif // CXXPORTHELPER_HALF_FLOAT_HPP_
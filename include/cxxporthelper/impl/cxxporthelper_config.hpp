@@ -126,6 +126,26 @@
 #define CXXPH_CONFIG_RUNTIME_FEATURE_CHECK_X86_POPCNT 1
 #endif
 
+// runtime F16C instructions support check
+#ifndef CXXPH_CONFIG_RUNTIME_FEATURE_CHECK_X86_F16C
+#define CXXPH_CONFIG_RUNTIME_FEATURE_CHECK_X86_F16C 1
+#endif
+
+// runtime BMI1 instructions support check
+#ifndef CXXPH_CONFIG_RUNTIME_FEATURE_CHECK_X86_BMI1
+#define CXXPH_CONFIG_RUNTIME_FEATURE_CHECK_X86_BMI1 1
+#endif
+
+// runtime BMI2 instructions support check
+#ifndef CXXPH_CONFIG_RUNTIME_FEATURE_CHECK_X86_BMI2
+#define CXXPH_CONFIG_RUNTIME_FEATURE_CHECK_X86_BMI2 1
+#endif
+
+// runtime LZCNT instruction support check
+#ifndef CXXPH_CONFIG_RUNTIME_FEATURE_CHECK_X86_LZCNT
+#define CXXPH_CONFIG_RUNTIME_FEATURE_CHECK_X86_LZCNT 1
+#endif
+
 // runtime ARMv7 instructions support check
 #ifndef CXXPH_CONFIG_RUNTIME_FEATURE_CHECK_ARM_V7
 #define CXXPH_CONFIG_RUNTIME_FEATURE_CHECK_ARM_V7 1
@@ -141,4 +161,39 @@
 #define CXXPH_CONFIG_RUNTIME_FEATURE_CHECK_ARM_NEON 1
 #endif
 
+// runtime ARM half-precision conversion instructions support check
+#ifndef CXXPH_CONFIG_RUNTIME_FEATURE_CHECK_ARM_FP16
+#define CXXPH_CONFIG_RUNTIME_FEATURE_CHECK_ARM_FP16 1
+#endif
+
+// runtime ARMv8 CRC32 instructions support check
+#ifndef CXXPH_CONFIG_RUNTIME_FEATURE_CHECK_ARM_CRC32
+#define CXXPH_CONFIG_RUNTIME_FEATURE_CHECK_ARM_CRC32 1
+#endif
+
+// realtime safety monitor (counts allocations and page faults in realtime sections)
+#ifndef CXXPH_CONFIG_ENABLE_REALTIME_SAFETY_MONITOR
+#define CXXPH_CONFIG_ENABLE_REALTIME_SAFETY_MONITOR 0
+#endif
+
+// bind dispatched functions at load time with IFUNC (Linux/ELF, x86 only; function pointers otherwise)
+#ifndef CXXPH_CONFIG_USE_IFUNC_DISPATCH
+#define CXXPH_CONFIG_USE_IFUNC_DISPATCH 0
+#endif
+
+// size from which aligned_memory_ops use non-temporal stores [bytes] (0: never)
+#ifndef CXXPH_CONFIG_NON_TEMPORAL_STORE_THRESHOLD
+#define CXXPH_CONFIG_NON_TEMPORAL_STORE_THRESHOLD (4 * 1024 * 1024)
+#endif
+
+// size below which aligned_memory_ops forward to memset() / memcpy() / memmove() [bytes] (0: never)
+#ifndef CXXPH_CONFIG_ALIGNED_MEMORY_OPS_LIBC_THRESHOLD
+#define CXXPH_CONFIG_ALIGNED_MEMORY_OPS_LIBC_THRESHOLD (64 * 1024)
+#endif
+
+// use inline assembly instead of the intrinsics for the AArch64 NEON lane operations in arm_neon.hpp (GCC only)
+#ifndef CXXPH_CONFIG_ARM64_NEON_USE_INLINE_ASM
+#define CXXPH_CONFIG_ARM64_NEON_USE_INLINE_ASM 0
+#endif
+
 #endif // CXXPORTHELPER_CXXPORTHELPER_CONFIG_HPP_
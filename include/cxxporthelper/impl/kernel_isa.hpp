@@ -0,0 +1,172 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#ifndef CXXPORTHELPER_IMPL_KERNEL_ISA_HPP_
+#define CXXPORTHELPER_IMPL_KERNEL_ISA_HPP_
+
+//
+// Multi-ISA kernel build support (internal)
+//
+// The sources in source/kernels are compiled once per ISA level with the
+// matching compiler flags and -DCXXPH_KERNEL_ISA=<level> (see CMakeLists.txt).
+// Each build puts its functions into CXXPH_KERNEL_ISA_NAMESPACE, and the
+// dispatching source (compiled with the baseline flags) builds the variant
+// table from the builds enabled by CXXPH_KERNEL_ISA_<LEVEL>_ENABLED.
+//
+//   // kernel source (source/kernels/xxx.cpp)
+//   namespace cxxporthelper { namespace xxx { namespace CXXPH_KERNEL_ISA_NAMESPACE {
+//   void foo_kernel(float *dest, std::size_t n) { ... }
+//   } } }
+//
+//   // dispatching source (source/xxx.cpp)
+//   namespace cxxporthelper { namespace xxx {
+//   CXXPH_KERNEL_DECLARE_VARIANTS(void, foo_kernel, (float *dest, std::size_t n))
+//
+//   static const dispatch::kernel_variant<void (*)(float *, std::size_t)> foo_variants[] = {
+//       CXXPH_KERNEL_VARIANT_TABLE_ENTRIES(foo_kernel)
+//   };
+//
+//   CXXPH_DISPATCH_DEFINE_FUNCTION(void, foo, (float *dest, std::size_t n), (dest, n), foo_variants)
+//   } }
+//
+// NOTE: Kernel sources are compiled with ISA specific flags, so they must not
+// instantiate inline functions or templates that baseline code also uses
+// (the linker may pick either copy). Use simd.hpp (ABI namespaced), the C
+// library and functions defined in CXXPH_KERNEL_ISA_NAMESPACE only.
+//
+
+#include <cxxporthelper/compiler.hpp>
+
+// ISA levels (same values as cxxporthelper::dispatch::isa_level_t)
+#define CXXPH_KERNEL_ISA_GENERIC 0
+#define CXXPH_KERNEL_ISA_X86_SSE4_2 1
+#define CXXPH_KERNEL_ISA_X86_AVX2 2
+#define CXXPH_KERNEL_ISA_X86_AVX512 3
+#define CXXPH_KERNEL_ISA_ARM_NEON 4
+
+// ISA level of this build
+#ifndef CXXPH_KERNEL_ISA
+#define CXXPH_KERNEL_ISA CXXPH_KERNEL_ISA_GENERIC
+#endif
+
+// builds linked into the library
+#ifndef CXXPH_KERNEL_ISA_X86_SSE4_2_ENABLED
+#define CXXPH_KERNEL_ISA_X86_SSE4_2_ENABLED 0
+#endif
+#ifndef CXXPH_KERNEL_ISA_X86_AVX2_ENABLED
+#define CXXPH_KERNEL_ISA_X86_AVX2_ENABLED 0
+#endif
+#ifndef CXXPH_KERNEL_ISA_X86_AVX512_ENABLED
+#define CXXPH_KERNEL_ISA_X86_AVX512_ENABLED 0
+#endif
+#ifndef CXXPH_KERNEL_ISA_ARM_NEON_ENABLED
+#define CXXPH_KERNEL_ISA_ARM_NEON_ENABLED 0
+#endif
+
+// namespace of this build
+#if CXXPH_KERNEL_ISA == CXXPH_KERNEL_ISA_GENERIC
+#define CXXPH_KERNEL_ISA_NAMESPACE isa_generic
+#elif CXXPH_KERNEL_ISA == CXXPH_KERNEL_ISA_X86_SSE4_2
+#define CXXPH_KERNEL_ISA_NAMESPACE isa_x86_sse4_2
+#elif CXXPH_KERNEL_ISA == CXXPH_KERNEL_ISA_X86_AVX2
+#define CXXPH_KERNEL_ISA_NAMESPACE isa_x86_avx2
+#elif CXXPH_KERNEL_ISA == CXXPH_KERNEL_ISA_X86_AVX512
+#define CXXPH_KERNEL_ISA_NAMESPACE isa_x86_avx512
+#elif CXXPH_KERNEL_ISA == CXXPH_KERNEL_ISA_ARM_NEON
+#define CXXPH_KERNEL_ISA_NAMESPACE isa_arm_neon
+#else
+#error Unknown CXXPH_KERNEL_ISA value
+#endif
+
+// check the compiler flags actually enable the instruction sets
+#include <cxxporthelper/simd.hpp>
+
+#if (CXXPH_KERNEL_ISA == CXXPH_KERNEL_ISA_X86_SSE4_2) && !CXXPH_SIMD_USE_X86_SSE4_1
+#error SSE4.2 kernels require -msse4.2
+#elif(CXXPH_KERNEL_ISA == CXXPH_KERNEL_ISA_X86_AVX2) &&                                                               \
+    !(CXXPH_SIMD_USE_X86_AVX2 && CXXPH_SIMD_USE_X86_FMA && CXXPH_SIMD_USE_X86_F16C)
+#error AVX2 kernels require -mavx2 -mfma -mf16c
+#elif(CXXPH_KERNEL_ISA == CXXPH_KERNEL_ISA_X86_AVX512) && !CXXPH_SIMD_USE_X86_AVX512F
+#error AVX-512 kernels require -mavx512f
+#elif(CXXPH_KERNEL_ISA == CXXPH_KERNEL_ISA_ARM_NEON) && !CXXPH_SIMD_USE_ARM_NEON
+#error NEON kernels require -mfpu=neon
+#endif
+
+/**
+ * Declare a kernel function in the namespaces of all builds
+ *
+ * @param ret return type
+ * @param name function name
+ * @param params parenthesized parameter list
+ */
+#define CXXPH_KERNEL_DECLARE_VARIANTS(ret, name, params)                                                               \
+    namespace isa_generic {                                                                                            \
+    ret name params;                                                                                                   \
+    }                                                                                                                  \
+    namespace isa_x86_sse4_2 {                                                                                         \
+    ret name params;                                                                                                   \
+    }                                                                                                                  \
+    namespace isa_x86_avx2 {                                                                                           \
+    ret name params;                                                                                                   \
+    }                                                                                                                  \
+    namespace isa_x86_avx512 {                                                                                         \
+    ret name params;                                                                                                   \
+    }                                                                                                                  \
+    namespace isa_arm_neon {                                                                                           \
+    ret name params;                                                                                                   \
+    }
+
+/// @cond INTERNAL_FIELD
+#if CXXPH_KERNEL_ISA_X86_AVX512_ENABLED
+#define CXXPH_KERNEL_VARIANT_ENTRY_X86_AVX512(name)                                                                    \
+    { ::cxxporthelper::dispatch::ISA_LEVEL_X86_AVX512, &isa_x86_avx512::name },
+#else
+#define CXXPH_KERNEL_VARIANT_ENTRY_X86_AVX512(name)
+#endif
+
+#if CXXPH_KERNEL_ISA_X86_AVX2_ENABLED
+#define CXXPH_KERNEL_VARIANT_ENTRY_X86_AVX2(name)                                                                      \
+    { ::cxxporthelper::dispatch::ISA_LEVEL_X86_AVX2, &isa_x86_avx2::name },
+#else
+#define CXXPH_KERNEL_VARIANT_ENTRY_X86_AVX2(name)
+#endif
+
+#if CXXPH_KERNEL_ISA_X86_SSE4_2_ENABLED
+#define CXXPH_KERNEL_VARIANT_ENTRY_X86_SSE4_2(name)                                                                    \
+    { ::cxxporthelper::dispatch::ISA_LEVEL_X86_SSE4_2, &isa_x86_sse4_2::name },
+#else
+#define CXXPH_KERNEL_VARIANT_ENTRY_X86_SSE4_2(name)
+#endif
+
+#if CXXPH_KERNEL_ISA_ARM_NEON_ENABLED
+#define CXXPH_KERNEL_VARIANT_ENTRY_ARM_NEON(name)                                                                      \
+    { ::cxxporthelper::dispatch::ISA_LEVEL_ARM_NEON, &isa_arm_neon::name },
+#else
+#define CXXPH_KERNEL_VARIANT_ENTRY_ARM_NEON(name)
+#endif
+/// @endcond
+
+/**
+ * Variant table entries of a kernel function (best first, generic last)
+ *
+ * @param name function name
+ */
+#define CXXPH_KERNEL_VARIANT_TABLE_ENTRIES(name)                                                                       \
+    CXXPH_KERNEL_VARIANT_ENTRY_X86_AVX512(name) CXXPH_KERNEL_VARIANT_ENTRY_X86_AVX2(name)                              \
+    CXXPH_KERNEL_VARIANT_ENTRY_X86_SSE4_2(name) CXXPH_KERNEL_VARIANT_ENTRY_ARM_NEON(name)                              \
+    { ::cxxporthelper::dispatch::ISA_LEVEL_GENERIC, &isa_generic::name }
+
+#endif // CXXPORTHELPER_IMPL_KERNEL_ISA_HPP_
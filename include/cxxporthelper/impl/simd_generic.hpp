@@ -0,0 +1,814 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#ifndef CXXPORTHELPER_SIMD_GENERIC_HPP_
+#define CXXPORTHELPER_SIMD_GENERIC_HPP_
+
+// NOTE: This file is included from simd.hpp
+
+#include <cstring>
+#include <limits>
+
+#include <cxxporthelper/cmath>
+#include <cxxporthelper/cstdint>
+
+namespace cxxporthelper {
+namespace simd {
+namespace CXXPH_SIMD_ABI_NAMESPACE {
+
+//
+// basic_vec<T, N> : scalar fallback
+//
+
+/// @cond INTERNAL_FIELD
+template <typename T>
+struct make_unsigned_lane;
+
+template <>
+struct make_unsigned_lane<int16_t> {
+    typedef uint16_t type;
+};
+
+template <>
+struct make_unsigned_lane<int32_t> {
+    typedef uint32_t type;
+};
+/// @endcond
+
+// binary operators are defined as friends, so scalar operands are broadcasted
+// implicitly as with the native vector types
+#define CXXPH_SIMD_GENERIC_BINARY_OP(op)                                                                               \
+    friend CXXPH_FORCEINLINE basic_vec operator op(const basic_vec &a, const basic_vec &b) CXXPH_NOEXCEPT              \
+    {                                                                                                                  \
+        basic_vec r;                                                                                                   \
+        for (int i = 0; i < N; ++i) {                                                                                  \
+            r.v[i] = static_cast<T>(a.v[i] op b.v[i]);                                                                 \
+        }                                                                                                              \
+        return r;                                                                                                      \
+    }
+
+#define CXXPH_SIMD_VEC2X_BINARY_OP(op)                                                                                 \
+    friend CXXPH_FORCEINLINE vec2x operator op(const vec2x &a, const vec2x &b) CXXPH_NOEXCEPT                          \
+    {                                                                                                                  \
+        return vec2x(a.lo op b.lo, a.hi op b.hi);                                                                      \
+    }
+
+template <typename T, int N>
+struct basic_vec_mask {
+    bool m[N];
+};
+
+template <typename T, int N>
+struct basic_vec {
+    typedef T value_type;
+    typedef basic_vec_mask<T, N> mask_type;
+    enum { num_lanes = N };
+
+    T v[N];
+
+    basic_vec() CXXPH_NOEXCEPT {}
+
+    basic_vec(T x) CXXPH_NOEXCEPT
+    {
+        for (int i = 0; i < N; ++i) {
+            v[i] = x;
+        }
+    }
+
+    static CXXPH_FORCEINLINE basic_vec zero() CXXPH_NOEXCEPT { return basic_vec(static_cast<T>(0)); }
+
+    static CXXPH_FORCEINLINE basic_vec load(const T *mem_addr) CXXPH_NOEXCEPT
+    {
+        basic_vec r;
+        for (int i = 0; i < N; ++i) {
+            r.v[i] = mem_addr[i];
+        }
+        return r;
+    }
+
+    static CXXPH_FORCEINLINE basic_vec load_aligned(const T *mem_addr) CXXPH_NOEXCEPT { return load(mem_addr); }
+
+    CXXPH_FORCEINLINE void store(T *mem_addr) const CXXPH_NOEXCEPT
+    {
+        for (int i = 0; i < N; ++i) {
+            mem_addr[i] = v[i];
+        }
+    }
+
+    CXXPH_FORCEINLINE void store_aligned(T *mem_addr) const CXXPH_NOEXCEPT { store(mem_addr); }
+
+    CXXPH_FORCEINLINE void store_stream(T *mem_addr) const CXXPH_NOEXCEPT { store(mem_addr); }
+
+    CXXPH_SIMD_GENERIC_BINARY_OP(+)
+    CXXPH_SIMD_GENERIC_BINARY_OP(-)
+    CXXPH_SIMD_GENERIC_BINARY_OP(*)
+    CXXPH_SIMD_GENERIC_BINARY_OP(/)
+    CXXPH_SIMD_GENERIC_BINARY_OP(&)
+    CXXPH_SIMD_GENERIC_BINARY_OP(|)
+    CXXPH_SIMD_GENERIC_BINARY_OP(^)
+};
+
+#define CXXPH_SIMD_GENERIC_COMPARE_OP(name, op)                                                                        \
+    template <typename T, int N>                                                                                       \
+    CXXPH_FORCEINLINE basic_vec_mask<T, N> name(const basic_vec<T, N> &a, const basic_vec<T, N> &b) CXXPH_NOEXCEPT     \
+    {                                                                                                                  \
+        basic_vec_mask<T, N> r;                                                                                        \
+        for (int i = 0; i < N; ++i) {                                                                                  \
+            r.m[i] = (a.v[i] op b.v[i]);                                                                               \
+        }                                                                                                              \
+        return r;                                                                                                      \
+    }
+
+CXXPH_SIMD_GENERIC_COMPARE_OP(cmp_eq, ==)
+CXXPH_SIMD_GENERIC_COMPARE_OP(cmp_lt, <)
+CXXPH_SIMD_GENERIC_COMPARE_OP(cmp_le, <=)
+CXXPH_SIMD_GENERIC_COMPARE_OP(cmp_gt, >)
+CXXPH_SIMD_GENERIC_COMPARE_OP(cmp_ge, >=)
+
+#undef CXXPH_SIMD_GENERIC_COMPARE_OP
+
+template <typename T, int N>
+CXXPH_FORCEINLINE basic_vec<T, N> operator-(const basic_vec<T, N> &a) CXXPH_NOEXCEPT
+{
+    basic_vec<T, N> r;
+    for (int i = 0; i < N; ++i) {
+        r.v[i] = static_cast<T>(-a.v[i]);
+    }
+    return r;
+}
+
+template <typename T, int N>
+CXXPH_FORCEINLINE basic_vec<T, N> min(const basic_vec<T, N> &a, const basic_vec<T, N> &b) CXXPH_NOEXCEPT
+{
+    basic_vec<T, N> r;
+    for (int i = 0; i < N; ++i) {
+        r.v[i] = (a.v[i] < b.v[i]) ? a.v[i] : b.v[i];
+    }
+    return r;
+}
+
+template <typename T, int N>
+CXXPH_FORCEINLINE basic_vec<T, N> max(const basic_vec<T, N> &a, const basic_vec<T, N> &b) CXXPH_NOEXCEPT
+{
+    basic_vec<T, N> r;
+    for (int i = 0; i < N; ++i) {
+        r.v[i] = (a.v[i] > b.v[i]) ? a.v[i] : b.v[i];
+    }
+    return r;
+}
+
+template <typename T, int N>
+CXXPH_FORCEINLINE basic_vec<T, N> abs(const basic_vec<T, N> &a) CXXPH_NOEXCEPT
+{
+    basic_vec<T, N> r;
+    for (int i = 0; i < N; ++i) {
+        r.v[i] = (a.v[i] < static_cast<T>(0)) ? static_cast<T>(-a.v[i]) : a.v[i];
+    }
+    return r;
+}
+
+template <typename T, int N>
+CXXPH_FORCEINLINE basic_vec<T, N> sqrt(const basic_vec<T, N> &a) CXXPH_NOEXCEPT
+{
+    basic_vec<T, N> r;
+    for (int i = 0; i < N; ++i) {
+        r.v[i] = std::sqrt(a.v[i]);
+    }
+    return r;
+}
+
+template <typename T, int N>
+CXXPH_FORCEINLINE basic_vec<T, N> rsqrt_estimate(const basic_vec<T, N> &a) CXXPH_NOEXCEPT
+{
+    basic_vec<T, N> r;
+    for (int i = 0; i < N; ++i) {
+        r.v[i] = static_cast<T>(1) / std::sqrt(a.v[i]);
+    }
+    return r;
+}
+
+template <typename T, int N>
+CXXPH_FORCEINLINE basic_vec<T, N> rcp_estimate(const basic_vec<T, N> &a) CXXPH_NOEXCEPT
+{
+    basic_vec<T, N> r;
+    for (int i = 0; i < N; ++i) {
+        r.v[i] = static_cast<T>(1) / a.v[i];
+    }
+    return r;
+}
+
+template <typename T, int N>
+CXXPH_FORCEINLINE basic_vec<T, N> mul_add(const basic_vec<T, N> &a, const basic_vec<T, N> &b,
+                                          const basic_vec<T, N> &c) CXXPH_NOEXCEPT
+{
+    basic_vec<T, N> r;
+    for (int i = 0; i < N; ++i) {
+        r.v[i] = static_cast<T>(a.v[i] * b.v[i] + c.v[i]);
+    }
+    return r;
+}
+
+template <typename T, int N>
+CXXPH_FORCEINLINE basic_vec<T, N> select(const basic_vec_mask<T, N> &m, const basic_vec<T, N> &a,
+                                         const basic_vec<T, N> &b) CXXPH_NOEXCEPT
+{
+    basic_vec<T, N> r;
+    for (int i = 0; i < N; ++i) {
+        r.v[i] = (m.m[i]) ? a.v[i] : b.v[i];
+    }
+    return r;
+}
+
+template <typename T, int N>
+CXXPH_FORCEINLINE basic_vec_mask<T, N> operator&(const basic_vec_mask<T, N> &a,
+                                                 const basic_vec_mask<T, N> &b) CXXPH_NOEXCEPT
+{
+    basic_vec_mask<T, N> r;
+    for (int i = 0; i < N; ++i) {
+        r.m[i] = a.m[i] && b.m[i];
+    }
+    return r;
+}
+
+template <typename T, int N>
+CXXPH_FORCEINLINE basic_vec_mask<T, N> operator|(const basic_vec_mask<T, N> &a,
+                                                 const basic_vec_mask<T, N> &b) CXXPH_NOEXCEPT
+{
+    basic_vec_mask<T, N> r;
+    for (int i = 0; i < N; ++i) {
+        r.m[i] = a.m[i] || b.m[i];
+    }
+    return r;
+}
+
+template <typename T, int N>
+CXXPH_FORCEINLINE bool any(const basic_vec_mask<T, N> &m) CXXPH_NOEXCEPT
+{
+    bool r = false;
+    for (int i = 0; i < N; ++i) {
+        r = r || m.m[i];
+    }
+    return r;
+}
+
+template <typename T, int N>
+CXXPH_FORCEINLINE bool all(const basic_vec_mask<T, N> &m) CXXPH_NOEXCEPT
+{
+    bool r = true;
+    for (int i = 0; i < N; ++i) {
+        r = r && m.m[i];
+    }
+    return r;
+}
+
+template <int I0, int I1, int I2, int I3, typename T, int N>
+CXXPH_FORCEINLINE basic_vec<T, N> shuffle(const basic_vec<T, N> &a) CXXPH_NOEXCEPT
+{
+    basic_vec<T, N> r;
+    for (int i = 0; i < N; i += 4) {
+        r.v[i + 0] = a.v[i + I0];
+        r.v[i + 1] = a.v[i + I1];
+        r.v[i + 2] = a.v[i + I2];
+        r.v[i + 3] = a.v[i + I3];
+    }
+    return r;
+}
+
+template <typename T, int N>
+CXXPH_FORCEINLINE basic_vec<T, N> reverse(const basic_vec<T, N> &a) CXXPH_NOEXCEPT
+{
+    basic_vec<T, N> r;
+    for (int i = 0; i < N; ++i) {
+        r.v[i] = a.v[N - 1 - i];
+    }
+    return r;
+}
+
+template <typename T, int N>
+CXXPH_FORCEINLINE void interleave(const basic_vec<T, N> &a, const basic_vec<T, N> &b, basic_vec<T, N> *lo,
+                                  basic_vec<T, N> *hi) CXXPH_NOEXCEPT
+{
+    basic_vec<T, N> l, h;
+    for (int i = 0; i < N / 2; ++i) {
+        l.v[2 * i + 0] = a.v[i];
+        l.v[2 * i + 1] = b.v[i];
+        h.v[2 * i + 0] = a.v[N / 2 + i];
+        h.v[2 * i + 1] = b.v[N / 2 + i];
+    }
+    (*lo) = l;
+    (*hi) = h;
+}
+
+template <typename T, int N>
+CXXPH_FORCEINLINE void deinterleave(const basic_vec<T, N> &a, const basic_vec<T, N> &b, basic_vec<T, N> *even,
+                                    basic_vec<T, N> *odd) CXXPH_NOEXCEPT
+{
+    basic_vec<T, N> e, o;
+    for (int i = 0; i < N / 2; ++i) {
+        e.v[i] = a.v[2 * i + 0];
+        o.v[i] = a.v[2 * i + 1];
+        e.v[N / 2 + i] = b.v[2 * i + 0];
+        o.v[N / 2 + i] = b.v[2 * i + 1];
+    }
+    (*even) = e;
+    (*odd) = o;
+}
+
+template <int I, typename T, int N>
+CXXPH_FORCEINLINE T extract(const basic_vec<T, N> &a) CXXPH_NOEXCEPT
+{
+    return a.v[I];
+}
+
+template <typename T, int N>
+CXXPH_FORCEINLINE T reduce_add(const basic_vec<T, N> &a) CXXPH_NOEXCEPT
+{
+    T r = a.v[0];
+    for (int i = 1; i < N; ++i) {
+        r = static_cast<T>(r + a.v[i]);
+    }
+    return r;
+}
+
+template <typename T, int N>
+CXXPH_FORCEINLINE T reduce_min(const basic_vec<T, N> &a) CXXPH_NOEXCEPT
+{
+    T r = a.v[0];
+    for (int i = 1; i < N; ++i) {
+        r = (a.v[i] < r) ? a.v[i] : r;
+    }
+    return r;
+}
+
+template <typename T, int N>
+CXXPH_FORCEINLINE T reduce_max(const basic_vec<T, N> &a) CXXPH_NOEXCEPT
+{
+    T r = a.v[0];
+    for (int i = 1; i < N; ++i) {
+        r = (a.v[i] > r) ? a.v[i] : r;
+    }
+    return r;
+}
+
+template <int S, typename T, int N>
+CXXPH_FORCEINLINE basic_vec<T, N> shl(const basic_vec<T, N> &a) CXXPH_NOEXCEPT
+{
+    typedef typename make_unsigned_lane<T>::type U;
+    basic_vec<T, N> r;
+    for (int i = 0; i < N; ++i) {
+        r.v[i] = static_cast<T>(static_cast<U>(a.v[i]) << S);
+    }
+    return r;
+}
+
+template <int S, typename T, int N>
+CXXPH_FORCEINLINE basic_vec<T, N> sra(const basic_vec<T, N> &a) CXXPH_NOEXCEPT
+{
+    basic_vec<T, N> r;
+    for (int i = 0; i < N; ++i) {
+        r.v[i] = static_cast<T>(a.v[i] >> S);
+    }
+    return r;
+}
+
+template <int S, typename T, int N>
+CXXPH_FORCEINLINE basic_vec<T, N> srl(const basic_vec<T, N> &a) CXXPH_NOEXCEPT
+{
+    typedef typename make_unsigned_lane<T>::type U;
+    basic_vec<T, N> r;
+    for (int i = 0; i < N; ++i) {
+        r.v[i] = static_cast<T>(static_cast<U>(a.v[i]) >> S);
+    }
+    return r;
+}
+
+template <typename T, int N>
+CXXPH_FORCEINLINE basic_vec<T, N> add_sat(const basic_vec<T, N> &a, const basic_vec<T, N> &b) CXXPH_NOEXCEPT
+{
+    basic_vec<T, N> r;
+    for (int i = 0; i < N; ++i) {
+        const int64_t x = static_cast<int64_t>(a.v[i]) + static_cast<int64_t>(b.v[i]);
+        r.v[i] = static_cast<T>((x < std::numeric_limits<T>::min()) ? std::numeric_limits<T>::min()
+                                                                      : (x > std::numeric_limits<T>::max())
+                                                                            ? std::numeric_limits<T>::max()
+                                                                            : x);
+    }
+    return r;
+}
+
+template <typename T, int N>
+CXXPH_FORCEINLINE basic_vec<T, N> sub_sat(const basic_vec<T, N> &a, const basic_vec<T, N> &b) CXXPH_NOEXCEPT
+{
+    basic_vec<T, N> r;
+    for (int i = 0; i < N; ++i) {
+        const int64_t x = static_cast<int64_t>(a.v[i]) - static_cast<int64_t>(b.v[i]);
+        r.v[i] = static_cast<T>((x < std::numeric_limits<T>::min()) ? std::numeric_limits<T>::min()
+                                                                      : (x > std::numeric_limits<T>::max())
+                                                                            ? std::numeric_limits<T>::max()
+                                                                            : x);
+    }
+    return r;
+}
+
+// (a * b * 2 + 2^(bits - 1)) >> bits, saturated (Q15 / Q31 rounding multiply)
+template <typename T, int N>
+CXXPH_FORCEINLINE basic_vec<T, N> mul_round_high(const basic_vec<T, N> &a, const basic_vec<T, N> &b) CXXPH_NOEXCEPT
+{
+    const int S = static_cast<int>(sizeof(T) * 8) - 1;
+    basic_vec<T, N> r;
+    for (int i = 0; i < N; ++i) {
+        const int64_t p = static_cast<int64_t>(a.v[i]) * static_cast<int64_t>(b.v[i]);
+        const int64_t x = (p + (static_cast<int64_t>(1) << (S - 1))) >> S;
+        r.v[i] = static_cast<T>((x > std::numeric_limits<T>::max()) ? std::numeric_limits<T>::max() : x);
+    }
+    return r;
+}
+
+// byte order of each lane reversed (integer)
+template <typename T, int N>
+CXXPH_FORCEINLINE basic_vec<T, N> reverse_bytes(const basic_vec<T, N> &a) CXXPH_NOEXCEPT
+{
+    basic_vec<T, N> r;
+    for (int i = 0; i < N; ++i) {
+        const unsigned char *s = reinterpret_cast<const unsigned char *>(&a.v[i]);
+        unsigned char *d = reinterpret_cast<unsigned char *>(&r.v[i]);
+        for (std::size_t j = 0; j < sizeof(T); ++j) {
+            d[j] = s[sizeof(T) - 1 - j];
+        }
+    }
+    return r;
+}
+
+template <int N>
+CXXPH_FORCEINLINE basic_vec<float, N> to_f32(const basic_vec<int32_t, N> &a) CXXPH_NOEXCEPT
+{
+    basic_vec<float, N> r;
+    for (int i = 0; i < N; ++i) {
+        r.v[i] = static_cast<float>(a.v[i]);
+    }
+    return r;
+}
+
+template <int N>
+CXXPH_FORCEINLINE basic_vec<int32_t, N> to_i32(const basic_vec<float, N> &a) CXXPH_NOEXCEPT
+{
+    basic_vec<int32_t, N> r;
+    for (int i = 0; i < N; ++i) {
+        r.v[i] = static_cast<int32_t>(a.v[i]);
+    }
+    return r;
+}
+
+template <int N>
+CXXPH_FORCEINLINE basic_vec<int32_t, N> round_to_i32(const basic_vec<float, N> &a) CXXPH_NOEXCEPT
+{
+    basic_vec<int32_t, N> r;
+    for (int i = 0; i < N; ++i) {
+        r.v[i] = static_cast<int32_t>(::lrintf(a.v[i]));
+    }
+    return r;
+}
+
+template <int N>
+CXXPH_FORCEINLINE basic_vec<int32_t, N> bitcast_i32(const basic_vec<float, N> &a) CXXPH_NOEXCEPT
+{
+    basic_vec<int32_t, N> r;
+    ::memcpy(r.v, a.v, sizeof(r.v));
+    return r;
+}
+
+template <int N>
+CXXPH_FORCEINLINE basic_vec<float, N> bitcast_f32(const basic_vec<int32_t, N> &a) CXXPH_NOEXCEPT
+{
+    basic_vec<float, N> r;
+    ::memcpy(r.v, a.v, sizeof(r.v));
+    return r;
+}
+
+CXXPH_FORCEINLINE basic_vec<int32_t, 4> to_i32_lo(const basic_vec<int16_t, 8> &a) CXXPH_NOEXCEPT
+{
+    basic_vec<int32_t, 4> r;
+    for (int i = 0; i < 4; ++i) {
+        r.v[i] = a.v[i];
+    }
+    return r;
+}
+
+CXXPH_FORCEINLINE basic_vec<int32_t, 4> to_i32_hi(const basic_vec<int16_t, 8> &a) CXXPH_NOEXCEPT
+{
+    basic_vec<int32_t, 4> r;
+    for (int i = 0; i < 4; ++i) {
+        r.v[i] = a.v[i + 4];
+    }
+    return r;
+}
+
+CXXPH_FORCEINLINE basic_vec<int16_t, 8> pack_sat(const basic_vec<int32_t, 4> &a,
+                                                 const basic_vec<int32_t, 4> &b) CXXPH_NOEXCEPT
+{
+    basic_vec<int16_t, 8> r;
+    for (int i = 0; i < 8; ++i) {
+        const int32_t x = (i < 4) ? a.v[i] : b.v[i - 4];
+        r.v[i] = static_cast<int16_t>((x < -32768) ? -32768 : (x > 32767) ? 32767 : x);
+    }
+    return r;
+}
+
+//
+// vec2x<H> : vector composed of two half vectors
+//
+template <typename HM>
+struct vec2x_mask {
+    HM lo;
+    HM hi;
+
+    vec2x_mask() CXXPH_NOEXCEPT {}
+    vec2x_mask(const HM &l, const HM &h) CXXPH_NOEXCEPT : lo(l), hi(h) {}
+};
+
+template <typename H>
+struct vec2x {
+    typedef typename H::value_type value_type;
+    typedef vec2x_mask<typename H::mask_type> mask_type;
+    typedef H half_type;
+    enum { num_lanes = 2 * H::num_lanes };
+
+    H lo;
+    H hi;
+
+    vec2x() CXXPH_NOEXCEPT {}
+    vec2x(value_type x) CXXPH_NOEXCEPT : lo(x), hi(x) {}
+    vec2x(const H &l, const H &h) CXXPH_NOEXCEPT : lo(l), hi(h) {}
+
+    static CXXPH_FORCEINLINE vec2x zero() CXXPH_NOEXCEPT { return vec2x(H::zero(), H::zero()); }
+
+    static CXXPH_FORCEINLINE vec2x load(const value_type *mem_addr) CXXPH_NOEXCEPT
+    {
+        return vec2x(H::load(mem_addr), H::load(mem_addr + H::num_lanes));
+    }
+
+    static CXXPH_FORCEINLINE vec2x load_aligned(const value_type *mem_addr) CXXPH_NOEXCEPT
+    {
+        return vec2x(H::load_aligned(mem_addr), H::load_aligned(mem_addr + H::num_lanes));
+    }
+
+    CXXPH_FORCEINLINE void store(value_type *mem_addr) const CXXPH_NOEXCEPT
+    {
+        lo.store(mem_addr);
+        hi.store(mem_addr + H::num_lanes);
+    }
+
+    CXXPH_FORCEINLINE void store_aligned(value_type *mem_addr) const CXXPH_NOEXCEPT
+    {
+        lo.store_aligned(mem_addr);
+        hi.store_aligned(mem_addr + H::num_lanes);
+    }
+
+    CXXPH_FORCEINLINE void store_stream(value_type *mem_addr) const CXXPH_NOEXCEPT
+    {
+        lo.store_stream(mem_addr);
+        hi.store_stream(mem_addr + H::num_lanes);
+    }
+
+    CXXPH_SIMD_VEC2X_BINARY_OP(+)
+    CXXPH_SIMD_VEC2X_BINARY_OP(-)
+    CXXPH_SIMD_VEC2X_BINARY_OP(*)
+    CXXPH_SIMD_VEC2X_BINARY_OP(/)
+    CXXPH_SIMD_VEC2X_BINARY_OP(&)
+    CXXPH_SIMD_VEC2X_BINARY_OP(|)
+    CXXPH_SIMD_VEC2X_BINARY_OP(^)
+};
+
+#undef CXXPH_SIMD_GENERIC_BINARY_OP
+#undef CXXPH_SIMD_VEC2X_BINARY_OP
+
+template <typename H>
+CXXPH_FORCEINLINE H low(const vec2x<H> &a) CXXPH_NOEXCEPT
+{
+    return a.lo;
+}
+
+template <typename H>
+CXXPH_FORCEINLINE H high(const vec2x<H> &a) CXXPH_NOEXCEPT
+{
+    return a.hi;
+}
+
+#define CXXPH_SIMD_VEC2X_BINARY_FUNC(name)                                                                             \
+    template <typename H>                                                                                              \
+    CXXPH_FORCEINLINE vec2x<H> name(const vec2x<H> &a, const vec2x<H> &b) CXXPH_NOEXCEPT                               \
+    {                                                                                                                  \
+        return vec2x<H>(name(a.lo, b.lo), name(a.hi, b.hi));                                                           \
+    }
+
+CXXPH_SIMD_VEC2X_BINARY_FUNC(min)
+CXXPH_SIMD_VEC2X_BINARY_FUNC(max)
+CXXPH_SIMD_VEC2X_BINARY_FUNC(add_sat)
+CXXPH_SIMD_VEC2X_BINARY_FUNC(sub_sat)
+CXXPH_SIMD_VEC2X_BINARY_FUNC(mul_round_high)
+
+#undef CXXPH_SIMD_VEC2X_BINARY_FUNC
+
+#define CXXPH_SIMD_VEC2X_UNARY_FUNC(name)                                                                              \
+    template <typename H>                                                                                              \
+    CXXPH_FORCEINLINE vec2x<H> name(const vec2x<H> &a) CXXPH_NOEXCEPT                                                  \
+    {                                                                                                                  \
+        return vec2x<H>(name(a.lo), name(a.hi));                                                                       \
+    }
+
+CXXPH_SIMD_VEC2X_UNARY_FUNC(abs)
+CXXPH_SIMD_VEC2X_UNARY_FUNC(sqrt)
+CXXPH_SIMD_VEC2X_UNARY_FUNC(rsqrt_estimate)
+CXXPH_SIMD_VEC2X_UNARY_FUNC(rcp_estimate)
+CXXPH_SIMD_VEC2X_UNARY_FUNC(reverse_bytes)
+
+#undef CXXPH_SIMD_VEC2X_UNARY_FUNC
+
+#define CXXPH_SIMD_VEC2X_COMPARE_FUNC(name)                                                                            \
+    template <typename H>                                                                                              \
+    CXXPH_FORCEINLINE typename vec2x<H>::mask_type name(const vec2x<H> &a, const vec2x<H> &b) CXXPH_NOEXCEPT           \
+    {                                                                                                                  \
+        return typename vec2x<H>::mask_type(name(a.lo, b.lo), name(a.hi, b.hi));                                       \
+    }
+
+CXXPH_SIMD_VEC2X_COMPARE_FUNC(cmp_eq)
+CXXPH_SIMD_VEC2X_COMPARE_FUNC(cmp_lt)
+CXXPH_SIMD_VEC2X_COMPARE_FUNC(cmp_le)
+CXXPH_SIMD_VEC2X_COMPARE_FUNC(cmp_gt)
+CXXPH_SIMD_VEC2X_COMPARE_FUNC(cmp_ge)
+
+#undef CXXPH_SIMD_VEC2X_COMPARE_FUNC
+
+template <typename H>
+CXXPH_FORCEINLINE vec2x<H> operator-(const vec2x<H> &a) CXXPH_NOEXCEPT
+{
+    return vec2x<H>(-a.lo, -a.hi);
+}
+
+template <typename H>
+CXXPH_FORCEINLINE vec2x<H> mul_add(const vec2x<H> &a, const vec2x<H> &b, const vec2x<H> &c) CXXPH_NOEXCEPT
+{
+    return vec2x<H>(mul_add(a.lo, b.lo, c.lo), mul_add(a.hi, b.hi, c.hi));
+}
+
+template <typename H>
+CXXPH_FORCEINLINE vec2x<H> select(const typename vec2x<H>::mask_type &m, const vec2x<H> &a,
+                                  const vec2x<H> &b) CXXPH_NOEXCEPT
+{
+    return vec2x<H>(select(m.lo, a.lo, b.lo), select(m.hi, a.hi, b.hi));
+}
+
+template <typename HM>
+CXXPH_FORCEINLINE vec2x_mask<HM> operator&(const vec2x_mask<HM> &a, const vec2x_mask<HM> &b) CXXPH_NOEXCEPT
+{
+    return vec2x_mask<HM>(a.lo & b.lo, a.hi & b.hi);
+}
+
+template <typename HM>
+CXXPH_FORCEINLINE vec2x_mask<HM> operator|(const vec2x_mask<HM> &a, const vec2x_mask<HM> &b) CXXPH_NOEXCEPT
+{
+    return vec2x_mask<HM>(a.lo | b.lo, a.hi | b.hi);
+}
+
+template <typename HM>
+CXXPH_FORCEINLINE bool any(const vec2x_mask<HM> &m) CXXPH_NOEXCEPT
+{
+    return any(m.lo | m.hi);
+}
+
+template <typename HM>
+CXXPH_FORCEINLINE bool all(const vec2x_mask<HM> &m) CXXPH_NOEXCEPT
+{
+    return all(m.lo & m.hi);
+}
+
+template <int I0, int I1, int I2, int I3, typename H>
+CXXPH_FORCEINLINE vec2x<H> shuffle(const vec2x<H> &a) CXXPH_NOEXCEPT
+{
+    return vec2x<H>(shuffle<I0, I1, I2, I3>(a.lo), shuffle<I0, I1, I2, I3>(a.hi));
+}
+
+template <typename H>
+CXXPH_FORCEINLINE vec2x<H> reverse(const vec2x<H> &a) CXXPH_NOEXCEPT
+{
+    return vec2x<H>(reverse(a.hi), reverse(a.lo));
+}
+
+template <typename H>
+CXXPH_FORCEINLINE void interleave(const vec2x<H> &a, const vec2x<H> &b, vec2x<H> *lo, vec2x<H> *hi) CXXPH_NOEXCEPT
+{
+    interleave(a.lo, b.lo, &(lo->lo), &(lo->hi));
+    interleave(a.hi, b.hi, &(hi->lo), &(hi->hi));
+}
+
+template <typename H>
+CXXPH_FORCEINLINE void deinterleave(const vec2x<H> &a, const vec2x<H> &b, vec2x<H> *even,
+                                    vec2x<H> *odd) CXXPH_NOEXCEPT
+{
+    deinterleave(a.lo, a.hi, &(even->lo), &(odd->lo));
+    deinterleave(b.lo, b.hi, &(even->hi), &(odd->hi));
+}
+
+template <int I, typename H>
+CXXPH_FORCEINLINE typename H::value_type extract(const vec2x<H> &a) CXXPH_NOEXCEPT
+{
+    return (I < H::num_lanes) ? extract<(I % H::num_lanes)>(a.lo) : extract<(I % H::num_lanes)>(a.hi);
+}
+
+template <typename H>
+CXXPH_FORCEINLINE typename H::value_type reduce_add(const vec2x<H> &a) CXXPH_NOEXCEPT
+{
+    return reduce_add(a.lo + a.hi);
+}
+
+template <typename H>
+CXXPH_FORCEINLINE typename H::value_type reduce_min(const vec2x<H> &a) CXXPH_NOEXCEPT
+{
+    return reduce_min(min(a.lo, a.hi));
+}
+
+template <typename H>
+CXXPH_FORCEINLINE typename H::value_type reduce_max(const vec2x<H> &a) CXXPH_NOEXCEPT
+{
+    return reduce_max(max(a.lo, a.hi));
+}
+
+template <int S, typename H>
+CXXPH_FORCEINLINE vec2x<H> shl(const vec2x<H> &a) CXXPH_NOEXCEPT
+{
+    return vec2x<H>(shl<S>(a.lo), shl<S>(a.hi));
+}
+
+template <int S, typename H>
+CXXPH_FORCEINLINE vec2x<H> sra(const vec2x<H> &a) CXXPH_NOEXCEPT
+{
+    return vec2x<H>(sra<S>(a.lo), sra<S>(a.hi));
+}
+
+template <int S, typename H>
+CXXPH_FORCEINLINE vec2x<H> srl(const vec2x<H> &a) CXXPH_NOEXCEPT
+{
+    return vec2x<H>(srl<S>(a.lo), srl<S>(a.hi));
+}
+
+//
+// compound assignment operators
+//
+#define CXXPH_SIMD_DEFINE_COMPOUND_ASSIGNMENT_OPS(template_decl, type)                                                 \
+    template_decl CXXPH_FORCEINLINE type &operator+=(type &a, const type &b) CXXPH_NOEXCEPT                            \
+    {                                                                                                                  \
+        a = a + b;                                                                                                     \
+        return a;                                                                                                      \
+    }                                                                                                                  \
+    template_decl CXXPH_FORCEINLINE type &operator-=(type &a, const type &b) CXXPH_NOEXCEPT                            \
+    {                                                                                                                  \
+        a = a - b;                                                                                                     \
+        return a;                                                                                                      \
+    }                                                                                                                  \
+    template_decl CXXPH_FORCEINLINE type &operator*=(type &a, const type &b) CXXPH_NOEXCEPT                            \
+    {                                                                                                                  \
+        a = a * b;                                                                                                     \
+        return a;                                                                                                      \
+    }
+
+CXXPH_SIMD_DEFINE_COMPOUND_ASSIGNMENT_OPS(template <typename H>, vec2x<H>)
+
+template <typename T, int N>
+CXXPH_FORCEINLINE basic_vec<T, N> &operator+=(basic_vec<T, N> &a, const basic_vec<T, N> &b) CXXPH_NOEXCEPT
+{
+    a = a + b;
+    return a;
+}
+
+template <typename T, int N>
+CXXPH_FORCEINLINE basic_vec<T, N> &operator-=(basic_vec<T, N> &a, const basic_vec<T, N> &b) CXXPH_NOEXCEPT
+{
+    a = a - b;
+    return a;
+}
+
+template <typename T, int N>
+CXXPH_FORCEINLINE basic_vec<T, N> &operator*=(basic_vec<T, N> &a, const basic_vec<T, N> &b) CXXPH_NOEXCEPT
+{
+    a = a * b;
+    return a;
+}
+
+} // namespace CXXPH_SIMD_ABI_NAMESPACE
+} // namespace simd
+} // namespace cxxporthelper
+
+#endif // CXXPORTHELPER_SIMD_GENERIC_HPP_
@@ -0,0 +1,657 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#ifndef CXXPORTHELPER_SIMD_NEON_HPP_
+#define CXXPORTHELPER_SIMD_NEON_HPP_
+
+// NOTE: This file is included from simd.hpp
+
+#include <cxxporthelper/arm_neon.hpp>
+
+//
+// NOTE: ARMv7 NEON has no divide and square root instructions, so operator/()
+// and sqrt() of f32x4 are computed with the reciprocal (square root) estimate
+// and two Newton-Raphson steps (relative error < 2^-22) on AArch32.
+//
+
+namespace cxxporthelper {
+namespace simd {
+namespace CXXPH_SIMD_ABI_NAMESPACE {
+
+//
+// f32x4
+//
+struct f32x4_mask {
+    uint32x4_t v;
+
+    f32x4_mask() CXXPH_NOEXCEPT {}
+    f32x4_mask(uint32x4_t x) CXXPH_NOEXCEPT : v(x) {}
+};
+
+struct f32x4 {
+    typedef float value_type;
+    typedef f32x4_mask mask_type;
+    enum { num_lanes = 4 };
+
+    float32x4_t v;
+
+    f32x4() CXXPH_NOEXCEPT {}
+    f32x4(float32x4_t x) CXXPH_NOEXCEPT : v(x) {}
+    f32x4(float x) CXXPH_NOEXCEPT : v(vdupq_n_f32(x)) {}
+
+    static CXXPH_FORCEINLINE f32x4 zero() CXXPH_NOEXCEPT { return vdupq_n_f32(0.0f); }
+    static CXXPH_FORCEINLINE f32x4 load(const float *mem_addr) CXXPH_NOEXCEPT { return vld1q_f32(mem_addr); }
+
+    static CXXPH_FORCEINLINE f32x4 load_aligned(const float *mem_addr) CXXPH_NOEXCEPT
+    {
+        return vld1q_f32(CXXPH_NEON_ASSUME_ALIGNED(mem_addr));
+    }
+
+    CXXPH_FORCEINLINE void store(float *mem_addr) const CXXPH_NOEXCEPT { vst1q_f32(mem_addr, v); }
+
+    CXXPH_FORCEINLINE void store_aligned(float *mem_addr) const CXXPH_NOEXCEPT
+    {
+        vst1q_f32(CXXPH_NEON_ASSUME_ALIGNED(mem_addr), v);
+    }
+
+    // NOTE: no non-temporal store intrinsic (STNP) is available
+    CXXPH_FORCEINLINE void store_stream(float *mem_addr) const CXXPH_NOEXCEPT { store_aligned(mem_addr); }
+};
+
+CXXPH_FORCEINLINE f32x4 operator+(const f32x4 &a, const f32x4 &b) CXXPH_NOEXCEPT { return vaddq_f32(a.v, b.v); }
+CXXPH_FORCEINLINE f32x4 operator-(const f32x4 &a, const f32x4 &b) CXXPH_NOEXCEPT { return vsubq_f32(a.v, b.v); }
+CXXPH_FORCEINLINE f32x4 operator*(const f32x4 &a, const f32x4 &b) CXXPH_NOEXCEPT { return vmulq_f32(a.v, b.v); }
+
+CXXPH_FORCEINLINE f32x4 operator/(const f32x4 &a, const f32x4 &b) CXXPH_NOEXCEPT
+{
+#if CXXPH_SIMD_USE_ARM64
+    return vdivq_f32(a.v, b.v);
+#else
+    float32x4_t r = vrecpeq_f32(b.v);
+    r = vmulq_f32(vrecpsq_f32(b.v, r), r);
+    r = vmulq_f32(vrecpsq_f32(b.v, r), r);
+    return vmulq_f32(a.v, r);
+#endif
+}
+
+CXXPH_FORCEINLINE f32x4 operator-(const f32x4 &a) CXXPH_NOEXCEPT { return vnegq_f32(a.v); }
+CXXPH_FORCEINLINE f32x4 min(const f32x4 &a, const f32x4 &b) CXXPH_NOEXCEPT { return vminq_f32(a.v, b.v); }
+CXXPH_FORCEINLINE f32x4 max(const f32x4 &a, const f32x4 &b) CXXPH_NOEXCEPT { return vmaxq_f32(a.v, b.v); }
+CXXPH_FORCEINLINE f32x4 abs(const f32x4 &a) CXXPH_NOEXCEPT { return vabsq_f32(a.v); }
+
+CXXPH_FORCEINLINE f32x4 sqrt(const f32x4 &a) CXXPH_NOEXCEPT
+{
+#if CXXPH_SIMD_USE_ARM64
+    return vsqrtq_f32(a.v);
+#else
+    float32x4_t e = vrsqrteq_f32(a.v);
+    e = vmulq_f32(vrsqrtsq_f32(vmulq_f32(a.v, e), e), e);
+    e = vmulq_f32(vrsqrtsq_f32(vmulq_f32(a.v, e), e), e);
+    // sqrt(0) = 0 * inf -> NaN, so fix it up
+    const uint32x4_t is_zero = vceqq_f32(a.v, vdupq_n_f32(0.0f));
+    return vbslq_f32(is_zero, a.v, vmulq_f32(a.v, e));
+#endif
+}
+
+CXXPH_FORCEINLINE f32x4 rsqrt_estimate(const f32x4 &a) CXXPH_NOEXCEPT { return vrsqrteq_f32(a.v); }
+CXXPH_FORCEINLINE f32x4 rcp_estimate(const f32x4 &a) CXXPH_NOEXCEPT { return vrecpeq_f32(a.v); }
+
+CXXPH_FORCEINLINE f32x4 mul_add(const f32x4 &a, const f32x4 &b, const f32x4 &c) CXXPH_NOEXCEPT
+{
+#if CXXPH_SIMD_USE_ARM64 || defined(__ARM_FEATURE_FMA)
+    return vfmaq_f32(c.v, a.v, b.v);
+#else
+    return vmlaq_f32(c.v, a.v, b.v);
+#endif
+}
+
+CXXPH_FORCEINLINE f32x4_mask cmp_eq(const f32x4 &a, const f32x4 &b) CXXPH_NOEXCEPT { return vceqq_f32(a.v, b.v); }
+CXXPH_FORCEINLINE f32x4_mask cmp_lt(const f32x4 &a, const f32x4 &b) CXXPH_NOEXCEPT { return vcltq_f32(a.v, b.v); }
+CXXPH_FORCEINLINE f32x4_mask cmp_le(const f32x4 &a, const f32x4 &b) CXXPH_NOEXCEPT { return vcleq_f32(a.v, b.v); }
+CXXPH_FORCEINLINE f32x4_mask cmp_gt(const f32x4 &a, const f32x4 &b) CXXPH_NOEXCEPT { return vcgtq_f32(a.v, b.v); }
+CXXPH_FORCEINLINE f32x4_mask cmp_ge(const f32x4 &a, const f32x4 &b) CXXPH_NOEXCEPT { return vcgeq_f32(a.v, b.v); }
+
+CXXPH_FORCEINLINE f32x4 select(const f32x4_mask &m, const f32x4 &a, const f32x4 &b) CXXPH_NOEXCEPT
+{
+    return vbslq_f32(m.v, a.v, b.v);
+}
+
+/// @cond INTERNAL_FIELD
+CXXPH_FORCEINLINE bool any_u32(uint32x4_t m) CXXPH_NOEXCEPT
+{
+#if CXXPH_SIMD_USE_ARM64
+    return vmaxvq_u32(m) != 0;
+#else
+    uint32x2_t t = vorr_u32(vget_low_u32(m), vget_high_u32(m));
+    t = vpmax_u32(t, t);
+    return vget_lane_u32(t, 0) != 0;
+#endif
+}
+
+CXXPH_FORCEINLINE bool all_u32(uint32x4_t m) CXXPH_NOEXCEPT
+{
+#if CXXPH_SIMD_USE_ARM64
+    return vminvq_u32(m) != 0;
+#else
+    uint32x2_t t = vand_u32(vget_low_u32(m), vget_high_u32(m));
+    t = vpmin_u32(t, t);
+    return vget_lane_u32(t, 0) != 0;
+#endif
+}
+
+CXXPH_FORCEINLINE bool any_u16(uint16x8_t m) CXXPH_NOEXCEPT
+{
+#if CXXPH_SIMD_USE_ARM64
+    return vmaxvq_u16(m) != 0;
+#else
+    return any_u32(vreinterpretq_u32_u16(m));
+#endif
+}
+
+CXXPH_FORCEINLINE bool all_u16(uint16x8_t m) CXXPH_NOEXCEPT
+{
+#if CXXPH_SIMD_USE_ARM64
+    return vminvq_u16(m) != 0;
+#else
+    uint16x4_t t = vand_u16(vget_low_u16(m), vget_high_u16(m));
+    t = vpmin_u16(t, t);
+    t = vpmin_u16(t, t);
+    return vget_lane_u16(t, 0) != 0;
+#endif
+}
+/// @endcond
+
+CXXPH_FORCEINLINE f32x4_mask operator&(const f32x4_mask &a, const f32x4_mask &b) CXXPH_NOEXCEPT
+{
+    return vandq_u32(a.v, b.v);
+}
+
+CXXPH_FORCEINLINE f32x4_mask operator|(const f32x4_mask &a, const f32x4_mask &b) CXXPH_NOEXCEPT
+{
+    return vorrq_u32(a.v, b.v);
+}
+
+CXXPH_FORCEINLINE bool any(const f32x4_mask &m) CXXPH_NOEXCEPT { return any_u32(m.v); }
+CXXPH_FORCEINLINE bool all(const f32x4_mask &m) CXXPH_NOEXCEPT { return all_u32(m.v); }
+
+template <int I0, int I1, int I2, int I3>
+CXXPH_FORCEINLINE f32x4 shuffle(const f32x4 &a) CXXPH_NOEXCEPT
+{
+#if CXXPH_COMPILER_IS_CLANG
+    return __builtin_shufflevector(a.v, a.v, I0, I1, I2, I3);
+#elif CXXPH_COMPILER_IS_GCC
+    const uint32x4_t sel = { I0, I1, I2, I3 };
+    return __builtin_shuffle(a.v, sel);
+#else
+    float32x4_t r = vdupq_n_f32(vgetq_lane_f32(a.v, I0));
+    r = vsetq_lane_f32(vgetq_lane_f32(a.v, I1), r, 1);
+    r = vsetq_lane_f32(vgetq_lane_f32(a.v, I2), r, 2);
+    r = vsetq_lane_f32(vgetq_lane_f32(a.v, I3), r, 3);
+    return r;
+#endif
+}
+
+CXXPH_FORCEINLINE f32x4 reverse(const f32x4 &a) CXXPH_NOEXCEPT
+{
+    const float32x4_t t = vrev64q_f32(a.v);
+    return vcombine_f32(vget_high_f32(t), vget_low_f32(t));
+}
+
+CXXPH_FORCEINLINE void interleave(const f32x4 &a, const f32x4 &b, f32x4 *lo, f32x4 *hi) CXXPH_NOEXCEPT
+{
+    const float32x4x2_t t = vzipq_f32(a.v, b.v);
+    (*lo) = t.val[0];
+    (*hi) = t.val[1];
+}
+
+CXXPH_FORCEINLINE void deinterleave(const f32x4 &a, const f32x4 &b, f32x4 *even, f32x4 *odd) CXXPH_NOEXCEPT
+{
+    const float32x4x2_t t = vuzpq_f32(a.v, b.v);
+    (*even) = t.val[0];
+    (*odd) = t.val[1];
+}
+
+template <int I>
+CXXPH_FORCEINLINE float extract(const f32x4 &a) CXXPH_NOEXCEPT
+{
+    return vgetq_lane_f32(a.v, I);
+}
+
+CXXPH_FORCEINLINE float reduce_add(const f32x4 &a) CXXPH_NOEXCEPT
+{
+#if CXXPH_SIMD_USE_ARM64
+    return vaddvq_f32(a.v);
+#else
+    float32x2_t t = vadd_f32(vget_low_f32(a.v), vget_high_f32(a.v));
+    t = vpadd_f32(t, t);
+    return vget_lane_f32(t, 0);
+#endif
+}
+
+CXXPH_FORCEINLINE float reduce_min(const f32x4 &a) CXXPH_NOEXCEPT
+{
+#if CXXPH_SIMD_USE_ARM64
+    return vminvq_f32(a.v);
+#else
+    float32x2_t t = vmin_f32(vget_low_f32(a.v), vget_high_f32(a.v));
+    t = vpmin_f32(t, t);
+    return vget_lane_f32(t, 0);
+#endif
+}
+
+CXXPH_FORCEINLINE float reduce_max(const f32x4 &a) CXXPH_NOEXCEPT
+{
+#if CXXPH_SIMD_USE_ARM64
+    return vmaxvq_f32(a.v);
+#else
+    float32x2_t t = vmax_f32(vget_low_f32(a.v), vget_high_f32(a.v));
+    t = vpmax_f32(t, t);
+    return vget_lane_f32(t, 0);
+#endif
+}
+
+//
+// i32x4
+//
+struct i32x4_mask {
+    uint32x4_t v;
+
+    i32x4_mask() CXXPH_NOEXCEPT {}
+    i32x4_mask(uint32x4_t x) CXXPH_NOEXCEPT : v(x) {}
+};
+
+struct i32x4 {
+    typedef int32_t value_type;
+    typedef i32x4_mask mask_type;
+    enum { num_lanes = 4 };
+
+    int32x4_t v;
+
+    i32x4() CXXPH_NOEXCEPT {}
+    i32x4(int32x4_t x) CXXPH_NOEXCEPT : v(x) {}
+    i32x4(int32_t x) CXXPH_NOEXCEPT : v(vdupq_n_s32(x)) {}
+
+    static CXXPH_FORCEINLINE i32x4 zero() CXXPH_NOEXCEPT { return vdupq_n_s32(0); }
+    static CXXPH_FORCEINLINE i32x4 load(const int32_t *mem_addr) CXXPH_NOEXCEPT { return vld1q_s32(mem_addr); }
+
+    static CXXPH_FORCEINLINE i32x4 load_aligned(const int32_t *mem_addr) CXXPH_NOEXCEPT
+    {
+        return vld1q_s32(CXXPH_NEON_ASSUME_ALIGNED(mem_addr));
+    }
+
+    CXXPH_FORCEINLINE void store(int32_t *mem_addr) const CXXPH_NOEXCEPT { vst1q_s32(mem_addr, v); }
+
+    CXXPH_FORCEINLINE void store_aligned(int32_t *mem_addr) const CXXPH_NOEXCEPT
+    {
+        vst1q_s32(CXXPH_NEON_ASSUME_ALIGNED(mem_addr), v);
+    }
+
+    CXXPH_FORCEINLINE void store_stream(int32_t *mem_addr) const CXXPH_NOEXCEPT { store_aligned(mem_addr); }
+};
+
+CXXPH_FORCEINLINE i32x4 operator+(const i32x4 &a, const i32x4 &b) CXXPH_NOEXCEPT { return vaddq_s32(a.v, b.v); }
+CXXPH_FORCEINLINE i32x4 operator-(const i32x4 &a, const i32x4 &b) CXXPH_NOEXCEPT { return vsubq_s32(a.v, b.v); }
+CXXPH_FORCEINLINE i32x4 operator*(const i32x4 &a, const i32x4 &b) CXXPH_NOEXCEPT { return vmulq_s32(a.v, b.v); }
+CXXPH_FORCEINLINE i32x4 operator-(const i32x4 &a) CXXPH_NOEXCEPT { return vnegq_s32(a.v); }
+CXXPH_FORCEINLINE i32x4 operator&(const i32x4 &a, const i32x4 &b) CXXPH_NOEXCEPT { return vandq_s32(a.v, b.v); }
+CXXPH_FORCEINLINE i32x4 operator|(const i32x4 &a, const i32x4 &b) CXXPH_NOEXCEPT { return vorrq_s32(a.v, b.v); }
+CXXPH_FORCEINLINE i32x4 operator^(const i32x4 &a, const i32x4 &b) CXXPH_NOEXCEPT { return veorq_s32(a.v, b.v); }
+CXXPH_FORCEINLINE i32x4 min(const i32x4 &a, const i32x4 &b) CXXPH_NOEXCEPT { return vminq_s32(a.v, b.v); }
+CXXPH_FORCEINLINE i32x4 max(const i32x4 &a, const i32x4 &b) CXXPH_NOEXCEPT { return vmaxq_s32(a.v, b.v); }
+CXXPH_FORCEINLINE i32x4 abs(const i32x4 &a) CXXPH_NOEXCEPT { return vabsq_s32(a.v); }
+CXXPH_FORCEINLINE i32x4 add_sat(const i32x4 &a, const i32x4 &b) CXXPH_NOEXCEPT { return vqaddq_s32(a.v, b.v); }
+CXXPH_FORCEINLINE i32x4 sub_sat(const i32x4 &a, const i32x4 &b) CXXPH_NOEXCEPT { return vqsubq_s32(a.v, b.v); }
+
+CXXPH_FORCEINLINE i32x4 mul_round_high(const i32x4 &a, const i32x4 &b) CXXPH_NOEXCEPT
+{
+    return vqrdmulhq_s32(a.v, b.v);
+}
+
+CXXPH_FORCEINLINE i32x4 reverse_bytes(const i32x4 &a) CXXPH_NOEXCEPT
+{
+    return vreinterpretq_s32_s8(vrev32q_s8(vreinterpretq_s8_s32(a.v)));
+}
+
+CXXPH_FORCEINLINE i32x4 mul_add(const i32x4 &a, const i32x4 &b, const i32x4 &c) CXXPH_NOEXCEPT
+{
+    return vmlaq_s32(c.v, a.v, b.v);
+}
+
+CXXPH_FORCEINLINE i32x4_mask cmp_eq(const i32x4 &a, const i32x4 &b) CXXPH_NOEXCEPT { return vceqq_s32(a.v, b.v); }
+CXXPH_FORCEINLINE i32x4_mask cmp_lt(const i32x4 &a, const i32x4 &b) CXXPH_NOEXCEPT { return vcltq_s32(a.v, b.v); }
+CXXPH_FORCEINLINE i32x4_mask cmp_le(const i32x4 &a, const i32x4 &b) CXXPH_NOEXCEPT { return vcleq_s32(a.v, b.v); }
+CXXPH_FORCEINLINE i32x4_mask cmp_gt(const i32x4 &a, const i32x4 &b) CXXPH_NOEXCEPT { return vcgtq_s32(a.v, b.v); }
+CXXPH_FORCEINLINE i32x4_mask cmp_ge(const i32x4 &a, const i32x4 &b) CXXPH_NOEXCEPT { return vcgeq_s32(a.v, b.v); }
+
+CXXPH_FORCEINLINE i32x4 select(const i32x4_mask &m, const i32x4 &a, const i32x4 &b) CXXPH_NOEXCEPT
+{
+    return vbslq_s32(m.v, a.v, b.v);
+}
+
+CXXPH_FORCEINLINE i32x4_mask operator&(const i32x4_mask &a, const i32x4_mask &b) CXXPH_NOEXCEPT
+{
+    return vandq_u32(a.v, b.v);
+}
+
+CXXPH_FORCEINLINE i32x4_mask operator|(const i32x4_mask &a, const i32x4_mask &b) CXXPH_NOEXCEPT
+{
+    return vorrq_u32(a.v, b.v);
+}
+
+CXXPH_FORCEINLINE bool any(const i32x4_mask &m) CXXPH_NOEXCEPT { return any_u32(m.v); }
+CXXPH_FORCEINLINE bool all(const i32x4_mask &m) CXXPH_NOEXCEPT { return all_u32(m.v); }
+
+template <int I0, int I1, int I2, int I3>
+CXXPH_FORCEINLINE i32x4 shuffle(const i32x4 &a) CXXPH_NOEXCEPT
+{
+#if CXXPH_COMPILER_IS_CLANG
+    return __builtin_shufflevector(a.v, a.v, I0, I1, I2, I3);
+#elif CXXPH_COMPILER_IS_GCC
+    const uint32x4_t sel = { I0, I1, I2, I3 };
+    return __builtin_shuffle(a.v, sel);
+#else
+    int32x4_t r = vdupq_n_s32(vgetq_lane_s32(a.v, I0));
+    r = vsetq_lane_s32(vgetq_lane_s32(a.v, I1), r, 1);
+    r = vsetq_lane_s32(vgetq_lane_s32(a.v, I2), r, 2);
+    r = vsetq_lane_s32(vgetq_lane_s32(a.v, I3), r, 3);
+    return r;
+#endif
+}
+
+CXXPH_FORCEINLINE i32x4 reverse(const i32x4 &a) CXXPH_NOEXCEPT
+{
+    const int32x4_t t = vrev64q_s32(a.v);
+    return vcombine_s32(vget_high_s32(t), vget_low_s32(t));
+}
+
+template <int I>
+CXXPH_FORCEINLINE int32_t extract(const i32x4 &a) CXXPH_NOEXCEPT
+{
+    return vgetq_lane_s32(a.v, I);
+}
+
+CXXPH_FORCEINLINE int32_t reduce_add(const i32x4 &a) CXXPH_NOEXCEPT
+{
+#if CXXPH_SIMD_USE_ARM64
+    return vaddvq_s32(a.v);
+#else
+    int32x2_t t = vadd_s32(vget_low_s32(a.v), vget_high_s32(a.v));
+    t = vpadd_s32(t, t);
+    return vget_lane_s32(t, 0);
+#endif
+}
+
+CXXPH_FORCEINLINE int32_t reduce_min(const i32x4 &a) CXXPH_NOEXCEPT
+{
+#if CXXPH_SIMD_USE_ARM64
+    return vminvq_s32(a.v);
+#else
+    int32x2_t t = vmin_s32(vget_low_s32(a.v), vget_high_s32(a.v));
+    t = vpmin_s32(t, t);
+    return vget_lane_s32(t, 0);
+#endif
+}
+
+CXXPH_FORCEINLINE int32_t reduce_max(const i32x4 &a) CXXPH_NOEXCEPT
+{
+#if CXXPH_SIMD_USE_ARM64
+    return vmaxvq_s32(a.v);
+#else
+    int32x2_t t = vmax_s32(vget_low_s32(a.v), vget_high_s32(a.v));
+    t = vpmax_s32(t, t);
+    return vget_lane_s32(t, 0);
+#endif
+}
+
+template <int S>
+CXXPH_FORCEINLINE i32x4 shl(const i32x4 &a) CXXPH_NOEXCEPT
+{
+    return vshlq_n_s32(a.v, S);
+}
+
+template <int S>
+CXXPH_FORCEINLINE i32x4 sra(const i32x4 &a) CXXPH_NOEXCEPT
+{
+    return vshrq_n_s32(a.v, S);
+}
+
+template <int S>
+CXXPH_FORCEINLINE i32x4 srl(const i32x4 &a) CXXPH_NOEXCEPT
+{
+    return vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(a.v), S));
+}
+
+//
+// i16x8
+//
+struct i16x8_mask {
+    uint16x8_t v;
+
+    i16x8_mask() CXXPH_NOEXCEPT {}
+    i16x8_mask(uint16x8_t x) CXXPH_NOEXCEPT : v(x) {}
+};
+
+struct i16x8 {
+    typedef int16_t value_type;
+    typedef i16x8_mask mask_type;
+    enum { num_lanes = 8 };
+
+    int16x8_t v;
+
+    i16x8() CXXPH_NOEXCEPT {}
+    i16x8(int16x8_t x) CXXPH_NOEXCEPT : v(x) {}
+    i16x8(int16_t x) CXXPH_NOEXCEPT : v(vdupq_n_s16(x)) {}
+
+    static CXXPH_FORCEINLINE i16x8 zero() CXXPH_NOEXCEPT { return vdupq_n_s16(0); }
+    static CXXPH_FORCEINLINE i16x8 load(const int16_t *mem_addr) CXXPH_NOEXCEPT { return vld1q_s16(mem_addr); }
+
+    static CXXPH_FORCEINLINE i16x8 load_aligned(const int16_t *mem_addr) CXXPH_NOEXCEPT
+    {
+        return vld1q_s16(CXXPH_NEON_ASSUME_ALIGNED(mem_addr));
+    }
+
+    CXXPH_FORCEINLINE void store(int16_t *mem_addr) const CXXPH_NOEXCEPT { vst1q_s16(mem_addr, v); }
+
+    CXXPH_FORCEINLINE void store_aligned(int16_t *mem_addr) const CXXPH_NOEXCEPT
+    {
+        vst1q_s16(CXXPH_NEON_ASSUME_ALIGNED(mem_addr), v);
+    }
+
+    CXXPH_FORCEINLINE void store_stream(int16_t *mem_addr) const CXXPH_NOEXCEPT { store_aligned(mem_addr); }
+};
+
+CXXPH_FORCEINLINE i16x8 operator+(const i16x8 &a, const i16x8 &b) CXXPH_NOEXCEPT { return vaddq_s16(a.v, b.v); }
+CXXPH_FORCEINLINE i16x8 operator-(const i16x8 &a, const i16x8 &b) CXXPH_NOEXCEPT { return vsubq_s16(a.v, b.v); }
+CXXPH_FORCEINLINE i16x8 operator*(const i16x8 &a, const i16x8 &b) CXXPH_NOEXCEPT { return vmulq_s16(a.v, b.v); }
+CXXPH_FORCEINLINE i16x8 operator-(const i16x8 &a) CXXPH_NOEXCEPT { return vnegq_s16(a.v); }
+CXXPH_FORCEINLINE i16x8 operator&(const i16x8 &a, const i16x8 &b) CXXPH_NOEXCEPT { return vandq_s16(a.v, b.v); }
+CXXPH_FORCEINLINE i16x8 operator|(const i16x8 &a, const i16x8 &b) CXXPH_NOEXCEPT { return vorrq_s16(a.v, b.v); }
+CXXPH_FORCEINLINE i16x8 operator^(const i16x8 &a, const i16x8 &b) CXXPH_NOEXCEPT { return veorq_s16(a.v, b.v); }
+CXXPH_FORCEINLINE i16x8 min(const i16x8 &a, const i16x8 &b) CXXPH_NOEXCEPT { return vminq_s16(a.v, b.v); }
+CXXPH_FORCEINLINE i16x8 max(const i16x8 &a, const i16x8 &b) CXXPH_NOEXCEPT { return vmaxq_s16(a.v, b.v); }
+CXXPH_FORCEINLINE i16x8 abs(const i16x8 &a) CXXPH_NOEXCEPT { return vabsq_s16(a.v); }
+CXXPH_FORCEINLINE i16x8 add_sat(const i16x8 &a, const i16x8 &b) CXXPH_NOEXCEPT { return vqaddq_s16(a.v, b.v); }
+CXXPH_FORCEINLINE i16x8 sub_sat(const i16x8 &a, const i16x8 &b) CXXPH_NOEXCEPT { return vqsubq_s16(a.v, b.v); }
+
+CXXPH_FORCEINLINE i16x8 mul_round_high(const i16x8 &a, const i16x8 &b) CXXPH_NOEXCEPT
+{
+    return vqrdmulhq_s16(a.v, b.v);
+}
+
+CXXPH_FORCEINLINE i16x8 reverse_bytes(const i16x8 &a) CXXPH_NOEXCEPT
+{
+    return vreinterpretq_s16_s8(vrev16q_s8(vreinterpretq_s8_s16(a.v)));
+}
+
+CXXPH_FORCEINLINE i16x8 mul_add(const i16x8 &a, const i16x8 &b, const i16x8 &c) CXXPH_NOEXCEPT
+{
+    return vmlaq_s16(c.v, a.v, b.v);
+}
+
+CXXPH_FORCEINLINE i16x8_mask cmp_eq(const i16x8 &a, const i16x8 &b) CXXPH_NOEXCEPT { return vceqq_s16(a.v, b.v); }
+CXXPH_FORCEINLINE i16x8_mask cmp_lt(const i16x8 &a, const i16x8 &b) CXXPH_NOEXCEPT { return vcltq_s16(a.v, b.v); }
+CXXPH_FORCEINLINE i16x8_mask cmp_le(const i16x8 &a, const i16x8 &b) CXXPH_NOEXCEPT { return vcleq_s16(a.v, b.v); }
+CXXPH_FORCEINLINE i16x8_mask cmp_gt(const i16x8 &a, const i16x8 &b) CXXPH_NOEXCEPT { return vcgtq_s16(a.v, b.v); }
+CXXPH_FORCEINLINE i16x8_mask cmp_ge(const i16x8 &a, const i16x8 &b) CXXPH_NOEXCEPT { return vcgeq_s16(a.v, b.v); }
+
+CXXPH_FORCEINLINE i16x8 select(const i16x8_mask &m, const i16x8 &a, const i16x8 &b) CXXPH_NOEXCEPT
+{
+    return vbslq_s16(m.v, a.v, b.v);
+}
+
+CXXPH_FORCEINLINE i16x8_mask operator&(const i16x8_mask &a, const i16x8_mask &b) CXXPH_NOEXCEPT
+{
+    return vandq_u16(a.v, b.v);
+}
+
+CXXPH_FORCEINLINE i16x8_mask operator|(const i16x8_mask &a, const i16x8_mask &b) CXXPH_NOEXCEPT
+{
+    return vorrq_u16(a.v, b.v);
+}
+
+CXXPH_FORCEINLINE bool any(const i16x8_mask &m) CXXPH_NOEXCEPT { return any_u16(m.v); }
+CXXPH_FORCEINLINE bool all(const i16x8_mask &m) CXXPH_NOEXCEPT { return all_u16(m.v); }
+
+template <int I0, int I1, int I2, int I3>
+CXXPH_FORCEINLINE i16x8 shuffle(const i16x8 &a) CXXPH_NOEXCEPT
+{
+#if CXXPH_COMPILER_IS_CLANG
+    return __builtin_shufflevector(a.v, a.v, I0, I1, I2, I3, I0 + 4, I1 + 4, I2 + 4, I3 + 4);
+#elif CXXPH_COMPILER_IS_GCC
+    const uint16x8_t sel = { I0, I1, I2, I3, I0 + 4, I1 + 4, I2 + 4, I3 + 4 };
+    return __builtin_shuffle(a.v, sel);
+#else
+    int16x8_t r = vdupq_n_s16(vgetq_lane_s16(a.v, I0));
+    r = vsetq_lane_s16(vgetq_lane_s16(a.v, I1), r, 1);
+    r = vsetq_lane_s16(vgetq_lane_s16(a.v, I2), r, 2);
+    r = vsetq_lane_s16(vgetq_lane_s16(a.v, I3), r, 3);
+    r = vsetq_lane_s16(vgetq_lane_s16(a.v, I0 + 4), r, 4);
+    r = vsetq_lane_s16(vgetq_lane_s16(a.v, I1 + 4), r, 5);
+    r = vsetq_lane_s16(vgetq_lane_s16(a.v, I2 + 4), r, 6);
+    r = vsetq_lane_s16(vgetq_lane_s16(a.v, I3 + 4), r, 7);
+    return r;
+#endif
+}
+
+CXXPH_FORCEINLINE i16x8 reverse(const i16x8 &a) CXXPH_NOEXCEPT
+{
+    const int16x8_t t = vrev64q_s16(a.v);
+    return vcombine_s16(vget_high_s16(t), vget_low_s16(t));
+}
+
+template <int I>
+CXXPH_FORCEINLINE int16_t extract(const i16x8 &a) CXXPH_NOEXCEPT
+{
+    return vgetq_lane_s16(a.v, I);
+}
+
+CXXPH_FORCEINLINE int16_t reduce_add(const i16x8 &a) CXXPH_NOEXCEPT
+{
+#if CXXPH_SIMD_USE_ARM64
+    return vaddvq_s16(a.v);
+#else
+    int16x4_t t = vadd_s16(vget_low_s16(a.v), vget_high_s16(a.v));
+    t = vpadd_s16(t, t);
+    t = vpadd_s16(t, t);
+    return vget_lane_s16(t, 0);
+#endif
+}
+
+CXXPH_FORCEINLINE int16_t reduce_min(const i16x8 &a) CXXPH_NOEXCEPT
+{
+#if CXXPH_SIMD_USE_ARM64
+    return vminvq_s16(a.v);
+#else
+    int16x4_t t = vmin_s16(vget_low_s16(a.v), vget_high_s16(a.v));
+    t = vpmin_s16(t, t);
+    t = vpmin_s16(t, t);
+    return vget_lane_s16(t, 0);
+#endif
+}
+
+CXXPH_FORCEINLINE int16_t reduce_max(const i16x8 &a) CXXPH_NOEXCEPT
+{
+#if CXXPH_SIMD_USE_ARM64
+    return vmaxvq_s16(a.v);
+#else
+    int16x4_t t = vmax_s16(vget_low_s16(a.v), vget_high_s16(a.v));
+    t = vpmax_s16(t, t);
+    t = vpmax_s16(t, t);
+    return vget_lane_s16(t, 0);
+#endif
+}
+
+template <int S>
+CXXPH_FORCEINLINE i16x8 shl(const i16x8 &a) CXXPH_NOEXCEPT
+{
+    return vshlq_n_s16(a.v, S);
+}
+
+template <int S>
+CXXPH_FORCEINLINE i16x8 sra(const i16x8 &a) CXXPH_NOEXCEPT
+{
+    return vshrq_n_s16(a.v, S);
+}
+
+template <int S>
+CXXPH_FORCEINLINE i16x8 srl(const i16x8 &a) CXXPH_NOEXCEPT
+{
+    return vreinterpretq_s16_u16(vshrq_n_u16(vreinterpretq_u16_s16(a.v), S));
+}
+
+//
+// conversions
+//
+CXXPH_FORCEINLINE f32x4 to_f32(const i32x4 &a) CXXPH_NOEXCEPT { return vcvtq_f32_s32(a.v); }
+CXXPH_FORCEINLINE i32x4 to_i32(const f32x4 &a) CXXPH_NOEXCEPT { return vcvtq_s32_f32(a.v); }
+
+CXXPH_FORCEINLINE i32x4 round_to_i32(const f32x4 &a) CXXPH_NOEXCEPT
+{
+#if CXXPH_SIMD_USE_ARM64
+    return vcvtnq_s32_f32(a.v);
+#else
+    // round half to even (same as the default rounding mode of SSE)
+    const int32x4_t t = vcvtq_s32_f32(a.v);
+    const float32x4_t d = vsubq_f32(a.v, vcvtq_f32_s32(t));
+    const uint32x4_t odd = vtstq_s32(t, vdupq_n_s32(1));
+    const uint32x4_t up = vorrq_u32(vcgtq_f32(d, vdupq_n_f32(0.5f)),
+                                    vandq_u32(vceqq_f32(d, vdupq_n_f32(0.5f)), odd));
+    const uint32x4_t down = vorrq_u32(vcltq_f32(d, vdupq_n_f32(-0.5f)),
+                                      vandq_u32(vceqq_f32(d, vdupq_n_f32(-0.5f)), odd));
+    // masks are -1 (all bits set) when true
+    return vaddq_s32(vsubq_s32(t, vreinterpretq_s32_u32(up)), vreinterpretq_s32_u32(down));
+#endif
+}
+
+CXXPH_FORCEINLINE i32x4 bitcast_i32(const f32x4 &a) CXXPH_NOEXCEPT { return vreinterpretq_s32_f32(a.v); }
+CXXPH_FORCEINLINE f32x4 bitcast_f32(const i32x4 &a) CXXPH_NOEXCEPT { return vreinterpretq_f32_s32(a.v); }
+CXXPH_FORCEINLINE i32x4 to_i32_lo(const i16x8 &a) CXXPH_NOEXCEPT { return vmovl_s16(vget_low_s16(a.v)); }
+CXXPH_FORCEINLINE i32x4 to_i32_hi(const i16x8 &a) CXXPH_NOEXCEPT { return vmovl_s16(vget_high_s16(a.v)); }
+
+CXXPH_FORCEINLINE i16x8 pack_sat(const i32x4 &a, const i32x4 &b) CXXPH_NOEXCEPT
+{
+    return vcombine_s16(vqmovn_s32(a.v), vqmovn_s32(b.v));
+}
+
+CXXPH_SIMD_DEFINE_COMPOUND_ASSIGNMENT_OPS(, f32x4)
+CXXPH_SIMD_DEFINE_COMPOUND_ASSIGNMENT_OPS(, i32x4)
+CXXPH_SIMD_DEFINE_COMPOUND_ASSIGNMENT_OPS(, i16x8)
+
+} // namespace CXXPH_SIMD_ABI_NAMESPACE
+} // namespace simd
+} // namespace cxxporthelper
+
+#endif // CXXPORTHELPER_SIMD_NEON_HPP_
@@ -0,0 +1,1007 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#ifndef CXXPORTHELPER_SIMD_X86_HPP_
+#define CXXPORTHELPER_SIMD_X86_HPP_
+
+// NOTE: This file is included from simd.hpp
+
+#include <cxxporthelper/x86_intrinsics.hpp>
+
+namespace cxxporthelper {
+namespace simd {
+namespace CXXPH_SIMD_ABI_NAMESPACE {
+
+/// @cond INTERNAL_FIELD
+CXXPH_FORCEINLINE __m128 select_bits_ps(__m128 m, __m128 a, __m128 b) CXXPH_NOEXCEPT
+{
+#if CXXPH_SIMD_USE_X86_SSE4_1
+    return _mm_blendv_ps(b, a, m);
+#else
+    return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b));
+#endif
+}
+
+CXXPH_FORCEINLINE __m128i select_bits_si128(__m128i m, __m128i a, __m128i b) CXXPH_NOEXCEPT
+{
+#if CXXPH_SIMD_USE_X86_SSE4_1
+    return _mm_blendv_epi8(b, a, m);
+#else
+    return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b));
+#endif
+}
+
+CXXPH_FORCEINLINE __m128i not_si128(__m128i a) CXXPH_NOEXCEPT { return _mm_xor_si128(a, _mm_cmpeq_epi32(a, a)); }
+/// @endcond
+
+//
+// f32x4
+//
+struct f32x4_mask {
+    __m128 v;
+
+    f32x4_mask() CXXPH_NOEXCEPT {}
+    f32x4_mask(__m128 x) CXXPH_NOEXCEPT : v(x) {}
+};
+
+struct f32x4 {
+    typedef float value_type;
+    typedef f32x4_mask mask_type;
+    enum { num_lanes = 4 };
+
+    __m128 v;
+
+    f32x4() CXXPH_NOEXCEPT {}
+    f32x4(__m128 x) CXXPH_NOEXCEPT : v(x) {}
+    f32x4(float x) CXXPH_NOEXCEPT : v(_mm_set1_ps(x)) {}
+
+    static CXXPH_FORCEINLINE f32x4 zero() CXXPH_NOEXCEPT { return _mm_setzero_ps(); }
+    static CXXPH_FORCEINLINE f32x4 load(const float *mem_addr) CXXPH_NOEXCEPT { return _mm_loadu_ps(mem_addr); }
+    static CXXPH_FORCEINLINE f32x4 load_aligned(const float *mem_addr) CXXPH_NOEXCEPT { return _mm_load_ps(mem_addr); }
+    CXXPH_FORCEINLINE void store(float *mem_addr) const CXXPH_NOEXCEPT { _mm_storeu_ps(mem_addr, v); }
+    CXXPH_FORCEINLINE void store_aligned(float *mem_addr) const CXXPH_NOEXCEPT { _mm_store_ps(mem_addr, v); }
+
+    CXXPH_FORCEINLINE void store_stream(float *mem_addr) const CXXPH_NOEXCEPT { _mm_stream_ps(mem_addr, v); }
+};
+
+CXXPH_FORCEINLINE f32x4 operator+(const f32x4 &a, const f32x4 &b) CXXPH_NOEXCEPT { return _mm_add_ps(a.v, b.v); }
+CXXPH_FORCEINLINE f32x4 operator-(const f32x4 &a, const f32x4 &b) CXXPH_NOEXCEPT { return _mm_sub_ps(a.v, b.v); }
+CXXPH_FORCEINLINE f32x4 operator*(const f32x4 &a, const f32x4 &b) CXXPH_NOEXCEPT { return _mm_mul_ps(a.v, b.v); }
+CXXPH_FORCEINLINE f32x4 operator/(const f32x4 &a, const f32x4 &b) CXXPH_NOEXCEPT { return _mm_div_ps(a.v, b.v); }
+CXXPH_FORCEINLINE f32x4 operator-(const f32x4 &a) CXXPH_NOEXCEPT { return _mm_xor_ps(a.v, _mm_set1_ps(-0.0f)); }
+CXXPH_FORCEINLINE f32x4 min(const f32x4 &a, const f32x4 &b) CXXPH_NOEXCEPT { return _mm_min_ps(a.v, b.v); }
+CXXPH_FORCEINLINE f32x4 max(const f32x4 &a, const f32x4 &b) CXXPH_NOEXCEPT { return _mm_max_ps(a.v, b.v); }
+CXXPH_FORCEINLINE f32x4 abs(const f32x4 &a) CXXPH_NOEXCEPT { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v); }
+CXXPH_FORCEINLINE f32x4 sqrt(const f32x4 &a) CXXPH_NOEXCEPT { return _mm_sqrt_ps(a.v); }
+CXXPH_FORCEINLINE f32x4 rsqrt_estimate(const f32x4 &a) CXXPH_NOEXCEPT { return _mm_rsqrt_ps(a.v); }
+CXXPH_FORCEINLINE f32x4 rcp_estimate(const f32x4 &a) CXXPH_NOEXCEPT { return _mm_rcp_ps(a.v); }
+
+CXXPH_FORCEINLINE f32x4 mul_add(const f32x4 &a, const f32x4 &b, const f32x4 &c) CXXPH_NOEXCEPT
+{
+#if CXXPH_SIMD_USE_X86_FMA
+    return _mm_fmadd_ps(a.v, b.v, c.v);
+#else
+    return _mm_add_ps(_mm_mul_ps(a.v, b.v), c.v);
+#endif
+}
+
+CXXPH_FORCEINLINE f32x4_mask cmp_eq(const f32x4 &a, const f32x4 &b) CXXPH_NOEXCEPT { return _mm_cmpeq_ps(a.v, b.v); }
+CXXPH_FORCEINLINE f32x4_mask cmp_lt(const f32x4 &a, const f32x4 &b) CXXPH_NOEXCEPT { return _mm_cmplt_ps(a.v, b.v); }
+CXXPH_FORCEINLINE f32x4_mask cmp_le(const f32x4 &a, const f32x4 &b) CXXPH_NOEXCEPT { return _mm_cmple_ps(a.v, b.v); }
+CXXPH_FORCEINLINE f32x4_mask cmp_gt(const f32x4 &a, const f32x4 &b) CXXPH_NOEXCEPT { return _mm_cmpgt_ps(a.v, b.v); }
+CXXPH_FORCEINLINE f32x4_mask cmp_ge(const f32x4 &a, const f32x4 &b) CXXPH_NOEXCEPT { return _mm_cmpge_ps(a.v, b.v); }
+
+CXXPH_FORCEINLINE f32x4 select(const f32x4_mask &m, const f32x4 &a, const f32x4 &b) CXXPH_NOEXCEPT
+{
+    return select_bits_ps(m.v, a.v, b.v);
+}
+
+CXXPH_FORCEINLINE f32x4_mask operator&(const f32x4_mask &a, const f32x4_mask &b) CXXPH_NOEXCEPT
+{
+    return _mm_and_ps(a.v, b.v);
+}
+
+CXXPH_FORCEINLINE f32x4_mask operator|(const f32x4_mask &a, const f32x4_mask &b) CXXPH_NOEXCEPT
+{
+    return _mm_or_ps(a.v, b.v);
+}
+
+CXXPH_FORCEINLINE bool any(const f32x4_mask &m) CXXPH_NOEXCEPT { return _mm_movemask_ps(m.v) != 0; }
+CXXPH_FORCEINLINE bool all(const f32x4_mask &m) CXXPH_NOEXCEPT { return _mm_movemask_ps(m.v) == 0xf; }
+
+template <int I0, int I1, int I2, int I3>
+CXXPH_FORCEINLINE f32x4 shuffle(const f32x4 &a) CXXPH_NOEXCEPT
+{
+    return _mm_shuffle_ps(a.v, a.v, _MM_SHUFFLE(I3, I2, I1, I0));
+}
+
+CXXPH_FORCEINLINE f32x4 reverse(const f32x4 &a) CXXPH_NOEXCEPT { return shuffle<3, 2, 1, 0>(a); }
+
+CXXPH_FORCEINLINE void interleave(const f32x4 &a, const f32x4 &b, f32x4 *lo, f32x4 *hi) CXXPH_NOEXCEPT
+{
+    (*lo) = _mm_unpacklo_ps(a.v, b.v);
+    (*hi) = _mm_unpackhi_ps(a.v, b.v);
+}
+
+CXXPH_FORCEINLINE void deinterleave(const f32x4 &a, const f32x4 &b, f32x4 *even, f32x4 *odd) CXXPH_NOEXCEPT
+{
+    (*even) = _mm_shuffle_ps(a.v, b.v, _MM_SHUFFLE(2, 0, 2, 0));
+    (*odd) = _mm_shuffle_ps(a.v, b.v, _MM_SHUFFLE(3, 1, 3, 1));
+}
+
+template <int I>
+CXXPH_FORCEINLINE float extract(const f32x4 &a) CXXPH_NOEXCEPT
+{
+    return _mm_cvtss_f32(_mm_shuffle_ps(a.v, a.v, _MM_SHUFFLE(I, I, I, I)));
+}
+
+CXXPH_FORCEINLINE float reduce_add(const f32x4 &a) CXXPH_NOEXCEPT
+{
+    const __m128 t = _mm_add_ps(a.v, _mm_movehl_ps(a.v, a.v));
+    return _mm_cvtss_f32(_mm_add_ss(t, _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 1, 1, 1))));
+}
+
+CXXPH_FORCEINLINE float reduce_min(const f32x4 &a) CXXPH_NOEXCEPT
+{
+    const __m128 t = _mm_min_ps(a.v, _mm_movehl_ps(a.v, a.v));
+    return _mm_cvtss_f32(_mm_min_ss(t, _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 1, 1, 1))));
+}
+
+CXXPH_FORCEINLINE float reduce_max(const f32x4 &a) CXXPH_NOEXCEPT
+{
+    const __m128 t = _mm_max_ps(a.v, _mm_movehl_ps(a.v, a.v));
+    return _mm_cvtss_f32(_mm_max_ss(t, _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 1, 1, 1))));
+}
+
+//
+// i32x4
+//
+struct i32x4_mask {
+    __m128i v;
+
+    i32x4_mask() CXXPH_NOEXCEPT {}
+    i32x4_mask(__m128i x) CXXPH_NOEXCEPT : v(x) {}
+};
+
+struct i32x4 {
+    typedef int32_t value_type;
+    typedef i32x4_mask mask_type;
+    enum { num_lanes = 4 };
+
+    __m128i v;
+
+    i32x4() CXXPH_NOEXCEPT {}
+    i32x4(__m128i x) CXXPH_NOEXCEPT : v(x) {}
+    i32x4(int32_t x) CXXPH_NOEXCEPT : v(_mm_set1_epi32(x)) {}
+
+    static CXXPH_FORCEINLINE i32x4 zero() CXXPH_NOEXCEPT { return _mm_setzero_si128(); }
+
+    static CXXPH_FORCEINLINE i32x4 load(const int32_t *mem_addr) CXXPH_NOEXCEPT
+    {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i *>(mem_addr));
+    }
+
+    static CXXPH_FORCEINLINE i32x4 load_aligned(const int32_t *mem_addr) CXXPH_NOEXCEPT
+    {
+        return _mm_load_si128(reinterpret_cast<const __m128i *>(mem_addr));
+    }
+
+    CXXPH_FORCEINLINE void store(int32_t *mem_addr) const CXXPH_NOEXCEPT
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(mem_addr), v);
+    }
+
+    CXXPH_FORCEINLINE void store_aligned(int32_t *mem_addr) const CXXPH_NOEXCEPT
+    {
+        _mm_store_si128(reinterpret_cast<__m128i *>(mem_addr), v);
+    }
+
+    CXXPH_FORCEINLINE void store_stream(int32_t *mem_addr) const CXXPH_NOEXCEPT
+    {
+        _mm_stream_si128(reinterpret_cast<__m128i *>(mem_addr), v);
+    }
+};
+
+CXXPH_FORCEINLINE i32x4 operator+(const i32x4 &a, const i32x4 &b) CXXPH_NOEXCEPT { return _mm_add_epi32(a.v, b.v); }
+CXXPH_FORCEINLINE i32x4 operator-(const i32x4 &a, const i32x4 &b) CXXPH_NOEXCEPT { return _mm_sub_epi32(a.v, b.v); }
+
+CXXPH_FORCEINLINE i32x4 operator*(const i32x4 &a, const i32x4 &b) CXXPH_NOEXCEPT
+{
+#if CXXPH_SIMD_USE_X86_SSE4_1
+    return _mm_mullo_epi32(a.v, b.v);
+#else
+    const __m128i even = _mm_mul_epu32(a.v, b.v);
+    const __m128i odd = _mm_mul_epu32(_mm_srli_si128(a.v, 4), _mm_srli_si128(b.v, 4));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+#endif
+}
+
+CXXPH_FORCEINLINE i32x4 operator-(const i32x4 &a) CXXPH_NOEXCEPT { return _mm_sub_epi32(_mm_setzero_si128(), a.v); }
+CXXPH_FORCEINLINE i32x4 operator&(const i32x4 &a, const i32x4 &b) CXXPH_NOEXCEPT { return _mm_and_si128(a.v, b.v); }
+CXXPH_FORCEINLINE i32x4 operator|(const i32x4 &a, const i32x4 &b) CXXPH_NOEXCEPT { return _mm_or_si128(a.v, b.v); }
+CXXPH_FORCEINLINE i32x4 operator^(const i32x4 &a, const i32x4 &b) CXXPH_NOEXCEPT { return _mm_xor_si128(a.v, b.v); }
+
+CXXPH_FORCEINLINE i32x4_mask cmp_eq(const i32x4 &a, const i32x4 &b) CXXPH_NOEXCEPT
+{
+    return _mm_cmpeq_epi32(a.v, b.v);
+}
+
+CXXPH_FORCEINLINE i32x4_mask cmp_lt(const i32x4 &a, const i32x4 &b) CXXPH_NOEXCEPT
+{
+    return _mm_cmplt_epi32(a.v, b.v);
+}
+
+CXXPH_FORCEINLINE i32x4_mask cmp_le(const i32x4 &a, const i32x4 &b) CXXPH_NOEXCEPT
+{
+#if CXXPH_SIMD_USE_X86_SSE4_1
+    return _mm_cmpeq_epi32(_mm_min_epi32(a.v, b.v), a.v);
+#else
+    return not_si128(_mm_cmpgt_epi32(a.v, b.v));
+#endif
+}
+
+CXXPH_FORCEINLINE i32x4_mask cmp_gt(const i32x4 &a, const i32x4 &b) CXXPH_NOEXCEPT
+{
+    return _mm_cmpgt_epi32(a.v, b.v);
+}
+
+CXXPH_FORCEINLINE i32x4_mask cmp_ge(const i32x4 &a, const i32x4 &b) CXXPH_NOEXCEPT
+{
+#if CXXPH_SIMD_USE_X86_SSE4_1
+    return _mm_cmpeq_epi32(_mm_max_epi32(a.v, b.v), a.v);
+#else
+    return not_si128(_mm_cmplt_epi32(a.v, b.v));
+#endif
+}
+
+CXXPH_FORCEINLINE i32x4 select(const i32x4_mask &m, const i32x4 &a, const i32x4 &b) CXXPH_NOEXCEPT
+{
+    return select_bits_si128(m.v, a.v, b.v);
+}
+
+CXXPH_FORCEINLINE i32x4 min(const i32x4 &a, const i32x4 &b) CXXPH_NOEXCEPT
+{
+#if CXXPH_SIMD_USE_X86_SSE4_1
+    return _mm_min_epi32(a.v, b.v);
+#else
+    return select_bits_si128(_mm_cmplt_epi32(a.v, b.v), a.v, b.v);
+#endif
+}
+
+CXXPH_FORCEINLINE i32x4 max(const i32x4 &a, const i32x4 &b) CXXPH_NOEXCEPT
+{
+#if CXXPH_SIMD_USE_X86_SSE4_1
+    return _mm_max_epi32(a.v, b.v);
+#else
+    return select_bits_si128(_mm_cmpgt_epi32(a.v, b.v), a.v, b.v);
+#endif
+}
+
+CXXPH_FORCEINLINE i32x4 abs(const i32x4 &a) CXXPH_NOEXCEPT
+{
+#if CXXPH_SIMD_USE_X86_SSSE3
+    return _mm_abs_epi32(a.v);
+#else
+    const __m128i sign = _mm_srai_epi32(a.v, 31);
+    return _mm_sub_epi32(_mm_xor_si128(a.v, sign), sign);
+#endif
+}
+
+CXXPH_FORCEINLINE i32x4 mul_add(const i32x4 &a, const i32x4 &b, const i32x4 &c) CXXPH_NOEXCEPT { return a * b + c; }
+
+CXXPH_FORCEINLINE i32x4 add_sat(const i32x4 &a, const i32x4 &b) CXXPH_NOEXCEPT
+{
+    const __m128i r = _mm_add_epi32(a.v, b.v);
+    // overflow: same sign operands, result of the other sign
+    const __m128i overflow = _mm_srai_epi32(_mm_andnot_si128(_mm_xor_si128(a.v, b.v), _mm_xor_si128(a.v, r)), 31);
+    const __m128i limit = _mm_xor_si128(_mm_srai_epi32(a.v, 31), _mm_set1_epi32(0x7fffffff));
+    return select_bits_si128(overflow, limit, r);
+}
+
+CXXPH_FORCEINLINE i32x4 sub_sat(const i32x4 &a, const i32x4 &b) CXXPH_NOEXCEPT
+{
+    const __m128i r = _mm_sub_epi32(a.v, b.v);
+    // overflow: different sign operands, result of the sign of b
+    const __m128i overflow = _mm_srai_epi32(_mm_and_si128(_mm_xor_si128(a.v, b.v), _mm_xor_si128(a.v, r)), 31);
+    const __m128i limit = _mm_xor_si128(_mm_srai_epi32(a.v, 31), _mm_set1_epi32(0x7fffffff));
+    return select_bits_si128(overflow, limit, r);
+}
+
+CXXPH_FORCEINLINE i32x4 mul_round_high(const i32x4 &a, const i32x4 &b) CXXPH_NOEXCEPT
+{
+#if CXXPH_SIMD_USE_X86_SSE4_1
+    // bits [31, 63) of the 64-bit products (+ rounding constant) of the even / odd lanes
+    const __m128i round = _mm_set1_epi64x(0x40000000);
+    const __m128i even = _mm_add_epi64(_mm_mul_epi32(a.v, b.v), round);
+    const __m128i odd = _mm_add_epi64(_mm_mul_epi32(_mm_srli_epi64(a.v, 32), _mm_srli_epi64(b.v, 32)), round);
+    const __m128i r = _mm_blend_epi16(_mm_srli_epi64(even, 31), _mm_slli_epi64(odd, 1), 0xcc);
+    // INT32_MIN only results from -1.0 * -1.0
+    return _mm_xor_si128(r, _mm_cmpeq_epi32(r, _mm_set1_epi32(std::numeric_limits<int32_t>::min())));
+#else
+    // signed products from the unsigned ones: a * b - ((a < 0) ? b : 0) * 2^32 - ((b < 0) ? a : 0) * 2^32
+    const __m128i round = _mm_set_epi32(0, 0x40000000, 0, 0x40000000);
+    const __m128i mask_hi = _mm_set_epi32(-1, 0, -1, 0);
+    const __m128i corr =
+        _mm_add_epi32(_mm_and_si128(_mm_srai_epi32(a.v, 31), b.v), _mm_and_si128(_mm_srai_epi32(b.v, 31), a.v));
+    const __m128i even = _mm_sub_epi64(_mm_add_epi64(_mm_mul_epu32(a.v, b.v), round), _mm_slli_epi64(corr, 32));
+    const __m128i odd = _mm_sub_epi64(
+        _mm_add_epi64(_mm_mul_epu32(_mm_srli_epi64(a.v, 32), _mm_srli_epi64(b.v, 32)), round),
+        _mm_and_si128(corr, mask_hi));
+    const __m128i r = _mm_or_si128(_mm_andnot_si128(mask_hi, _mm_srli_epi64(even, 31)),
+                                   _mm_and_si128(mask_hi, _mm_slli_epi64(odd, 1)));
+    return _mm_xor_si128(r, _mm_cmpeq_epi32(r, _mm_set1_epi32(std::numeric_limits<int32_t>::min())));
+#endif
+}
+
+CXXPH_FORCEINLINE i32x4 reverse_bytes(const i32x4 &a) CXXPH_NOEXCEPT
+{
+#if CXXPH_SIMD_USE_X86_SSSE3
+    return _mm_shuffle_epi8(a.v, _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3));
+#else
+    // swap the 16-bit halves, then the bytes of each half
+    const __m128i t = _mm_shufflehi_epi16(_mm_shufflelo_epi16(a.v, _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1));
+    return _mm_or_si128(_mm_slli_epi16(t, 8), _mm_srli_epi16(t, 8));
+#endif
+}
+
+CXXPH_FORCEINLINE i32x4_mask operator&(const i32x4_mask &a, const i32x4_mask &b) CXXPH_NOEXCEPT
+{
+    return _mm_and_si128(a.v, b.v);
+}
+
+CXXPH_FORCEINLINE i32x4_mask operator|(const i32x4_mask &a, const i32x4_mask &b) CXXPH_NOEXCEPT
+{
+    return _mm_or_si128(a.v, b.v);
+}
+
+CXXPH_FORCEINLINE bool any(const i32x4_mask &m) CXXPH_NOEXCEPT { return _mm_movemask_epi8(m.v) != 0; }
+CXXPH_FORCEINLINE bool all(const i32x4_mask &m) CXXPH_NOEXCEPT { return _mm_movemask_epi8(m.v) == 0xffff; }
+
+template <int I0, int I1, int I2, int I3>
+CXXPH_FORCEINLINE i32x4 shuffle(const i32x4 &a) CXXPH_NOEXCEPT
+{
+    return _mm_shuffle_epi32(a.v, _MM_SHUFFLE(I3, I2, I1, I0));
+}
+
+CXXPH_FORCEINLINE i32x4 reverse(const i32x4 &a) CXXPH_NOEXCEPT { return shuffle<3, 2, 1, 0>(a); }
+
+template <int I>
+CXXPH_FORCEINLINE int32_t extract(const i32x4 &a) CXXPH_NOEXCEPT
+{
+    return _mm_cvtsi128_si32(_mm_shuffle_epi32(a.v, _MM_SHUFFLE(I, I, I, I)));
+}
+
+CXXPH_FORCEINLINE int32_t reduce_add(const i32x4 &a) CXXPH_NOEXCEPT
+{
+    const i32x4 t = a + shuffle<2, 3, 0, 1>(a);
+    return _mm_cvtsi128_si32((t + shuffle<1, 0, 3, 2>(t)).v);
+}
+
+CXXPH_FORCEINLINE int32_t reduce_min(const i32x4 &a) CXXPH_NOEXCEPT
+{
+    const i32x4 t = min(a, shuffle<2, 3, 0, 1>(a));
+    return _mm_cvtsi128_si32(min(t, shuffle<1, 0, 3, 2>(t)).v);
+}
+
+CXXPH_FORCEINLINE int32_t reduce_max(const i32x4 &a) CXXPH_NOEXCEPT
+{
+    const i32x4 t = max(a, shuffle<2, 3, 0, 1>(a));
+    return _mm_cvtsi128_si32(max(t, shuffle<1, 0, 3, 2>(t)).v);
+}
+
+template <int S>
+CXXPH_FORCEINLINE i32x4 shl(const i32x4 &a) CXXPH_NOEXCEPT
+{
+    return _mm_slli_epi32(a.v, S);
+}
+
+template <int S>
+CXXPH_FORCEINLINE i32x4 sra(const i32x4 &a) CXXPH_NOEXCEPT
+{
+    return _mm_srai_epi32(a.v, S);
+}
+
+template <int S>
+CXXPH_FORCEINLINE i32x4 srl(const i32x4 &a) CXXPH_NOEXCEPT
+{
+    return _mm_srli_epi32(a.v, S);
+}
+
+//
+// i16x8
+//
+struct i16x8_mask {
+    __m128i v;
+
+    i16x8_mask() CXXPH_NOEXCEPT {}
+    i16x8_mask(__m128i x) CXXPH_NOEXCEPT : v(x) {}
+};
+
+struct i16x8 {
+    typedef int16_t value_type;
+    typedef i16x8_mask mask_type;
+    enum { num_lanes = 8 };
+
+    __m128i v;
+
+    i16x8() CXXPH_NOEXCEPT {}
+    i16x8(__m128i x) CXXPH_NOEXCEPT : v(x) {}
+    i16x8(int16_t x) CXXPH_NOEXCEPT : v(_mm_set1_epi16(x)) {}
+
+    static CXXPH_FORCEINLINE i16x8 zero() CXXPH_NOEXCEPT { return _mm_setzero_si128(); }
+
+    static CXXPH_FORCEINLINE i16x8 load(const int16_t *mem_addr) CXXPH_NOEXCEPT
+    {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i *>(mem_addr));
+    }
+
+    static CXXPH_FORCEINLINE i16x8 load_aligned(const int16_t *mem_addr) CXXPH_NOEXCEPT
+    {
+        return _mm_load_si128(reinterpret_cast<const __m128i *>(mem_addr));
+    }
+
+    CXXPH_FORCEINLINE void store(int16_t *mem_addr) const CXXPH_NOEXCEPT
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(mem_addr), v);
+    }
+
+    CXXPH_FORCEINLINE void store_aligned(int16_t *mem_addr) const CXXPH_NOEXCEPT
+    {
+        _mm_store_si128(reinterpret_cast<__m128i *>(mem_addr), v);
+    }
+
+    CXXPH_FORCEINLINE void store_stream(int16_t *mem_addr) const CXXPH_NOEXCEPT
+    {
+        _mm_stream_si128(reinterpret_cast<__m128i *>(mem_addr), v);
+    }
+};
+
+CXXPH_FORCEINLINE i16x8 operator+(const i16x8 &a, const i16x8 &b) CXXPH_NOEXCEPT { return _mm_add_epi16(a.v, b.v); }
+CXXPH_FORCEINLINE i16x8 operator-(const i16x8 &a, const i16x8 &b) CXXPH_NOEXCEPT { return _mm_sub_epi16(a.v, b.v); }
+CXXPH_FORCEINLINE i16x8 operator*(const i16x8 &a, const i16x8 &b) CXXPH_NOEXCEPT { return _mm_mullo_epi16(a.v, b.v); }
+CXXPH_FORCEINLINE i16x8 operator-(const i16x8 &a) CXXPH_NOEXCEPT { return _mm_sub_epi16(_mm_setzero_si128(), a.v); }
+CXXPH_FORCEINLINE i16x8 operator&(const i16x8 &a, const i16x8 &b) CXXPH_NOEXCEPT { return _mm_and_si128(a.v, b.v); }
+CXXPH_FORCEINLINE i16x8 operator|(const i16x8 &a, const i16x8 &b) CXXPH_NOEXCEPT { return _mm_or_si128(a.v, b.v); }
+CXXPH_FORCEINLINE i16x8 operator^(const i16x8 &a, const i16x8 &b) CXXPH_NOEXCEPT { return _mm_xor_si128(a.v, b.v); }
+CXXPH_FORCEINLINE i16x8 min(const i16x8 &a, const i16x8 &b) CXXPH_NOEXCEPT { return _mm_min_epi16(a.v, b.v); }
+CXXPH_FORCEINLINE i16x8 max(const i16x8 &a, const i16x8 &b) CXXPH_NOEXCEPT { return _mm_max_epi16(a.v, b.v); }
+CXXPH_FORCEINLINE i16x8 add_sat(const i16x8 &a, const i16x8 &b) CXXPH_NOEXCEPT { return _mm_adds_epi16(a.v, b.v); }
+CXXPH_FORCEINLINE i16x8 sub_sat(const i16x8 &a, const i16x8 &b) CXXPH_NOEXCEPT { return _mm_subs_epi16(a.v, b.v); }
+
+CXXPH_FORCEINLINE i16x8 abs(const i16x8 &a) CXXPH_NOEXCEPT
+{
+#if CXXPH_SIMD_USE_X86_SSSE3
+    return _mm_abs_epi16(a.v);
+#else
+    return _mm_max_epi16(a.v, _mm_sub_epi16(_mm_setzero_si128(), a.v));
+#endif
+}
+
+CXXPH_FORCEINLINE i16x8 mul_add(const i16x8 &a, const i16x8 &b, const i16x8 &c) CXXPH_NOEXCEPT { return a * b + c; }
+
+CXXPH_FORCEINLINE i16x8 mul_round_high(const i16x8 &a, const i16x8 &b) CXXPH_NOEXCEPT
+{
+#if CXXPH_SIMD_USE_X86_SSSE3
+    const __m128i r = _mm_mulhrs_epi16(a.v, b.v);
+    // INT16_MIN only results from -1.0 * -1.0
+    return _mm_xor_si128(r, _mm_cmpeq_epi16(r, _mm_set1_epi16(std::numeric_limits<int16_t>::min())));
+#else
+    const __m128i lo = _mm_mullo_epi16(a.v, b.v);
+    const __m128i hi = _mm_mulhi_epi16(a.v, b.v);
+    const __m128i round = _mm_set1_epi32(0x4000);
+    const __m128i r0 = _mm_srai_epi32(_mm_add_epi32(_mm_unpacklo_epi16(lo, hi), round), 15);
+    const __m128i r1 = _mm_srai_epi32(_mm_add_epi32(_mm_unpackhi_epi16(lo, hi), round), 15);
+    return _mm_packs_epi32(r0, r1);
+#endif
+}
+
+CXXPH_FORCEINLINE i16x8 reverse_bytes(const i16x8 &a) CXXPH_NOEXCEPT
+{
+#if CXXPH_SIMD_USE_X86_SSSE3
+    return _mm_shuffle_epi8(a.v, _mm_set_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1));
+#else
+    return _mm_or_si128(_mm_slli_epi16(a.v, 8), _mm_srli_epi16(a.v, 8));
+#endif
+}
+
+CXXPH_FORCEINLINE i16x8_mask cmp_eq(const i16x8 &a, const i16x8 &b) CXXPH_NOEXCEPT
+{
+    return _mm_cmpeq_epi16(a.v, b.v);
+}
+
+CXXPH_FORCEINLINE i16x8_mask cmp_lt(const i16x8 &a, const i16x8 &b) CXXPH_NOEXCEPT
+{
+    return _mm_cmplt_epi16(a.v, b.v);
+}
+
+CXXPH_FORCEINLINE i16x8_mask cmp_le(const i16x8 &a, const i16x8 &b) CXXPH_NOEXCEPT
+{
+    return _mm_cmpeq_epi16(_mm_min_epi16(a.v, b.v), a.v);
+}
+
+CXXPH_FORCEINLINE i16x8_mask cmp_gt(const i16x8 &a, const i16x8 &b) CXXPH_NOEXCEPT
+{
+    return _mm_cmpgt_epi16(a.v, b.v);
+}
+
+CXXPH_FORCEINLINE i16x8_mask cmp_ge(const i16x8 &a, const i16x8 &b) CXXPH_NOEXCEPT
+{
+    return _mm_cmpeq_epi16(_mm_max_epi16(a.v, b.v), a.v);
+}
+
+CXXPH_FORCEINLINE i16x8 select(const i16x8_mask &m, const i16x8 &a, const i16x8 &b) CXXPH_NOEXCEPT
+{
+    return select_bits_si128(m.v, a.v, b.v);
+}
+
+CXXPH_FORCEINLINE i16x8_mask operator&(const i16x8_mask &a, const i16x8_mask &b) CXXPH_NOEXCEPT
+{
+    return _mm_and_si128(a.v, b.v);
+}
+
+CXXPH_FORCEINLINE i16x8_mask operator|(const i16x8_mask &a, const i16x8_mask &b) CXXPH_NOEXCEPT
+{
+    return _mm_or_si128(a.v, b.v);
+}
+
+CXXPH_FORCEINLINE bool any(const i16x8_mask &m) CXXPH_NOEXCEPT { return _mm_movemask_epi8(m.v) != 0; }
+CXXPH_FORCEINLINE bool all(const i16x8_mask &m) CXXPH_NOEXCEPT { return _mm_movemask_epi8(m.v) == 0xffff; }
+
+template <int I0, int I1, int I2, int I3>
+CXXPH_FORCEINLINE i16x8 shuffle(const i16x8 &a) CXXPH_NOEXCEPT
+{
+    return _mm_shufflehi_epi16(_mm_shufflelo_epi16(a.v, _MM_SHUFFLE(I3, I2, I1, I0)), _MM_SHUFFLE(I3, I2, I1, I0));
+}
+
+CXXPH_FORCEINLINE i16x8 reverse(const i16x8 &a) CXXPH_NOEXCEPT
+{
+    const __m128i t = shuffle<3, 2, 1, 0>(a).v;
+    return _mm_shuffle_epi32(t, _MM_SHUFFLE(1, 0, 3, 2));
+}
+
+template <int I>
+CXXPH_FORCEINLINE int16_t extract(const i16x8 &a) CXXPH_NOEXCEPT
+{
+    return static_cast<int16_t>(_mm_extract_epi16(a.v, I));
+}
+
+CXXPH_FORCEINLINE int16_t reduce_add(const i16x8 &a) CXXPH_NOEXCEPT
+{
+    __m128i t = _mm_add_epi16(a.v, _mm_shuffle_epi32(a.v, _MM_SHUFFLE(1, 0, 3, 2)));
+    t = _mm_add_epi16(t, _mm_shuffle_epi32(t, _MM_SHUFFLE(2, 3, 0, 1)));
+    t = _mm_add_epi16(t, _mm_srli_epi32(t, 16));
+    return static_cast<int16_t>(_mm_cvtsi128_si32(t));
+}
+
+CXXPH_FORCEINLINE int16_t reduce_min(const i16x8 &a) CXXPH_NOEXCEPT
+{
+    __m128i t = _mm_min_epi16(a.v, _mm_shuffle_epi32(a.v, _MM_SHUFFLE(1, 0, 3, 2)));
+    t = _mm_min_epi16(t, _mm_shuffle_epi32(t, _MM_SHUFFLE(2, 3, 0, 1)));
+    t = _mm_min_epi16(t, _mm_srli_epi32(t, 16));
+    return static_cast<int16_t>(_mm_cvtsi128_si32(t));
+}
+
+CXXPH_FORCEINLINE int16_t reduce_max(const i16x8 &a) CXXPH_NOEXCEPT
+{
+    __m128i t = _mm_max_epi16(a.v, _mm_shuffle_epi32(a.v, _MM_SHUFFLE(1, 0, 3, 2)));
+    t = _mm_max_epi16(t, _mm_shuffle_epi32(t, _MM_SHUFFLE(2, 3, 0, 1)));
+    t = _mm_max_epi16(t, _mm_srli_epi32(t, 16));
+    return static_cast<int16_t>(_mm_cvtsi128_si32(t));
+}
+
+template <int S>
+CXXPH_FORCEINLINE i16x8 shl(const i16x8 &a) CXXPH_NOEXCEPT
+{
+    return _mm_slli_epi16(a.v, S);
+}
+
+template <int S>
+CXXPH_FORCEINLINE i16x8 sra(const i16x8 &a) CXXPH_NOEXCEPT
+{
+    return _mm_srai_epi16(a.v, S);
+}
+
+template <int S>
+CXXPH_FORCEINLINE i16x8 srl(const i16x8 &a) CXXPH_NOEXCEPT
+{
+    return _mm_srli_epi16(a.v, S);
+}
+
+//
+// conversions (128-bit)
+//
+CXXPH_FORCEINLINE f32x4 to_f32(const i32x4 &a) CXXPH_NOEXCEPT { return _mm_cvtepi32_ps(a.v); }
+CXXPH_FORCEINLINE i32x4 to_i32(const f32x4 &a) CXXPH_NOEXCEPT { return _mm_cvttps_epi32(a.v); }
+CXXPH_FORCEINLINE i32x4 round_to_i32(const f32x4 &a) CXXPH_NOEXCEPT { return _mm_cvtps_epi32(a.v); }
+CXXPH_FORCEINLINE i32x4 bitcast_i32(const f32x4 &a) CXXPH_NOEXCEPT { return _mm_castps_si128(a.v); }
+CXXPH_FORCEINLINE f32x4 bitcast_f32(const i32x4 &a) CXXPH_NOEXCEPT { return _mm_castsi128_ps(a.v); }
+
+CXXPH_FORCEINLINE i32x4 to_i32_lo(const i16x8 &a) CXXPH_NOEXCEPT
+{
+#if CXXPH_SIMD_USE_X86_SSE4_1
+    return _mm_cvtepi16_epi32(a.v);
+#else
+    return _mm_srai_epi32(_mm_unpacklo_epi16(a.v, a.v), 16);
+#endif
+}
+
+CXXPH_FORCEINLINE i32x4 to_i32_hi(const i16x8 &a) CXXPH_NOEXCEPT
+{
+    return _mm_srai_epi32(_mm_unpackhi_epi16(a.v, a.v), 16);
+}
+
+CXXPH_FORCEINLINE i16x8 pack_sat(const i32x4 &a, const i32x4 &b) CXXPH_NOEXCEPT { return _mm_packs_epi32(a.v, b.v); }
+
+CXXPH_SIMD_DEFINE_COMPOUND_ASSIGNMENT_OPS(, f32x4)
+CXXPH_SIMD_DEFINE_COMPOUND_ASSIGNMENT_OPS(, i32x4)
+CXXPH_SIMD_DEFINE_COMPOUND_ASSIGNMENT_OPS(, i16x8)
+
+#if CXXPH_SIMD_USE_X86_AVX
+//
+// f32x8
+//
+struct f32x8_mask {
+    __m256 v;
+
+    f32x8_mask() CXXPH_NOEXCEPT {}
+    f32x8_mask(__m256 x) CXXPH_NOEXCEPT : v(x) {}
+};
+
+struct f32x8 {
+    typedef float value_type;
+    typedef f32x8_mask mask_type;
+    typedef f32x4 half_type;
+    enum { num_lanes = 8 };
+
+    __m256 v;
+
+    f32x8() CXXPH_NOEXCEPT {}
+    f32x8(__m256 x) CXXPH_NOEXCEPT : v(x) {}
+    f32x8(float x) CXXPH_NOEXCEPT : v(_mm256_set1_ps(x)) {}
+
+    static CXXPH_FORCEINLINE f32x8 zero() CXXPH_NOEXCEPT { return _mm256_setzero_ps(); }
+    static CXXPH_FORCEINLINE f32x8 load(const float *mem_addr) CXXPH_NOEXCEPT { return _mm256_loadu_ps(mem_addr); }
+
+    static CXXPH_FORCEINLINE f32x8 load_aligned(const float *mem_addr) CXXPH_NOEXCEPT
+    {
+        return _mm256_load_ps(mem_addr);
+    }
+
+    CXXPH_FORCEINLINE void store(float *mem_addr) const CXXPH_NOEXCEPT { _mm256_storeu_ps(mem_addr, v); }
+    CXXPH_FORCEINLINE void store_aligned(float *mem_addr) const CXXPH_NOEXCEPT { _mm256_store_ps(mem_addr, v); }
+
+    CXXPH_FORCEINLINE void store_stream(float *mem_addr) const CXXPH_NOEXCEPT { _mm256_stream_ps(mem_addr, v); }
+};
+
+CXXPH_FORCEINLINE f32x4 low(const f32x8 &a) CXXPH_NOEXCEPT { return _mm256_castps256_ps128(a.v); }
+CXXPH_FORCEINLINE f32x4 high(const f32x8 &a) CXXPH_NOEXCEPT { return _mm256_extractf128_ps(a.v, 1); }
+
+CXXPH_FORCEINLINE f32x8 combine(const f32x4 &lo, const f32x4 &hi) CXXPH_NOEXCEPT
+{
+    return _mm256_insertf128_ps(_mm256_castps128_ps256(lo.v), hi.v, 1);
+}
+
+CXXPH_FORCEINLINE f32x8 operator+(const f32x8 &a, const f32x8 &b) CXXPH_NOEXCEPT { return _mm256_add_ps(a.v, b.v); }
+CXXPH_FORCEINLINE f32x8 operator-(const f32x8 &a, const f32x8 &b) CXXPH_NOEXCEPT { return _mm256_sub_ps(a.v, b.v); }
+CXXPH_FORCEINLINE f32x8 operator*(const f32x8 &a, const f32x8 &b) CXXPH_NOEXCEPT { return _mm256_mul_ps(a.v, b.v); }
+CXXPH_FORCEINLINE f32x8 operator/(const f32x8 &a, const f32x8 &b) CXXPH_NOEXCEPT { return _mm256_div_ps(a.v, b.v); }
+CXXPH_FORCEINLINE f32x8 operator-(const f32x8 &a) CXXPH_NOEXCEPT { return _mm256_xor_ps(a.v, _mm256_set1_ps(-0.0f)); }
+CXXPH_FORCEINLINE f32x8 min(const f32x8 &a, const f32x8 &b) CXXPH_NOEXCEPT { return _mm256_min_ps(a.v, b.v); }
+CXXPH_FORCEINLINE f32x8 max(const f32x8 &a, const f32x8 &b) CXXPH_NOEXCEPT { return _mm256_max_ps(a.v, b.v); }
+CXXPH_FORCEINLINE f32x8 abs(const f32x8 &a) CXXPH_NOEXCEPT { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v); }
+CXXPH_FORCEINLINE f32x8 sqrt(const f32x8 &a) CXXPH_NOEXCEPT { return _mm256_sqrt_ps(a.v); }
+CXXPH_FORCEINLINE f32x8 rsqrt_estimate(const f32x8 &a) CXXPH_NOEXCEPT { return _mm256_rsqrt_ps(a.v); }
+CXXPH_FORCEINLINE f32x8 rcp_estimate(const f32x8 &a) CXXPH_NOEXCEPT { return _mm256_rcp_ps(a.v); }
+
+CXXPH_FORCEINLINE f32x8 mul_add(const f32x8 &a, const f32x8 &b, const f32x8 &c) CXXPH_NOEXCEPT
+{
+#if CXXPH_SIMD_USE_X86_FMA
+    return _mm256_fmadd_ps(a.v, b.v, c.v);
+#else
+    return _mm256_add_ps(_mm256_mul_ps(a.v, b.v), c.v);
+#endif
+}
+
+CXXPH_FORCEINLINE f32x8_mask cmp_eq(const f32x8 &a, const f32x8 &b) CXXPH_NOEXCEPT
+{
+    return _mm256_cmp_ps(a.v, b.v, _CMP_EQ_OQ);
+}
+
+CXXPH_FORCEINLINE f32x8_mask cmp_lt(const f32x8 &a, const f32x8 &b) CXXPH_NOEXCEPT
+{
+    return _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ);
+}
+
+CXXPH_FORCEINLINE f32x8_mask cmp_le(const f32x8 &a, const f32x8 &b) CXXPH_NOEXCEPT
+{
+    return _mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ);
+}
+
+CXXPH_FORCEINLINE f32x8_mask cmp_gt(const f32x8 &a, const f32x8 &b) CXXPH_NOEXCEPT
+{
+    return _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ);
+}
+
+CXXPH_FORCEINLINE f32x8_mask cmp_ge(const f32x8 &a, const f32x8 &b) CXXPH_NOEXCEPT
+{
+    return _mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ);
+}
+
+CXXPH_FORCEINLINE f32x8 select(const f32x8_mask &m, const f32x8 &a, const f32x8 &b) CXXPH_NOEXCEPT
+{
+    return _mm256_blendv_ps(b.v, a.v, m.v);
+}
+
+CXXPH_FORCEINLINE f32x8_mask operator&(const f32x8_mask &a, const f32x8_mask &b) CXXPH_NOEXCEPT
+{
+    return _mm256_and_ps(a.v, b.v);
+}
+
+CXXPH_FORCEINLINE f32x8_mask operator|(const f32x8_mask &a, const f32x8_mask &b) CXXPH_NOEXCEPT
+{
+    return _mm256_or_ps(a.v, b.v);
+}
+
+CXXPH_FORCEINLINE bool any(const f32x8_mask &m) CXXPH_NOEXCEPT { return _mm256_movemask_ps(m.v) != 0; }
+CXXPH_FORCEINLINE bool all(const f32x8_mask &m) CXXPH_NOEXCEPT { return _mm256_movemask_ps(m.v) == 0xff; }
+
+template <int I0, int I1, int I2, int I3>
+CXXPH_FORCEINLINE f32x8 shuffle(const f32x8 &a) CXXPH_NOEXCEPT
+{
+    return _mm256_permute_ps(a.v, _MM_SHUFFLE(I3, I2, I1, I0));
+}
+
+CXXPH_FORCEINLINE f32x8 reverse(const f32x8 &a) CXXPH_NOEXCEPT
+{
+    return _mm256_permute_ps(_mm256_permute2f128_ps(a.v, a.v, 0x01), _MM_SHUFFLE(0, 1, 2, 3));
+}
+
+CXXPH_FORCEINLINE void interleave(const f32x8 &a, const f32x8 &b, f32x8 *lo, f32x8 *hi) CXXPH_NOEXCEPT
+{
+    // unpack works within 128-bit lanes: [a0 b0 a1 b1 | a4 b4 a5 b5], [a2 b2 a3 b3 | a6 b6 a7 b7]
+    const __m256 l = _mm256_unpacklo_ps(a.v, b.v);
+    const __m256 h = _mm256_unpackhi_ps(a.v, b.v);
+    (*lo) = _mm256_permute2f128_ps(l, h, 0x20);
+    (*hi) = _mm256_permute2f128_ps(l, h, 0x31);
+}
+
+CXXPH_FORCEINLINE void deinterleave(const f32x8 &a, const f32x8 &b, f32x8 *even, f32x8 *odd) CXXPH_NOEXCEPT
+{
+    // [a0 a1 a2 a3 | b0 b1 b2 b3], [a4 a5 a6 a7 | b4 b5 b6 b7]
+    const __m256 l = _mm256_permute2f128_ps(a.v, b.v, 0x20);
+    const __m256 h = _mm256_permute2f128_ps(a.v, b.v, 0x31);
+    (*even) = _mm256_shuffle_ps(l, h, _MM_SHUFFLE(2, 0, 2, 0));
+    (*odd) = _mm256_shuffle_ps(l, h, _MM_SHUFFLE(3, 1, 3, 1));
+}
+
+template <int I>
+CXXPH_FORCEINLINE float extract(const f32x8 &a) CXXPH_NOEXCEPT
+{
+    return (I < 4) ? extract<(I & 3)>(low(a)) : extract<(I & 3)>(high(a));
+}
+
+CXXPH_FORCEINLINE float reduce_add(const f32x8 &a) CXXPH_NOEXCEPT { return reduce_add(low(a) + high(a)); }
+CXXPH_FORCEINLINE float reduce_min(const f32x8 &a) CXXPH_NOEXCEPT { return reduce_min(min(low(a), high(a))); }
+CXXPH_FORCEINLINE float reduce_max(const f32x8 &a) CXXPH_NOEXCEPT { return reduce_max(max(low(a), high(a))); }
+
+CXXPH_SIMD_DEFINE_COMPOUND_ASSIGNMENT_OPS(, f32x8)
+#endif // CXXPH_SIMD_USE_X86_AVX
+
+#if CXXPH_SIMD_USE_X86_AVX2
+//
+// i32x8
+//
+struct i32x8_mask {
+    __m256i v;
+
+    i32x8_mask() CXXPH_NOEXCEPT {}
+    i32x8_mask(__m256i x) CXXPH_NOEXCEPT : v(x) {}
+};
+
+struct i32x8 {
+    typedef int32_t value_type;
+    typedef i32x8_mask mask_type;
+    typedef i32x4 half_type;
+    enum { num_lanes = 8 };
+
+    __m256i v;
+
+    i32x8() CXXPH_NOEXCEPT {}
+    i32x8(__m256i x) CXXPH_NOEXCEPT : v(x) {}
+    i32x8(int32_t x) CXXPH_NOEXCEPT : v(_mm256_set1_epi32(x)) {}
+
+    static CXXPH_FORCEINLINE i32x8 zero() CXXPH_NOEXCEPT { return _mm256_setzero_si256(); }
+
+    static CXXPH_FORCEINLINE i32x8 load(const int32_t *mem_addr) CXXPH_NOEXCEPT
+    {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(mem_addr));
+    }
+
+    static CXXPH_FORCEINLINE i32x8 load_aligned(const int32_t *mem_addr) CXXPH_NOEXCEPT
+    {
+        return _mm256_load_si256(reinterpret_cast<const __m256i *>(mem_addr));
+    }
+
+    CXXPH_FORCEINLINE void store(int32_t *mem_addr) const CXXPH_NOEXCEPT
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(mem_addr), v);
+    }
+
+    CXXPH_FORCEINLINE void store_aligned(int32_t *mem_addr) const CXXPH_NOEXCEPT
+    {
+        _mm256_store_si256(reinterpret_cast<__m256i *>(mem_addr), v);
+    }
+
+    CXXPH_FORCEINLINE void store_stream(int32_t *mem_addr) const CXXPH_NOEXCEPT
+    {
+        _mm256_stream_si256(reinterpret_cast<__m256i *>(mem_addr), v);
+    }
+};
+
+CXXPH_FORCEINLINE i32x4 low(const i32x8 &a) CXXPH_NOEXCEPT { return _mm256_castsi256_si128(a.v); }
+CXXPH_FORCEINLINE i32x4 high(const i32x8 &a) CXXPH_NOEXCEPT { return _mm256_extracti128_si256(a.v, 1); }
+
+CXXPH_FORCEINLINE i32x8 combine(const i32x4 &lo, const i32x4 &hi) CXXPH_NOEXCEPT
+{
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(lo.v), hi.v, 1);
+}
+
+CXXPH_FORCEINLINE i32x8 operator+(const i32x8 &a, const i32x8 &b) CXXPH_NOEXCEPT { return _mm256_add_epi32(a.v, b.v); }
+CXXPH_FORCEINLINE i32x8 operator-(const i32x8 &a, const i32x8 &b) CXXPH_NOEXCEPT { return _mm256_sub_epi32(a.v, b.v); }
+
+CXXPH_FORCEINLINE i32x8 operator*(const i32x8 &a, const i32x8 &b) CXXPH_NOEXCEPT
+{
+    return _mm256_mullo_epi32(a.v, b.v);
+}
+
+CXXPH_FORCEINLINE i32x8 operator-(const i32x8 &a) CXXPH_NOEXCEPT
+{
+    return _mm256_sub_epi32(_mm256_setzero_si256(), a.v);
+}
+
+CXXPH_FORCEINLINE i32x8 operator&(const i32x8 &a, const i32x8 &b) CXXPH_NOEXCEPT { return _mm256_and_si256(a.v, b.v); }
+CXXPH_FORCEINLINE i32x8 operator|(const i32x8 &a, const i32x8 &b) CXXPH_NOEXCEPT { return _mm256_or_si256(a.v, b.v); }
+CXXPH_FORCEINLINE i32x8 operator^(const i32x8 &a, const i32x8 &b) CXXPH_NOEXCEPT { return _mm256_xor_si256(a.v, b.v); }
+CXXPH_FORCEINLINE i32x8 min(const i32x8 &a, const i32x8 &b) CXXPH_NOEXCEPT { return _mm256_min_epi32(a.v, b.v); }
+CXXPH_FORCEINLINE i32x8 max(const i32x8 &a, const i32x8 &b) CXXPH_NOEXCEPT { return _mm256_max_epi32(a.v, b.v); }
+CXXPH_FORCEINLINE i32x8 abs(const i32x8 &a) CXXPH_NOEXCEPT { return _mm256_abs_epi32(a.v); }
+CXXPH_FORCEINLINE i32x8 mul_add(const i32x8 &a, const i32x8 &b, const i32x8 &c) CXXPH_NOEXCEPT { return a * b + c; }
+
+CXXPH_FORCEINLINE i32x8 add_sat(const i32x8 &a, const i32x8 &b) CXXPH_NOEXCEPT
+{
+    const __m256i r = _mm256_add_epi32(a.v, b.v);
+    const __m256i overflow = _mm256_andnot_si256(_mm256_xor_si256(a.v, b.v), _mm256_xor_si256(a.v, r));
+    const __m256i limit = _mm256_xor_si256(_mm256_srai_epi32(a.v, 31), _mm256_set1_epi32(0x7fffffff));
+    return _mm256_castps_si256(
+        _mm256_blendv_ps(_mm256_castsi256_ps(r), _mm256_castsi256_ps(limit), _mm256_castsi256_ps(overflow)));
+}
+
+CXXPH_FORCEINLINE i32x8 sub_sat(const i32x8 &a, const i32x8 &b) CXXPH_NOEXCEPT
+{
+    const __m256i r = _mm256_sub_epi32(a.v, b.v);
+    const __m256i overflow = _mm256_and_si256(_mm256_xor_si256(a.v, b.v), _mm256_xor_si256(a.v, r));
+    const __m256i limit = _mm256_xor_si256(_mm256_srai_epi32(a.v, 31), _mm256_set1_epi32(0x7fffffff));
+    return _mm256_castps_si256(
+        _mm256_blendv_ps(_mm256_castsi256_ps(r), _mm256_castsi256_ps(limit), _mm256_castsi256_ps(overflow)));
+}
+
+CXXPH_FORCEINLINE i32x8 mul_round_high(const i32x8 &a, const i32x8 &b) CXXPH_NOEXCEPT
+{
+    const __m256i round = _mm256_set1_epi64x(0x40000000);
+    const __m256i even = _mm256_add_epi64(_mm256_mul_epi32(a.v, b.v), round);
+    const __m256i odd =
+        _mm256_add_epi64(_mm256_mul_epi32(_mm256_srli_epi64(a.v, 32), _mm256_srli_epi64(b.v, 32)), round);
+    const __m256i r = _mm256_blend_epi32(_mm256_srli_epi64(even, 31), _mm256_slli_epi64(odd, 1), 0xaa);
+    return _mm256_xor_si256(r, _mm256_cmpeq_epi32(r, _mm256_set1_epi32(std::numeric_limits<int32_t>::min())));
+}
+
+CXXPH_FORCEINLINE i32x8 reverse_bytes(const i32x8 &a) CXXPH_NOEXCEPT
+{
+    const __m128i pattern = _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    return _mm256_shuffle_epi8(a.v, _mm256_broadcastsi128_si256(pattern));
+}
+
+CXXPH_FORCEINLINE i32x8_mask cmp_eq(const i32x8 &a, const i32x8 &b) CXXPH_NOEXCEPT
+{
+    return _mm256_cmpeq_epi32(a.v, b.v);
+}
+
+CXXPH_FORCEINLINE i32x8_mask cmp_lt(const i32x8 &a, const i32x8 &b) CXXPH_NOEXCEPT
+{
+    return _mm256_cmpgt_epi32(b.v, a.v);
+}
+
+CXXPH_FORCEINLINE i32x8_mask cmp_le(const i32x8 &a, const i32x8 &b) CXXPH_NOEXCEPT
+{
+    return _mm256_cmpeq_epi32(_mm256_min_epi32(a.v, b.v), a.v);
+}
+
+CXXPH_FORCEINLINE i32x8_mask cmp_gt(const i32x8 &a, const i32x8 &b) CXXPH_NOEXCEPT
+{
+    return _mm256_cmpgt_epi32(a.v, b.v);
+}
+
+CXXPH_FORCEINLINE i32x8_mask cmp_ge(const i32x8 &a, const i32x8 &b) CXXPH_NOEXCEPT
+{
+    return _mm256_cmpeq_epi32(_mm256_max_epi32(a.v, b.v), a.v);
+}
+
+CXXPH_FORCEINLINE i32x8 select(const i32x8_mask &m, const i32x8 &a, const i32x8 &b) CXXPH_NOEXCEPT
+{
+    return _mm256_blendv_epi8(b.v, a.v, m.v);
+}
+
+CXXPH_FORCEINLINE i32x8_mask operator&(const i32x8_mask &a, const i32x8_mask &b) CXXPH_NOEXCEPT
+{
+    return _mm256_and_si256(a.v, b.v);
+}
+
+CXXPH_FORCEINLINE i32x8_mask operator|(const i32x8_mask &a, const i32x8_mask &b) CXXPH_NOEXCEPT
+{
+    return _mm256_or_si256(a.v, b.v);
+}
+
+CXXPH_FORCEINLINE bool any(const i32x8_mask &m) CXXPH_NOEXCEPT { return _mm256_movemask_epi8(m.v) != 0; }
+CXXPH_FORCEINLINE bool all(const i32x8_mask &m) CXXPH_NOEXCEPT { return _mm256_movemask_epi8(m.v) == -1; }
+
+template <int I0, int I1, int I2, int I3>
+CXXPH_FORCEINLINE i32x8 shuffle(const i32x8 &a) CXXPH_NOEXCEPT
+{
+    return _mm256_shuffle_epi32(a.v, _MM_SHUFFLE(I3, I2, I1, I0));
+}
+
+CXXPH_FORCEINLINE i32x8 reverse(const i32x8 &a) CXXPH_NOEXCEPT
+{
+    return _mm256_permutevar8x32_epi32(a.v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+}
+
+template <int I>
+CXXPH_FORCEINLINE int32_t extract(const i32x8 &a) CXXPH_NOEXCEPT
+{
+    return (I < 4) ? extract<(I & 3)>(low(a)) : extract<(I & 3)>(high(a));
+}
+
+CXXPH_FORCEINLINE int32_t reduce_add(const i32x8 &a) CXXPH_NOEXCEPT { return reduce_add(low(a) + high(a)); }
+CXXPH_FORCEINLINE int32_t reduce_min(const i32x8 &a) CXXPH_NOEXCEPT { return reduce_min(min(low(a), high(a))); }
+CXXPH_FORCEINLINE int32_t reduce_max(const i32x8 &a) CXXPH_NOEXCEPT { return reduce_max(max(low(a), high(a))); }
+
+template <int S>
+CXXPH_FORCEINLINE i32x8 shl(const i32x8 &a) CXXPH_NOEXCEPT
+{
+    return _mm256_slli_epi32(a.v, S);
+}
+
+template <int S>
+CXXPH_FORCEINLINE i32x8 sra(const i32x8 &a) CXXPH_NOEXCEPT
+{
+    return _mm256_srai_epi32(a.v, S);
+}
+
+template <int S>
+CXXPH_FORCEINLINE i32x8 srl(const i32x8 &a) CXXPH_NOEXCEPT
+{
+    return _mm256_srli_epi32(a.v, S);
+}
+
+CXXPH_SIMD_DEFINE_COMPOUND_ASSIGNMENT_OPS(, i32x8)
+#endif // CXXPH_SIMD_USE_X86_AVX2
+
+} // namespace CXXPH_SIMD_ABI_NAMESPACE
+} // namespace simd
+} // namespace cxxporthelper
+
+#endif // CXXPORTHELPER_SIMD_X86_HPP_
@@ -0,0 +1,153 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#ifndef CXXPORTHELPER_PCM_FORMAT_HPP_
+#define CXXPORTHELPER_PCM_FORMAT_HPP_
+
+//
+// PCM sample format conversion
+//
+// Converts arrays of PCM samples between the integer and floating point
+// formats by the best kernel build for the CPU. Full scale of the integer
+// formats corresponds to [-1.0, 1.0) of the floating point formats:
+//
+//   S16         : int16_t,                  x / 32768
+//   S24_PACKED  : 3 bytes (little endian),  x / 8388608
+//   S32         : int32_t,                  x / 2147483648
+//   F32, F64    : float, double
+//
+// Conversions to integer formats saturate out of range values (NaN gives an
+// unspecified value), and round the dropped fraction / low order bits as
+// specified by the rounding mode. Other conversions are exact or rounded to
+// nearest by the floating point unit.
+//
+// The arrays have to be aligned to the size of their sample type (no
+// requirement for S24_PACKED). dest and src must not overlap, except that
+// dest may be the same as src if both formats have the same sample size.
+//
+// Multichannel float frames are converted between the interleaved and the
+// planar (one buffer per channel) layouts by interleave() / deinterleave(),
+// vectorized for 2, 4, 6 and 8 channels. The buffers do not have to be
+// aligned, but aligned_memory buffers avoid loads and stores across cache
+// lines.
+//
+// Big endian data (AIFF, network streams) is handled by swap_byte_order()
+// (2, 3, 4 and 8 byte samples, in place or not), or converted to F32 in one
+// pass by convert_from_big_endian().
+//
+
+#include <cxxporthelper/compiler.hpp>
+#include <cxxporthelper/cstddef>
+
+namespace cxxporthelper {
+namespace pcm_format {
+
+/**
+ * Sample formats
+ */
+enum sample_format_t {
+    SAMPLE_FORMAT_S16,        ///< signed 16 bit integer
+    SAMPLE_FORMAT_S24_PACKED, ///< signed 24 bit integer, packed into 3 bytes (little endian)
+    SAMPLE_FORMAT_S32,        ///< signed 32 bit integer
+    SAMPLE_FORMAT_F32,        ///< 32 bit floating point
+    SAMPLE_FORMAT_F64,        ///< 64 bit floating point
+
+    NUM_SAMPLE_FORMATS,
+};
+
+/**
+ * Rounding modes (used when converting to integer formats)
+ */
+enum rounding_mode_t {
+    ROUNDING_MODE_TRUNCATE, ///< drop the fraction (round toward negative infinity)
+    ROUNDING_MODE_NEAREST,  ///< round to nearest (ties: to even for floating point, upward for integer sources)
+};
+
+/**
+ * Get sample size
+ *
+ * @param format [in] sample format
+ * @returns size of one sample [bytes], or 0 if the format is invalid
+ */
+std::size_t get_sample_size(sample_format_t format) CXXPH_NOEXCEPT;
+
+/**
+ * Convert samples
+ *
+ * @param dest [out] destination samples
+ * @param dest_format [in] format of dest
+ * @param src [in] source samples
+ * @param src_format [in] format of src
+ * @param n [in] number of samples (channels are not distinguished, pass frames * channels)
+ * @param rounding [in] rounding mode
+ * @returns false if one of the formats is invalid
+ */
+bool convert(void *dest, sample_format_t dest_format, const void *src, sample_format_t src_format, std::size_t n,
+             rounding_mode_t rounding = ROUNDING_MODE_NEAREST);
+
+/**
+ * Reverse the byte order of samples
+ *
+ * @param dest [out] destination samples (may be the same as src)
+ * @param src [in] source samples
+ * @param sample_size [in] size of one sample [bytes] (2, 3, 4 or 8)
+ * @param n [in] number of samples
+ * @returns false if sample_size is not supported
+ */
+bool swap_byte_order(void *dest, const void *src, std::size_t sample_size, std::size_t n);
+
+/**
+ * Convert big endian samples to F32
+ *
+ * Same as swap_byte_order() followed by convert(), without the intermediate
+ * buffer. (SAMPLE_FORMAT_S24_PACKED is read as 3 bytes, most significant first)
+ *
+ * @param dest [out] destination samples
+ * @param src [in] source samples (big endian)
+ * @param src_format [in] format of src
+ * @param n [in] number of samples
+ * @returns false if src_format is invalid
+ */
+bool convert_from_big_endian(float *dest, const void *src, sample_format_t src_format, std::size_t n);
+
+/**
+ * Deinterleave channels (interleaved frames -> planar buffers)
+ *
+ * dest[c][i] = src[i * num_channels + c]
+ *
+ * @param dest [out] destination buffers (one per channel, must not overlap src)
+ * @param src [in] interleaved source frames
+ * @param num_channels [in] number of channels
+ * @param num_frames [in] number of frames
+ */
+void deinterleave(float *const *dest, const float *src, std::size_t num_channels, std::size_t num_frames);
+
+/**
+ * Interleave channels (planar buffers -> interleaved frames)
+ *
+ * dest[i * num_channels + c] = src[c][i]
+ *
+ * @param dest [out] destination frames (must not overlap src)
+ * @param src [in] source buffers (one per channel)
+ * @param num_channels [in] number of channels
+ * @param num_frames [in] number of frames
+ */
+void interleave(float *dest, const float *const *src, std::size_t num_channels, std::size_t num_frames);
+
+} // namespace pcm_format
+} // namespace cxxporthelper
+
+#endif // CXXPORTHELPER_PCM_FORMAT_HPP_
@@ -55,11 +55,17 @@ public:
         FEATURE_INDEX_X86_FMA,
         FEATURE_INDEX_X86_MOVBE,
         FEATURE_INDEX_X86_POPCNT,
+        FEATURE_INDEX_X86_F16C, // half-precision conversion
+        FEATURE_INDEX_X86_BMI1, // Bit Manipulation Instruction Set 1 (TZCNT, BLSR, ...)
+        FEATURE_INDEX_X86_BMI2, // Bit Manipulation Instruction Set 2 (PDEP, PEXT, ...)
+        FEATURE_INDEX_X86_LZCNT,
 
         // for ARM (AArch32, AArch64) processors
         FEATURE_INDEX_ARM_V7,
         FEATURE_INDEX_ARM_VFP_V3,
         FEATURE_INDEX_ARM_NEON,
+        FEATURE_INDEX_ARM_FP16,  // half-precision conversion (VFP/NEON)
+        FEATURE_INDEX_ARM_CRC32, // CRC32 instructions (ARMv8)
 
         // num indices
         NUM_FEATURE_INDICES,
@@ -381,6 +387,58 @@ inline CXXPH_OPTIONAL_CONSTEXPR bool support_popcnt() CXXPH_NOEXCEPT { return tr
 inline CXXPH_OPTIONAL_CONSTEXPR bool support_popcnt() CXXPH_NOEXCEPT { return false; }
 #endif
 
+/**
+ * Check whether F16C (x86) instructions are available
+ */
+#if ((CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64))
+#if CXXPH_CONFIG_RUNTIME_FEATURE_CHECK_X86_F16C
+inline bool support_f16c() CXXPH_NOEXCEPT { return check_feature(platform_info_provider::FEATURE_INDEX_X86_F16C); }
+#else
+inline CXXPH_OPTIONAL_CONSTEXPR bool support_f16c() CXXPH_NOEXCEPT { return true; }
+#endif
+#else
+inline CXXPH_OPTIONAL_CONSTEXPR bool support_f16c() CXXPH_NOEXCEPT { return false; }
+#endif
+
+/**
+ * Check whether BMI1 (x86) instructions are available
+ */
+#if ((CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64))
+#if CXXPH_CONFIG_RUNTIME_FEATURE_CHECK_X86_BMI1
+inline bool support_bmi1() CXXPH_NOEXCEPT { return check_feature(platform_info_provider::FEATURE_INDEX_X86_BMI1); }
+#else
+inline CXXPH_OPTIONAL_CONSTEXPR bool support_bmi1() CXXPH_NOEXCEPT { return true; }
+#endif
+#else
+inline CXXPH_OPTIONAL_CONSTEXPR bool support_bmi1() CXXPH_NOEXCEPT { return false; }
+#endif
+
+/**
+ * Check whether BMI2 (x86) instructions are available
+ */
+#if ((CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64))
+#if CXXPH_CONFIG_RUNTIME_FEATURE_CHECK_X86_BMI2
+inline bool support_bmi2() CXXPH_NOEXCEPT { return check_feature(platform_info_provider::FEATURE_INDEX_X86_BMI2); }
+#else
+inline CXXPH_OPTIONAL_CONSTEXPR bool support_bmi2() CXXPH_NOEXCEPT { return true; }
+#endif
+#else
+inline CXXPH_OPTIONAL_CONSTEXPR bool support_bmi2() CXXPH_NOEXCEPT { return false; }
+#endif
+
+/**
+ * Check whether LZCNT (x86) instruction is available
+ */
+#if ((CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64))
+#if CXXPH_CONFIG_RUNTIME_FEATURE_CHECK_X86_LZCNT
+inline bool support_lzcnt() CXXPH_NOEXCEPT { return check_feature(platform_info_provider::FEATURE_INDEX_X86_LZCNT); }
+#else
+inline CXXPH_OPTIONAL_CONSTEXPR bool support_lzcnt() CXXPH_NOEXCEPT { return true; }
+#endif
+#else
+inline CXXPH_OPTIONAL_CONSTEXPR bool support_lzcnt() CXXPH_NOEXCEPT { return false; }
+#endif
+
 /**
  * Check whether ARMv7 (ARM) instructions are available
  */
@@ -423,6 +481,35 @@ inline CXXPH_OPTIONAL_CONSTEXPR bool support_arm_neon() CXXPH_NOEXCEPT { return
 inline CXXPH_OPTIONAL_CONSTEXPR bool support_arm_neon() CXXPH_NOEXCEPT { return false; }
 #endif
 
+/**
+ * Check whether ARM half-precision conversion (ARM) instructions are available
+ */
+#if ((CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM64))
+#if CXXPH_CONFIG_RUNTIME_FEATURE_CHECK_ARM_FP16
+inline bool support_arm_fp16() CXXPH_NOEXCEPT { return check_feature(platform_info_provider::FEATURE_INDEX_ARM_FP16); }
+#else
+inline CXXPH_OPTIONAL_CONSTEXPR bool support_arm_fp16() CXXPH_NOEXCEPT { return true; }
+#endif
+#else
+inline CXXPH_OPTIONAL_CONSTEXPR bool support_arm_fp16() CXXPH_NOEXCEPT { return false; }
+#endif
+
+/**
+ * Check whether ARMv8 CRC32 (ARM) instructions are available
+ */
+#if ((CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM64))
+#if CXXPH_CONFIG_RUNTIME_FEATURE_CHECK_ARM_CRC32
+inline bool support_arm_crc32() CXXPH_NOEXCEPT
+{
+    return check_feature(platform_info_provider::FEATURE_INDEX_ARM_CRC32);
+}
+#else
+inline CXXPH_OPTIONAL_CONSTEXPR bool support_arm_crc32() CXXPH_NOEXCEPT { return true; }
+#endif
+#else
+inline CXXPH_OPTIONAL_CONSTEXPR bool support_arm_crc32() CXXPH_NOEXCEPT { return false; }
+#endif
+
 } // namespace platform_info
 } // namespace cxxporthelper
 
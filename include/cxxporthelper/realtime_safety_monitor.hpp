@@ -0,0 +1,135 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#ifndef CXXPORTHELPER_REALTIME_SAFETY_MONITOR_HPP_
+#define CXXPORTHELPER_REALTIME_SAFETY_MONITOR_HPP_
+
+#include <cxxporthelper/impl/cxxporthelper_config.hpp>
+#include <cxxporthelper/cstdint>
+#include <cxxporthelper/compiler.hpp>
+
+namespace cxxporthelper {
+namespace realtime_safety {
+
+/**
+ * Statistics of a realtime section
+ */
+struct section_report {
+    const char *name;      // section name
+    uint32_t alloc_count;  // number of alloc_aligned() calls
+    uint32_t free_count;   // number of free_aligned() calls
+    uint32_t minor_faults; // number of minor page faults
+    uint32_t major_faults; // number of major page faults
+    bool faults_available; // whether page fault counters are supported on this platform
+
+    bool has_violation() const CXXPH_NOEXCEPT
+    {
+        return (alloc_count != 0) || (free_count != 0) || (minor_faults != 0) || (major_faults != 0);
+    }
+};
+
+/**
+ * Report callback
+ *
+ * Called on the monitored thread when a section with violations is left.
+ */
+typedef void (*report_callback_t)(const section_report &report, void *user_data);
+
+#if CXXPH_CONFIG_ENABLE_REALTIME_SAFETY_MONITOR
+/**
+ * Set the report callback (shared by all threads).
+ *
+ * @param callback [in] callback function, or nullptr to disable reporting
+ * @param user_data [in] user data passed to the callback
+ */
+void set_report_callback(report_callback_t callback, void *user_data) CXXPH_NOEXCEPT;
+
+/**
+ * Mark the beginning of a realtime section on the calling thread.
+ *
+ * Nested sections are accounted to the outermost one.
+ *
+ * @param name [in] section name (must outlive the section)
+ */
+void enter_section(const char *name) CXXPH_NOEXCEPT;
+
+/**
+ * Mark the end of a realtime section on the calling thread.
+ */
+void leave_section() CXXPH_NOEXCEPT;
+
+/**
+ * Check whether the calling thread is in a realtime section.
+ */
+bool in_section() CXXPH_NOEXCEPT;
+
+/**
+ * Get the report of the last section left on the calling thread.
+ *
+ * @param report [out] report
+ * @returns whether a report is available
+ */
+bool get_last_report(section_report *report) CXXPH_NOEXCEPT;
+
+/// @cond INTERNAL_FIELD
+void notify_alloc() CXXPH_NOEXCEPT;
+void notify_free() CXXPH_NOEXCEPT;
+/// @endcond
+#else
+inline void set_report_callback(report_callback_t callback, void *user_data) CXXPH_NOEXCEPT
+{
+    (void)callback;
+    (void)user_data;
+}
+inline void enter_section(const char *name) CXXPH_NOEXCEPT { (void)name; }
+inline void leave_section() CXXPH_NOEXCEPT {}
+inline bool in_section() CXXPH_NOEXCEPT { return false; }
+inline bool get_last_report(section_report *report) CXXPH_NOEXCEPT
+{
+    (void)report;
+    return false;
+}
+inline void notify_alloc() CXXPH_NOEXCEPT {}
+inline void notify_free() CXXPH_NOEXCEPT {}
+#endif
+
+/**
+ * Scoped realtime section
+ */
+class scoped_section {
+    /// @cond INTERNAL_FIELD
+    scoped_section(const scoped_section &) = delete;
+    scoped_section &operator=(const scoped_section &) = delete;
+    /// @endcond
+
+public:
+    /**
+     * Constructor.
+     *
+     * @param name [in] section name (must outlive the section)
+     */
+    explicit scoped_section(const char *name) CXXPH_NOEXCEPT { enter_section(name); }
+
+    /**
+     * Destructor.
+     */
+    ~scoped_section() { leave_section(); }
+};
+
+} // namespace realtime_safety
+} // namespace cxxporthelper
+
+#endif // CXXPORTHELPER_REALTIME_SAFETY_MONITOR_HPP_
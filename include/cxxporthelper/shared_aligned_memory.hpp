@@ -0,0 +1,250 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#ifndef CXXPORTHELPER_SHARED_ALIGNED_MEMORY_HPP_
+#define CXXPORTHELPER_SHARED_ALIGNED_MEMORY_HPP_
+
+#include <cxxporthelper/cstddef>
+#include <cxxporthelper/cstdint>
+#include <cxxporthelper/utility>
+#include <cxxporthelper/compiler.hpp>
+
+namespace cxxporthelper {
+
+/**
+ * Layout descriptor placed at the top of a shared memory block.
+ *
+ * The data area starts at (mapped base address + data_offset) and is aligned to
+ * the alignment specified on creation.
+ */
+struct shared_aligned_memory_header {
+    enum { MAGIC = 0x48505843 /* 'CXPH' */, VERSION = 1 };
+
+    uint32_t magic;
+    uint32_t version;
+    uint32_t header_size;
+    uint32_t alignment;
+    uint64_t element_size;
+    uint64_t num_elements;
+    uint64_t data_offset;
+    uint64_t mapped_size;
+};
+
+/// @cond INTERNAL_FIELD
+class shared_memory_block {
+    shared_memory_block(const shared_memory_block &) = delete;
+    shared_memory_block &operator=(const shared_memory_block &) = delete;
+
+public:
+    shared_memory_block() CXXPH_NOEXCEPT;
+    shared_memory_block(shared_memory_block &&other) CXXPH_NOEXCEPT;
+    ~shared_memory_block();
+
+    shared_memory_block &operator=(shared_memory_block &&other) CXXPH_NOEXCEPT;
+
+    bool create(const char *name, std::size_t element_size, std::size_t num_elements, std::size_t alignment,
+                bool zero_clear) CXXPH_NOEXCEPT;
+    bool open(const char *name, std::size_t element_size, bool read_only) CXXPH_NOEXCEPT;
+    bool attach(int fd, std::size_t element_size, bool read_only) CXXPH_NOEXCEPT;
+    void close() CXXPH_NOEXCEPT;
+
+    static bool unlink(const char *name) CXXPH_NOEXCEPT;
+
+    void *data() const CXXPH_NOEXCEPT { return data_; }
+    const shared_aligned_memory_header *header() const CXXPH_NOEXCEPT { return header_; }
+    std::size_t num_elements() const CXXPH_NOEXCEPT { return num_elements_; }
+    int fd() const CXXPH_NOEXCEPT { return fd_; }
+
+private:
+    bool map(int fd, std::size_t element_size, bool read_only) CXXPH_NOEXCEPT;
+    void swap(shared_memory_block &other) CXXPH_NOEXCEPT;
+
+    int fd_;
+    void *base_;
+    std::size_t mapped_size_;
+    const shared_aligned_memory_header *header_;
+    void *data_;
+    std::size_t num_elements_;
+};
+/// @endcond
+
+/**
+ * Aligned memory block backed by shared memory.
+ *
+ * The block can be mapped by multiple local processes. A named block is
+ * created with shm_open(); an anonymous block is created with memfd_create()
+ * and shared by passing fd() to another process (ex. SCM_RIGHTS).
+ *
+ * @tparam T data type (must be trivially copyable)
+ */
+template <typename T>
+class shared_aligned_memory {
+
+    /// @cond INTERNAL_FIELD
+    shared_aligned_memory(const shared_aligned_memory &) = delete;
+    shared_aligned_memory &operator=(const shared_aligned_memory &) = delete;
+    /// @endcond
+
+public:
+    /**
+     * Data type
+     */
+    typedef T data_type;
+
+    /**
+     * Size type
+     */
+    typedef std::size_t size_type;
+
+    enum { DEFAULT_ALIGNMENT = CXXPH_PLATFORM_CACHE_LINE_SIZE };
+
+    /**
+     * Constructor.
+     */
+    shared_aligned_memory() CXXPH_NOEXCEPT : block_() {}
+
+    /**
+     * Move constructor
+     */
+    shared_aligned_memory(shared_aligned_memory &&other) CXXPH_NOEXCEPT : block_(std::move(other.block_)) {}
+
+    /**
+     * Destructor.
+     */
+    ~shared_aligned_memory() { close(); }
+
+    /**
+     * Create a new shared memory block.
+     *
+     * @param name [in] name of the block (ex. "/my_block"), or nullptr to create an anonymous block
+     * @param size [in] size of the data area (unit: data_type element)
+     * @param alignment [in] memory alignment [bytes] (must not exceed the page size)
+     * @param zero_clear [in] zero filling
+     * @returns whether the block is successfully created
+     */
+    bool create(const char *name, size_type size, std::size_t alignment = DEFAULT_ALIGNMENT,
+                bool zero_clear = true) CXXPH_NOEXCEPT
+    {
+        return block_.create(name, sizeof(T), size, alignment, zero_clear);
+    }
+
+    /**
+     * Open an existing named shared memory block.
+     *
+     * @param name [in] name of the block
+     * @param read_only [in] map the block as read only
+     * @returns whether the block is successfully opened
+     */
+    bool open(const char *name, bool read_only = false) CXXPH_NOEXCEPT
+    {
+        return block_.open(name, sizeof(T), read_only);
+    }
+
+    /**
+     * Attach to a shared memory block via file descriptor.
+     *
+     * @param fd [in] file descriptor (duplicated internally, the caller keeps the ownership)
+     * @param read_only [in] map the block as read only
+     * @returns whether the block is successfully attached
+     */
+    bool attach(int fd, bool read_only = false) CXXPH_NOEXCEPT { return block_.attach(fd, sizeof(T), read_only); }
+
+    /**
+     * Unmap the block.
+     */
+    void close() CXXPH_NOEXCEPT { block_.close(); }
+
+    /**
+     * Remove the name of a shared memory block.
+     *
+     * The block itself is released after all processes unmapped it.
+     *
+     * @param name [in] name of the block
+     * @returns whether the name is successfully removed
+     */
+    static bool unlink(const char *name) CXXPH_NOEXCEPT { return shared_memory_block::unlink(name); }
+
+    /**
+     * Get pointer of the buffer.
+     *
+     * @returns pointer to the mapped data area
+     */
+    /// @{
+    T *get() CXXPH_NOEXCEPT { return static_cast<T *>(block_.data()); }
+
+    const T *get() const CXXPH_NOEXCEPT { return static_cast<const T *>(block_.data()); }
+    /// @}
+
+    /**
+     * Array accessor operator
+     *
+     * @param index [in] index of the buffer  (index >= 0 && index < size())
+     * @returns reference to the buffer item
+     */
+    /// @{
+    T &operator[](int index)CXXPH_NOEXCEPT { return get()[index]; }
+
+    const T &operator[](int index) const CXXPH_NOEXCEPT { return get()[index]; }
+    /// @}
+
+    /**
+     * Get buffer size.
+     *
+     * @returns size of the data area (unit: data_type element)
+     */
+    size_type size() const CXXPH_NOEXCEPT { return block_.num_elements(); }
+
+    /**
+     * Get the layout descriptor.
+     *
+     * @returns pointer to the header of the block, or nullptr if not mapped
+     */
+    const shared_aligned_memory_header *header() const CXXPH_NOEXCEPT { return block_.header(); }
+
+    /**
+     * Get the file descriptor of the block.
+     *
+     * @returns file descriptor, or -1 if not mapped
+     */
+    int fd() const CXXPH_NOEXCEPT { return block_.fd(); }
+
+    /**
+     * 'bool' operator.
+     *
+     * @returns whether the block is mapped
+     */
+    explicit operator bool() const CXXPH_NOEXCEPT { return block_.data() != nullptr; }
+
+    /**
+     * Move operation.
+     */
+    /// @{
+    shared_aligned_memory &operator=(shared_aligned_memory &&other) CXXPH_NOEXCEPT
+    {
+        block_ = std::move(other.block_);
+        return (*this);
+    }
+    /// @}
+
+private:
+    /// @cond INTERNAL_FIELD
+    shared_memory_block block_;
+    /// @endcond
+};
+
+} // namespace cxxporthelper
+
+#endif // CXXPORTHELPER_SHARED_ALIGNED_MEMORY_HPP_
@@ -0,0 +1,257 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#ifndef CXXPORTHELPER_SIMD_HPP_
+#define CXXPORTHELPER_SIMD_HPP_
+
+//
+// Portable SIMD vector types
+//
+//   f32x4, f32x8   : float
+//   i32x4, i32x8   : int32_t
+//   i16x8          : int16_t
+//
+// The types compile down to SSE/AVX or NEON intrinsics depending on the
+// instruction sets enabled for the translation unit, and to plain scalar code
+// on other targets. 8-lane types are emulated by two 4-lane vectors when
+// 256-bit registers are not available.
+//
+// Operations (free functions, found by ADL):
+//   load(), load_aligned(), store(), store_aligned(), zero()  (static / member functions)
+//   store_stream() (member; aligned non-temporal store, plain store on NEON), stream_fence()
+//   + - * / (float), unary -, & | ^ (integer), += -= *=
+//   min(), max(), abs(), sqrt() (float), mul_add(a, b, c) (= a * b + c, fused if available)
+//   rsqrt_estimate(), rcp_estimate() (float; 12 bits on x86, 8 bits on NEON, exact on scalar fallback)
+//   cmp_eq(), cmp_lt(), cmp_le(), cmp_gt(), cmp_ge() -> mask_type, select(mask, a, b), any(mask), all(mask)
+//   shuffle<I0, I1, I2, I3>() (applied to each group of 4 lanes), reverse(), extract<I>()
+//   interleave(a, b, &lo, &hi), deinterleave(a, b, &even, &odd) (float; 2-way zip / unzip)
+//   reduce_add(), reduce_min(), reduce_max()
+//   shl<N>(), sra<N>(), srl<N>() (integer, 1 <= N < bits), add_sat(), sub_sat() (integer)
+//   mul_round_high() (integer; (a * b * 2 + 2^(bits - 1)) >> bits, saturated, = Q15 / Q31 multiply)
+//   reverse_bytes() (integer; byte order of each lane)
+//   to_f32(), to_i32() (truncate), round_to_i32() (nearest), bitcast_f32(), bitcast_i32()
+//   to_i32_lo(), to_i32_hi() (i16x8 -> i32x4), pack_sat() (i32x4, i32x4 -> i16x8)
+//   low(), high(), combine() (8-lane <-> 4-lane)
+//
+// All the types and functions live in an ABI specific namespace (imported by
+// a using-directive), so translation units compiled with different instruction
+// set flags can be linked together without mixing up their inline function
+// instances.
+//
+
+#include <cxxporthelper/compiler.hpp>
+#include <cxxporthelper/cstddef>
+#include <cxxporthelper/cstdint>
+
+//
+// enabled instruction sets
+//
+// NOTE: CXXPH_COMPILER_SUPPORTS_X86_xxx macros are always 1 on Visual Studio
+// (intrinsics are available regardless of the /arch option), so the
+// predefined macros are checked instead.
+//
+#if CXXPH_COMPILER_IS_MSVC && ((CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64))
+#if (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define CXXPH_SIMD_USE_X86_SSE2 1
+#endif
+#if defined(__AVX__)
+#define CXXPH_SIMD_USE_X86_SSSE3 1
+#define CXXPH_SIMD_USE_X86_SSE4_1 1
+#define CXXPH_SIMD_USE_X86_AVX 1
+#endif
+#if defined(__AVX2__)
+#define CXXPH_SIMD_USE_X86_AVX2 1
+#define CXXPH_SIMD_USE_X86_FMA 1
+#define CXXPH_SIMD_USE_X86_F16C 1
+#endif
+#if defined(__AVX512F__)
+#define CXXPH_SIMD_USE_X86_AVX512F 1
+#endif
+#else
+#define CXXPH_SIMD_USE_X86_SSE2 CXXPH_COMPILER_SUPPORTS_X86_SSE2
+#define CXXPH_SIMD_USE_X86_SSSE3 CXXPH_COMPILER_SUPPORTS_X86_SSSE3
+#define CXXPH_SIMD_USE_X86_SSE4_1 CXXPH_COMPILER_SUPPORTS_X86_SSE4_1
+#define CXXPH_SIMD_USE_X86_AVX CXXPH_COMPILER_SUPPORTS_X86_AVX
+#define CXXPH_SIMD_USE_X86_AVX2 CXXPH_COMPILER_SUPPORTS_X86_AVX2
+#define CXXPH_SIMD_USE_X86_FMA CXXPH_COMPILER_SUPPORTS_X86_FMA
+#define CXXPH_SIMD_USE_X86_F16C CXXPH_COMPILER_SUPPORTS_X86_F16C
+#define CXXPH_SIMD_USE_X86_AVX512F CXXPH_COMPILER_SUPPORTS_X86_AVX512F
+#endif
+
+#ifndef CXXPH_SIMD_USE_X86_SSE2
+#define CXXPH_SIMD_USE_X86_SSE2 0
+#endif
+#ifndef CXXPH_SIMD_USE_X86_SSSE3
+#define CXXPH_SIMD_USE_X86_SSSE3 0
+#endif
+#ifndef CXXPH_SIMD_USE_X86_SSE4_1
+#define CXXPH_SIMD_USE_X86_SSE4_1 0
+#endif
+#ifndef CXXPH_SIMD_USE_X86_AVX
+#define CXXPH_SIMD_USE_X86_AVX 0
+#endif
+#ifndef CXXPH_SIMD_USE_X86_AVX2
+#define CXXPH_SIMD_USE_X86_AVX2 0
+#endif
+#ifndef CXXPH_SIMD_USE_X86_FMA
+#define CXXPH_SIMD_USE_X86_FMA 0
+#endif
+#ifndef CXXPH_SIMD_USE_X86_F16C
+#define CXXPH_SIMD_USE_X86_F16C 0
+#endif
+#ifndef CXXPH_SIMD_USE_X86_AVX512F
+#define CXXPH_SIMD_USE_X86_AVX512F 0
+#endif
+
+#define CXXPH_SIMD_USE_ARM_NEON CXXPH_COMPILER_SUPPORTS_ARM_NEON
+#define CXXPH_SIMD_USE_ARM64 (CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM64)
+
+//
+// ABI namespace
+//
+#if CXXPH_SIMD_USE_X86_AVX512F
+#define CXXPH_SIMD_ABI_NAMESPACE abi_x86_avx512f
+#elif CXXPH_SIMD_USE_X86_AVX2 && CXXPH_SIMD_USE_X86_FMA
+#define CXXPH_SIMD_ABI_NAMESPACE abi_x86_avx2_fma
+#elif CXXPH_SIMD_USE_X86_AVX2
+#define CXXPH_SIMD_ABI_NAMESPACE abi_x86_avx2
+#elif CXXPH_SIMD_USE_X86_AVX && CXXPH_SIMD_USE_X86_FMA
+#define CXXPH_SIMD_ABI_NAMESPACE abi_x86_avx_fma
+#elif CXXPH_SIMD_USE_X86_AVX
+#define CXXPH_SIMD_ABI_NAMESPACE abi_x86_avx
+#elif CXXPH_SIMD_USE_X86_SSE4_1
+#define CXXPH_SIMD_ABI_NAMESPACE abi_x86_sse4_1
+#elif CXXPH_SIMD_USE_X86_SSSE3
+#define CXXPH_SIMD_ABI_NAMESPACE abi_x86_ssse3
+#elif CXXPH_SIMD_USE_X86_SSE2
+#define CXXPH_SIMD_ABI_NAMESPACE abi_x86_sse2
+#elif CXXPH_SIMD_USE_ARM_NEON && CXXPH_SIMD_USE_ARM64
+#define CXXPH_SIMD_ABI_NAMESPACE abi_arm64_neon
+#elif CXXPH_SIMD_USE_ARM_NEON
+#define CXXPH_SIMD_ABI_NAMESPACE abi_arm_neon
+#else
+#define CXXPH_SIMD_ABI_NAMESPACE abi_scalar
+#endif
+
+//
+// backend
+//
+#include <cxxporthelper/impl/simd_generic.hpp>
+
+#if CXXPH_SIMD_USE_X86_SSE2
+#include <cxxporthelper/impl/simd_x86.hpp>
+#elif CXXPH_SIMD_USE_ARM_NEON
+#include <cxxporthelper/impl/simd_neon.hpp>
+#endif
+
+namespace cxxporthelper {
+namespace simd {
+namespace CXXPH_SIMD_ABI_NAMESPACE {
+
+#if !(CXXPH_SIMD_USE_X86_SSE2 || CXXPH_SIMD_USE_ARM_NEON)
+// scalar fallback
+typedef basic_vec<float, 4> f32x4;
+typedef basic_vec<int32_t, 4> i32x4;
+typedef basic_vec<int16_t, 8> i16x8;
+#define CXXPH_SIMD_NATIVE_128 0
+#else
+#define CXXPH_SIMD_NATIVE_128 1
+#endif
+
+#if !CXXPH_SIMD_USE_X86_AVX
+typedef vec2x<f32x4> f32x8;
+#define CXXPH_SIMD_NATIVE_F32X8 0
+
+CXXPH_FORCEINLINE f32x8 combine(const f32x4 &lo, const f32x4 &hi) CXXPH_NOEXCEPT { return f32x8(lo, hi); }
+#else
+#define CXXPH_SIMD_NATIVE_F32X8 1
+#endif
+
+#if !CXXPH_SIMD_USE_X86_AVX2
+typedef vec2x<i32x4> i32x8;
+#define CXXPH_SIMD_NATIVE_I32X8 0
+
+CXXPH_FORCEINLINE i32x8 combine(const i32x4 &lo, const i32x4 &hi) CXXPH_NOEXCEPT { return i32x8(lo, hi); }
+#else
+#define CXXPH_SIMD_NATIVE_I32X8 1
+#endif
+
+//
+// conversions between 8-lane vectors
+//
+CXXPH_FORCEINLINE f32x8 to_f32(const i32x8 &a) CXXPH_NOEXCEPT
+{
+#if CXXPH_SIMD_NATIVE_F32X8 && CXXPH_SIMD_NATIVE_I32X8
+    return _mm256_cvtepi32_ps(a.v);
+#else
+    return combine(to_f32(low(a)), to_f32(high(a)));
+#endif
+}
+
+CXXPH_FORCEINLINE i32x8 to_i32(const f32x8 &a) CXXPH_NOEXCEPT
+{
+#if CXXPH_SIMD_NATIVE_F32X8 && CXXPH_SIMD_NATIVE_I32X8
+    return _mm256_cvttps_epi32(a.v);
+#else
+    return combine(to_i32(low(a)), to_i32(high(a)));
+#endif
+}
+
+CXXPH_FORCEINLINE i32x8 round_to_i32(const f32x8 &a) CXXPH_NOEXCEPT
+{
+#if CXXPH_SIMD_NATIVE_F32X8 && CXXPH_SIMD_NATIVE_I32X8
+    return _mm256_cvtps_epi32(a.v);
+#else
+    return combine(round_to_i32(low(a)), round_to_i32(high(a)));
+#endif
+}
+
+CXXPH_FORCEINLINE i32x8 bitcast_i32(const f32x8 &a) CXXPH_NOEXCEPT
+{
+#if CXXPH_SIMD_NATIVE_F32X8 && CXXPH_SIMD_NATIVE_I32X8
+    return _mm256_castps_si256(a.v);
+#else
+    return combine(bitcast_i32(low(a)), bitcast_i32(high(a)));
+#endif
+}
+
+CXXPH_FORCEINLINE f32x8 bitcast_f32(const i32x8 &a) CXXPH_NOEXCEPT
+{
+#if CXXPH_SIMD_NATIVE_F32X8 && CXXPH_SIMD_NATIVE_I32X8
+    return _mm256_castsi256_ps(a.v);
+#else
+    return combine(bitcast_f32(low(a)), bitcast_f32(high(a)));
+#endif
+}
+
+//
+// ordering of non-temporal stores
+//
+CXXPH_FORCEINLINE void stream_fence() CXXPH_NOEXCEPT
+{
+#if CXXPH_SIMD_USE_X86_SSE2
+    _mm_sfence();
+#endif
+}
+
+} // namespace CXXPH_SIMD_ABI_NAMESPACE
+
+using namespace CXXPH_SIMD_ABI_NAMESPACE;
+
+} // namespace simd
+} // namespace cxxporthelper
+
+#endif // CXXPORTHELPER_SIMD_HPP_
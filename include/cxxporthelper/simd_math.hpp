@@ -0,0 +1,387 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#ifndef CXXPORTHELPER_SIMD_MATH_HPP_
+#define CXXPORTHELPER_SIMD_MATH_HPP_
+
+//
+// Vectorized elementary functions for f32x4 / f32x8
+//
+// Polynomial approximations (Cephes single precision coefficients) built on
+// the simd.hpp operations only, so they work with every backend.
+//
+//   function      accuracy (max error, measured against double precision)
+//   ----------------------------------------------------------------------------
+//   exp(x)        2 ulp;     x < -87.336 -> 0 (no denormal results), x > 88.722 -> +inf
+//   log(x)        1 ulp;     x = 0 -> -inf, x < 0 -> NaN, denormals supported
+//   pow(x, y)     exp(y * log(x)): about (2 + 2 * |y * log(x)|) ulp
+//                 x < 0 -> NaN (integer exponents are not special-cased), pow(x, 0) = 1
+//   sin(x)        2^-23 absolute error for |x| <= 8192 (accuracy degrades above)
+//   cos(x)        same as sin(x)
+//   tanh(x)       2 ulp
+//   atan(x)       3 ulp (4 ulp on ARMv7, where the division is approximated)
+//   atan2(y, x)   3 ulp (5 ulp on ARMv7); quadrants and signed zeros as std::atan2()
+//   rsqrt(x)      4 ulp (hardware estimate + Newton-Raphson refinement, one step on
+//                 x86 and two steps on NEON); rsqrt(0) = +inf, rsqrt(+inf) = 0,
+//                 denormals supported
+//
+// NaN inputs give NaN outputs (except pow(NaN, 0) = 1).
+//
+
+#include <cxxporthelper/simd.hpp>
+
+namespace cxxporthelper {
+namespace simd {
+namespace CXXPH_SIMD_ABI_NAMESPACE {
+
+/// @cond INTERNAL_FIELD
+template <typename V>
+struct math_traits;
+
+template <>
+struct math_traits<f32x4> {
+    typedef f32x4 float_type;
+    typedef i32x4 int_type;
+};
+
+template <>
+struct math_traits<f32x8> {
+    typedef f32x8 float_type;
+    typedef i32x8 int_type;
+};
+
+// reinterpret the bit pattern as float
+template <typename V>
+CXXPH_FORCEINLINE V math_const_bits(int32_t bits) CXXPH_NOEXCEPT
+{
+    return bitcast_f32(typename math_traits<V>::int_type(bits));
+}
+
+// (m ? a : b) for each bit
+template <typename V>
+CXXPH_FORCEINLINE V math_select_bits(const typename math_traits<V>::int_type &m, const V &a, const V &b) CXXPH_NOEXCEPT
+{
+    typedef typename math_traits<V>::int_type VI;
+    return bitcast_f32((bitcast_i32(a) & m) | (bitcast_i32(b) & (m ^ VI(-1))));
+}
+
+// x * 2^n (n in [-252, 254]; scaled in two steps to avoid exponent overflow)
+template <typename V>
+CXXPH_FORCEINLINE V math_ldexp(const V &x, const typename math_traits<V>::int_type &n) CXXPH_NOEXCEPT
+{
+    typedef typename math_traits<V>::int_type VI;
+    const VI n1 = sra<1>(n);
+    const VI n2 = n - n1;
+    return (x * bitcast_f32(shl<23>(n1 + VI(127)))) * bitcast_f32(shl<23>(n2 + VI(127)));
+}
+/// @endcond
+
+/**
+ * Exponential function
+ */
+template <typename V>
+CXXPH_FORCEINLINE typename math_traits<V>::float_type exp(const V &x) CXXPH_NOEXCEPT
+{
+    typedef typename math_traits<V>::int_type VI;
+
+    const V hi_limit(88.72283935546875f);  // log(FLT_MAX)
+    const V lo_limit(-87.33654022216797f); // log(FLT_MIN)
+
+    // exp(x) = 2^n * exp(r), |r| <= ln(2) / 2
+    const V xc = min(max(x, lo_limit), hi_limit);
+    const VI n = round_to_i32(xc * V(1.44269504088896341f));
+    const V fn = to_f32(n);
+
+    V r = mul_add(fn, V(-0.693359375f), xc);
+    r = mul_add(fn, V(2.12194440e-4f), r);
+
+    V p(1.9875691500e-4f);
+    p = mul_add(p, r, V(1.3981999507e-3f));
+    p = mul_add(p, r, V(8.3334519073e-3f));
+    p = mul_add(p, r, V(4.1665795894e-2f));
+    p = mul_add(p, r, V(1.6666665459e-1f));
+    p = mul_add(p, r, V(5.0000001201e-1f));
+    p = mul_add(p, r * r, r + V(1.0f));
+
+    V y = math_ldexp(p, n);
+
+    y = select(cmp_lt(x, lo_limit), V::zero(), y);
+    y = select(cmp_gt(x, hi_limit), math_const_bits<V>(0x7f800000), y);
+    y = select(cmp_eq(x, x), y, x);
+
+    return y;
+}
+
+/**
+ * Natural logarithm
+ */
+template <typename V>
+CXXPH_FORCEINLINE typename math_traits<V>::float_type log(const V &x) CXXPH_NOEXCEPT
+{
+    typedef typename math_traits<V>::int_type VI;
+
+    const V inf = math_const_bits<V>(0x7f800000);
+
+    // scale denormals by 2^23
+    const typename V::mask_type is_denormal = cmp_lt(x, V(1.17549435e-38f));
+    const V xs = select(is_denormal, x * V(8388608.0f), x);
+    const VI bits = bitcast_i32(xs);
+
+    // x = m * 2^e, sqrt(1/2) <= m < sqrt(2)
+    V e = to_f32(srl<23>(bits) - VI(126)) - select(is_denormal, V(23.0f), V::zero());
+    V m = bitcast_f32((bits & VI(0x007fffff)) | VI(0x3f000000));
+
+    const typename V::mask_type is_small = cmp_lt(m, V(0.707106781186547524f));
+    e = e - select(is_small, V(1.0f), V::zero());
+    m = (m + select(is_small, m, V::zero())) - V(1.0f);
+
+    const V z = m * m;
+
+    V p(7.0376836292e-2f);
+    p = mul_add(p, m, V(-1.1514610310e-1f));
+    p = mul_add(p, m, V(1.1676998740e-1f));
+    p = mul_add(p, m, V(-1.2420140846e-1f));
+    p = mul_add(p, m, V(1.4249322787e-1f));
+    p = mul_add(p, m, V(-1.6668057665e-1f));
+    p = mul_add(p, m, V(2.0000714765e-1f));
+    p = mul_add(p, m, V(-2.4999993993e-1f));
+    p = mul_add(p, m, V(3.3333331174e-1f));
+
+    V y = p * m * z;
+    y = mul_add(e, V(-2.12194440e-4f), y);
+    y = mul_add(z, V(-0.5f), y);
+    y = m + y;
+    y = mul_add(e, V(0.693359375f), y);
+
+    y = select(cmp_eq(x, inf), inf, y);
+    y = select(cmp_lt(x, V::zero()), math_const_bits<V>(0x7fc00000), y);
+    y = select(cmp_eq(x, V::zero()), -inf, y);
+    y = select(cmp_eq(x, x), y, x);
+
+    return y;
+}
+
+/**
+ * Power function (x >= 0)
+ */
+template <typename V>
+CXXPH_FORCEINLINE typename math_traits<V>::float_type pow(const V &x, const V &y) CXXPH_NOEXCEPT
+{
+    const V r = exp(y * log(x));
+    return select(cmp_eq(y, V::zero()) | cmp_eq(x, V(1.0f)), V(1.0f), r);
+}
+
+/**
+ * Sine and cosine
+ */
+template <typename V>
+CXXPH_FORCEINLINE void sincos(const V &x, typename math_traits<V>::float_type *s,
+                              typename math_traits<V>::float_type *c) CXXPH_NOEXCEPT
+{
+    typedef typename math_traits<V>::int_type VI;
+
+    const V ax = abs(x);
+
+    // octant: j = (|x| * 4 / pi) rounded up to even
+    VI j = to_i32(ax * V(1.27323954473516f));
+    j = (j + VI(1)) & VI(~1);
+    const V fj = to_f32(j);
+
+    // use the cosine polynomial for sin() (and vice versa) if (j & 2) != 0
+    const VI sign_bit(-2147483647 - 1);
+    const VI poly_mask = sra<31>(shl<30>(j));
+    const VI sign_sin = (bitcast_i32(x) ^ shl<29>(j)) & sign_bit;
+    const VI sign_cos = (shl<29>(j - VI(2)) ^ sign_bit) & sign_bit;
+
+    // extended precision modular arithmetic (r = |x| - j * pi / 4)
+    V r = mul_add(fj, V(-0.78515625f), ax);
+    r = mul_add(fj, V(-2.4187564849853515625e-4f), r);
+    r = mul_add(fj, V(-3.77489497744594108e-8f), r);
+
+    const V z = r * r;
+
+    V pc(2.443315711809948e-5f);
+    pc = mul_add(pc, z, V(-1.388731625493765e-3f));
+    pc = mul_add(pc, z, V(4.166664568298827e-2f));
+    pc = mul_add(pc * z, z, mul_add(z, V(-0.5f), V(1.0f)));
+
+    V ps(-1.9515295891e-4f);
+    ps = mul_add(ps, z, V(8.3321608736e-3f));
+    ps = mul_add(ps, z, V(-1.6666654611e-1f));
+    ps = mul_add(ps * z, r, r);
+
+    (*s) = bitcast_f32(bitcast_i32(math_select_bits(poly_mask, pc, ps)) ^ sign_sin);
+    (*c) = bitcast_f32(bitcast_i32(math_select_bits(poly_mask, ps, pc)) ^ sign_cos);
+}
+
+/**
+ * Sine
+ */
+template <typename V>
+CXXPH_FORCEINLINE typename math_traits<V>::float_type sin(const V &x) CXXPH_NOEXCEPT
+{
+    V s, c;
+    sincos(x, &s, &c);
+    return s;
+}
+
+/**
+ * Cosine
+ */
+template <typename V>
+CXXPH_FORCEINLINE typename math_traits<V>::float_type cos(const V &x) CXXPH_NOEXCEPT
+{
+    V s, c;
+    sincos(x, &s, &c);
+    return c;
+}
+
+/**
+ * Hyperbolic tangent
+ */
+template <typename V>
+CXXPH_FORCEINLINE typename math_traits<V>::float_type tanh(const V &x) CXXPH_NOEXCEPT
+{
+    typedef typename math_traits<V>::int_type VI;
+
+    const V ax = abs(x);
+
+    // |x| < 0.625: odd polynomial
+    const V z = x * x;
+    V p(-5.70498872745e-3f);
+    p = mul_add(p, z, V(2.06390887954e-2f));
+    p = mul_add(p, z, V(-5.37397155531e-2f));
+    p = mul_add(p, z, V(1.33314422036e-1f));
+    p = mul_add(p, z, V(-3.33332819422e-1f));
+    p = mul_add(p * z, x, x);
+
+    // otherwise: 1 - 2 / (exp(2|x|) + 1), with the sign of x
+    // (tanh(9) rounds to 1, clamped to keep the divisor finite)
+    const V ac = min(ax, V(9.0f));
+    const V t = V(1.0f) - V(2.0f) / (exp(ac + ac) + V(1.0f));
+    const V q = bitcast_f32(bitcast_i32(t) | (bitcast_i32(x) & VI(-2147483647 - 1)));
+
+    const V y = select(cmp_lt(ax, V(0.625f)), p, q);
+    return select(cmp_eq(x, x), y, x);
+}
+
+/// @cond INTERNAL_FIELD
+// atan(t) for t in [0, 1]
+template <typename V>
+CXXPH_FORCEINLINE V math_atan_unit(const V &t) CXXPH_NOEXCEPT
+{
+    // t > tan(pi / 8): atan(t) = pi / 4 + atan((t - 1) / (t + 1))
+    const typename V::mask_type mid = cmp_gt(t, V(0.4142135623730950f));
+    const V u = select(mid, (t - V(1.0f)) / (t + V(1.0f)), t);
+    const V y0 = select(mid, V(0.78539816339744830962f), V::zero());
+
+    const V z = u * u;
+    V p(8.05374449538e-2f);
+    p = mul_add(p, z, V(-1.38776856032e-1f));
+    p = mul_add(p, z, V(1.99777106478e-1f));
+    p = mul_add(p, z, V(-3.33329491539e-1f));
+    p = mul_add(p * z, u, u);
+
+    return y0 + p;
+}
+/// @endcond
+
+/**
+ * Arc tangent
+ */
+template <typename V>
+CXXPH_FORCEINLINE typename math_traits<V>::float_type atan(const V &x) CXXPH_NOEXCEPT
+{
+    typedef typename math_traits<V>::int_type VI;
+
+    // |x| > 1: atan(|x|) = pi / 2 - atan(1 / |x|)
+    // (the divisor is clamped, the approximated division of ARMv7 does not handle inf)
+    const V ax = abs(x);
+    const typename V::mask_type inv = cmp_gt(ax, V(1.0f));
+    const V r = math_atan_unit(select(inv, V(1.0f) / min(ax, V(1.0e30f)), ax));
+    const V y = select(inv, V(1.57079632679489661923f) - r, r);
+
+    return bitcast_f32(bitcast_i32(y) | (bitcast_i32(x) & VI(-2147483647 - 1)));
+}
+
+/**
+ * Arc tangent of y / x (quadrant aware, same as std::atan2())
+ */
+template <typename V>
+CXXPH_FORCEINLINE typename math_traits<V>::float_type atan2(const V &y, const V &x) CXXPH_NOEXCEPT
+{
+    typedef typename math_traits<V>::int_type VI;
+
+    const VI sign_bit(-2147483647 - 1);
+    const V ax = abs(x);
+    const V ay = abs(y);
+    const V num = min(ax, ay);
+    const V den = max(ax, ay);
+
+    // atan2(0, 0) and atan2(inf, inf) are defined by the signs only
+    V t = num / den;
+    t = select(cmp_eq(den, math_const_bits<V>(0x7f800000)), V::zero(), t);
+    t = select(cmp_eq(num, den), V(1.0f), t);
+    t = select(cmp_eq(den, V::zero()), V::zero(), t);
+
+    V r = math_atan_unit(t);
+    r = select(cmp_gt(ay, ax), V(1.57079632679489661923f) - r, r);
+    r = math_select_bits(sra<31>(bitcast_i32(x)), V(3.14159265358979323846f) - r, r);
+    r = bitcast_f32(bitcast_i32(r) | (bitcast_i32(y) & sign_bit));
+
+    return select(cmp_eq(x, x) & cmp_eq(y, y), r, x + y);
+}
+
+/**
+ * Reciprocal square root
+ */
+template <typename V>
+CXXPH_FORCEINLINE typename math_traits<V>::float_type rsqrt(const V &x) CXXPH_NOEXCEPT
+{
+#if CXXPH_SIMD_USE_X86_SSE2 || CXXPH_SIMD_USE_ARM_NEON
+    typedef typename math_traits<V>::int_type VI;
+
+    // the estimate instructions treat denormals as 0, so they are converted to
+    // normal numbers in the integer domain (x = 2m * 2^-150, also works with flush-to-zero):
+    // rsqrt(x) = rsqrt(2m) * 2^75
+    const VI bits = bitcast_i32(x);
+    const typename V::mask_type is_denormal = cmp_lt(abs(x), V(1.17549435e-38f));
+    const V xd = bitcast_f32(bitcast_i32(to_f32(shl<1>(bits & VI(0x7fffffff)))) | (bits & VI(-2147483647 - 1)));
+    const V xs = select(is_denormal, xd, x);
+
+    V e = rsqrt_estimate(xs);
+
+    // Newton-Raphson step: e' = e + (e / 2) * (1 - x * e^2)
+#if CXXPH_SIMD_USE_ARM_NEON
+    // NEON estimate has only 8 bits precision
+    e = mul_add(e * V(0.5f), mul_add(-(xs * e), e, V(1.0f)), e);
+#endif
+    e = mul_add(e * V(0.5f), mul_add(-(xs * e), e, V(1.0f)), e);
+    e = select(cmp_eq(xs, V::zero()), math_const_bits<V>(0x7f800000), e);
+    e = select(cmp_eq(xs, math_const_bits<V>(0x7f800000)), V::zero(), e);
+    e = select(is_denormal, e * math_const_bits<V>(0x65000000), e);
+#else
+    V e = rsqrt_estimate(x);
+#endif
+
+    return e;
+}
+
+} // namespace CXXPH_SIMD_ABI_NAMESPACE
+} // namespace simd
+} // namespace cxxporthelper
+
+#endif // CXXPORTHELPER_SIMD_MATH_HPP_
@@ -0,0 +1,256 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#ifndef CXXPORTHELPER_SPLIT_COMPLEX_ARRAY_HPP_
+#define CXXPORTHELPER_SPLIT_COMPLEX_ARRAY_HPP_
+
+#include <cxxporthelper/compiler.hpp>
+#include <cxxporthelper/cstddef>
+#include <cxxporthelper/utility>
+#include <cxxporthelper/complex>
+#include <cxxporthelper/aligned_memory.hpp>
+
+namespace cxxporthelper {
+
+/**
+ * Pointers to split complex data (separate real and imaginary planes).
+ *
+ * @tparam T data type (use 'const float' for read-only data)
+ */
+template <typename T>
+struct split_complex {
+    /**
+     * Pointer to the real parts
+     */
+    T *real;
+
+    /**
+     * Pointer to the imaginary parts
+     */
+    T *imag;
+
+    /**
+     * Constructor.
+     */
+    split_complex() CXXPH_NOEXCEPT : real(nullptr), imag(nullptr) {}
+
+    /**
+     * Constructor.
+     *
+     * @param real_ [in] pointer to the real parts
+     * @param imag_ [in] pointer to the imaginary parts
+     */
+    split_complex(T *real_, T *imag_) CXXPH_NOEXCEPT : real(real_), imag(imag_) {}
+
+    /**
+     * Converting constructor (ex. split_complex<float> -> split_complex<const float>)
+     */
+    template <typename U>
+    split_complex(const split_complex<U> &other) CXXPH_NOEXCEPT : real(other.real), imag(other.imag)
+    {
+    }
+
+    /**
+     * Get pointers offset by the specified number of elements.
+     *
+     * @param n [in] number of elements
+     * @returns offset pointers
+     */
+    split_complex offset(std::ptrdiff_t n) const CXXPH_NOEXCEPT { return split_complex(real + n, imag + n); }
+};
+
+/**
+ * Split complex array (aligned real and imaginary planes).
+ *
+ * SIMD complex arithmetic on this layout needs no shuffles, see
+ * complex_math.hpp for the kernels and the conversion from / to
+ * interleaved std::complex arrays.
+ *
+ * @tparam T data type
+ */
+template <typename T>
+class split_complex_array {
+
+    /// @cond INTERNAL_FIELD
+    split_complex_array(const split_complex_array &) = delete;
+    split_complex_array &operator=(const split_complex_array &) = delete;
+    /// @endcond
+
+public:
+    /**
+     * Data type
+     */
+    typedef T data_type;
+
+    /**
+     * Size type
+     */
+    typedef std::size_t size_type;
+
+    enum { DEFAULT_ALIGNMENT = aligned_memory<T>::DEFAULT_ALIGNMENT };
+
+    /**
+     * Constructor.
+     */
+    split_complex_array() CXXPH_NOEXCEPT : real_(), imag_() {}
+
+    /**
+     * Constructor.
+     *
+     * @param size [in] number of complex elements
+     * @param alignment [in] memory alignment of each plane [bytes]
+     * @param zero_clear [in] zero filling
+     */
+    split_complex_array(size_type size, std::size_t alignment = DEFAULT_ALIGNMENT, bool zero_clear = true)
+        : real_(), imag_()
+    {
+        allocate(size, alignment, zero_clear);
+    }
+
+    /**
+     * Move constructor
+     */
+    split_complex_array(split_complex_array &&other) CXXPH_NOEXCEPT : real_(std::move(other.real_)),
+                                                                      imag_(std::move(other.imag_))
+    {
+    }
+
+    /**
+     * Allocate memory
+     *
+     * @param size [in] number of complex elements
+     * @param alignment [in] memory alignment of each plane [bytes]
+     * @param zero_clear [in] zero filling
+     */
+    void allocate(size_type size, std::size_t alignment = DEFAULT_ALIGNMENT, bool zero_clear = true)
+    {
+        // free current allocated memory
+        free();
+
+        aligned_memory<T> real(size, alignment, zero_clear);
+        aligned_memory<T> imag(size, alignment, zero_clear);
+
+        // update fields
+        real_ = std::move(real);
+        imag_ = std::move(imag);
+    }
+
+    /**
+     * Free allocated memory.
+     */
+    void free() CXXPH_NOEXCEPT
+    {
+        real_.free();
+        imag_.free();
+    }
+
+    /**
+     * Get pointer of the real plane.
+     *
+     * @returns pointer to the real parts
+     */
+    /// @{
+    T *real() CXXPH_NOEXCEPT { return real_.get(); }
+
+    const T *real() const CXXPH_NOEXCEPT { return real_.get(); }
+    /// @}
+
+    /**
+     * Get pointer of the imaginary plane.
+     *
+     * @returns pointer to the imaginary parts
+     */
+    /// @{
+    T *imag() CXXPH_NOEXCEPT { return imag_.get(); }
+
+    const T *imag() const CXXPH_NOEXCEPT { return imag_.get(); }
+    /// @}
+
+    /**
+     * Get pointers of both planes.
+     *
+     * @returns pointers to the real and imaginary parts
+     */
+    /// @{
+    split_complex<T> data() CXXPH_NOEXCEPT { return split_complex<T>(real_.get(), imag_.get()); }
+
+    split_complex<const T> data() const CXXPH_NOEXCEPT { return split_complex<const T>(real_.get(), imag_.get()); }
+    /// @}
+
+    /**
+     * Get an element.
+     *
+     * @param index [in] index of the element (index >= 0 && index < size())
+     * @returns complex value
+     */
+    std::complex<T> get(size_type index) const CXXPH_NOEXCEPT
+    {
+        return std::complex<T>(real_.get()[index], imag_.get()[index]);
+    }
+
+    /**
+     * Set an element.
+     *
+     * @param index [in] index of the element (index >= 0 && index < size())
+     * @param value [in] complex value
+     */
+    void set(size_type index, const std::complex<T> &value) CXXPH_NOEXCEPT
+    {
+        real_.get()[index] = value.real();
+        imag_.get()[index] = value.imag();
+    }
+
+    /**
+     * Get array size.
+     *
+     * @returns number of complex elements
+     */
+    size_type size() const CXXPH_NOEXCEPT { return real_.size(); }
+
+    /**
+     * 'bool' operator.
+     *
+     * @returns whether the array is allocated
+     */
+    explicit operator bool() const CXXPH_NOEXCEPT { return static_cast<bool>(real_); }
+
+    /**
+     * Move operation.
+     */
+    /// @{
+    split_complex_array &operator=(split_complex_array &&other) CXXPH_NOEXCEPT
+    {
+        if (this == &other) {
+            return (*this);
+        }
+
+        real_ = std::move(other.real_);
+        imag_ = std::move(other.imag_);
+
+        return (*this);
+    }
+    /// @}
+
+private:
+    /// @cond INTERNAL_FIELD
+    aligned_memory<T> real_;
+    aligned_memory<T> imag_;
+    /// @endcond
+};
+
+} // namespace cxxporthelper
+
+#endif // CXXPORTHELPER_SPLIT_COMPLEX_ARRAY_HPP_
@@ -0,0 +1,99 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#ifndef CXXPORTHELPER_VECTOR_MATH_HPP_
+#define CXXPORTHELPER_VECTOR_MATH_HPP_
+
+//
+// Array-wise elementary functions
+//
+// dest[i] = f(src[i]) for i in [0, n), computed with the approximations of
+// simd_math.hpp (see there for the accuracy) by the best kernel build for the
+// CPU. The arrays do not have to be aligned, and dest may be the same as src
+// (but must not partially overlap).
+//
+
+#include <cxxporthelper/compiler.hpp>
+#include <cxxporthelper/cstddef>
+
+namespace cxxporthelper {
+namespace vector_math {
+
+/**
+ * dest[i] = exp(src[i])
+ */
+void exp(float *dest, const float *src, std::size_t n);
+
+/**
+ * dest[i] = log(src[i])
+ */
+void log(float *dest, const float *src, std::size_t n);
+
+/// @cond INTERNAL_FIELD
+void pow_array_exponent(float *dest, const float *base, const float *exponent, std::size_t n);
+void pow_scalar_exponent(float *dest, const float *base, float exponent, std::size_t n);
+/// @endcond
+
+/**
+ * dest[i] = pow(base[i], exponent[i]) (base[i] >= 0)
+ */
+inline void pow(float *dest, const float *base, const float *exponent, std::size_t n)
+{
+    pow_array_exponent(dest, base, exponent, n);
+}
+
+/**
+ * dest[i] = pow(base[i], exponent) (base[i] >= 0)
+ */
+inline void pow(float *dest, const float *base, float exponent, std::size_t n)
+{
+    pow_scalar_exponent(dest, base, exponent, n);
+}
+
+/**
+ * dest[i] = sin(src[i])
+ */
+void sin(float *dest, const float *src, std::size_t n);
+
+/**
+ * dest[i] = cos(src[i])
+ */
+void cos(float *dest, const float *src, std::size_t n);
+
+/**
+ * dest_sin[i] = sin(src[i]), dest_cos[i] = cos(src[i])
+ */
+void sincos(float *dest_sin, float *dest_cos, const float *src, std::size_t n);
+
+/**
+ * dest[i] = tanh(src[i])
+ */
+void tanh(float *dest, const float *src, std::size_t n);
+
+/**
+ * dest[i] = sqrt(src[i]) (correctly rounded, except on ARMv7)
+ */
+void sqrt(float *dest, const float *src, std::size_t n);
+
+/**
+ * dest[i] = 1 / sqrt(src[i])
+ */
+void rsqrt(float *dest, const float *src, std::size_t n);
+
+} // namespace vector_math
+} // namespace cxxporthelper
+
+#endif // CXXPORTHELPER_VECTOR_MATH_HPP_
@@ -42,6 +42,17 @@ namespace x86intrinsics {
 //
 // load & store operators
 //
+// Store policies provide fence(), which has to be called after a series of
+// store() calls. It is a no-op except for the non-temporal (stream) stores.
+//
+
+/**
+ * Make non-temporal (stream) stores globally visible.
+ */
+#if CXXPH_COMPILER_SUPPORTS_X86_SSE
+inline void stream_store_fence() { _mm_sfence(); }
+#endif
+
 #if CXXPH_COMPILER_SUPPORTS_X86_SSE
 struct sse_m128_load_aligned {
     static __m128 load(const float *mem_addr) { return _mm_load_ps(mem_addr); }
@@ -53,10 +64,17 @@ struct sse_m128_load_unaligned {
 
 struct sse_m128_store_aligned {
     static void store(float *mem_addr, const __m128 &a) { _mm_store_ps(mem_addr, a); }
+    static void fence() {}
 };
 
 struct sse_m128_store_unaligned {
     static void store(float *mem_addr, const __m128 &a) { _mm_storeu_ps(mem_addr, a); }
+    static void fence() {}
+};
+
+struct sse_m128_store_stream {
+    static void store(float *mem_addr, const __m128 &a) { _mm_stream_ps(mem_addr, a); }
+    static void fence() { _mm_sfence(); }
 };
 #endif
 
@@ -71,10 +89,17 @@ struct sse2_m128d_load_unaligned {
 
 struct sse2_m128d_store_aligned {
     static void store(double *mem_addr, const __m128d &a) { _mm_store_pd(mem_addr, a); }
+    static void fence() {}
 };
 
 struct sse2_m128d_store_unaligned {
     static void store(double *mem_addr, const __m128d &a) { _mm_storeu_pd(mem_addr, a); }
+    static void fence() {}
+};
+
+struct sse2_m128d_store_stream {
+    static void store(double *mem_addr, const __m128d &a) { _mm_stream_pd(mem_addr, a); }
+    static void fence() { _mm_sfence(); }
 };
 
 struct sse2_m128i_load_aligned {
@@ -87,10 +112,17 @@ struct sse2_m128i_load_unaligned {
 
 struct sse2_m128i_store_aligned {
     static void store(__m128i *mem_addr, const __m128i &a) { _mm_store_si128(mem_addr, a); }
+    static void fence() {}
 };
 
 struct sse2_m128i_store_unaligned {
     static void store(__m128i *mem_addr, const __m128i &a) { _mm_storeu_si128(mem_addr, a); }
+    static void fence() {}
+};
+
+struct sse2_m128i_store_stream {
+    static void store(__m128i *mem_addr, const __m128i &a) { _mm_stream_si128(mem_addr, a); }
+    static void fence() { _mm_sfence(); }
 };
 #endif
 
@@ -100,6 +132,171 @@ struct sse3_m128i_load_unaligned {
 };
 #endif
 
+#if CXXPH_COMPILER_SUPPORTS_X86_SSE4_1
+// NOTE: non-temporal hint is effective only for write-combining memory
+struct sse4_1_m128i_load_stream {
+    static __m128i load(const __m128i *mem_addr) { return _mm_stream_load_si128(const_cast<__m128i *>(mem_addr)); }
+};
+#endif
+
+#if CXXPH_COMPILER_SUPPORTS_X86_AVX
+struct avx_m256_load_aligned {
+    static __m256 load(const float *mem_addr) { return _mm256_load_ps(mem_addr); }
+};
+
+struct avx_m256_load_unaligned {
+    static __m256 load(const float *mem_addr) { return _mm256_loadu_ps(mem_addr); }
+};
+
+struct avx_m256_store_aligned {
+    static void store(float *mem_addr, const __m256 &a) { _mm256_store_ps(mem_addr, a); }
+    static void fence() {}
+};
+
+struct avx_m256_store_unaligned {
+    static void store(float *mem_addr, const __m256 &a) { _mm256_storeu_ps(mem_addr, a); }
+    static void fence() {}
+};
+
+struct avx_m256_store_stream {
+    static void store(float *mem_addr, const __m256 &a) { _mm256_stream_ps(mem_addr, a); }
+    static void fence() { _mm_sfence(); }
+};
+
+struct avx_m256d_load_aligned {
+    static __m256d load(const double *mem_addr) { return _mm256_load_pd(mem_addr); }
+};
+
+struct avx_m256d_load_unaligned {
+    static __m256d load(const double *mem_addr) { return _mm256_loadu_pd(mem_addr); }
+};
+
+struct avx_m256d_store_aligned {
+    static void store(double *mem_addr, const __m256d &a) { _mm256_store_pd(mem_addr, a); }
+    static void fence() {}
+};
+
+struct avx_m256d_store_unaligned {
+    static void store(double *mem_addr, const __m256d &a) { _mm256_storeu_pd(mem_addr, a); }
+    static void fence() {}
+};
+
+struct avx_m256d_store_stream {
+    static void store(double *mem_addr, const __m256d &a) { _mm256_stream_pd(mem_addr, a); }
+    static void fence() { _mm_sfence(); }
+};
+
+struct avx_m256i_load_aligned {
+    static __m256i load(const __m256i *mem_addr) { return _mm256_load_si256(mem_addr); }
+};
+
+struct avx_m256i_load_unaligned {
+    static __m256i load(const __m256i *mem_addr) { return _mm256_loadu_si256(mem_addr); }
+};
+
+struct avx_m256i_store_aligned {
+    static void store(__m256i *mem_addr, const __m256i &a) { _mm256_store_si256(mem_addr, a); }
+    static void fence() {}
+};
+
+struct avx_m256i_store_unaligned {
+    static void store(__m256i *mem_addr, const __m256i &a) { _mm256_storeu_si256(mem_addr, a); }
+    static void fence() {}
+};
+
+struct avx_m256i_store_stream {
+    static void store(__m256i *mem_addr, const __m256i &a) { _mm256_stream_si256(mem_addr, a); }
+    static void fence() { _mm_sfence(); }
+};
+
+struct avx_m256i_load_unaligned_lddqu {
+    static __m256i load(const __m256i *mem_addr) { return _mm256_lddqu_si256(mem_addr); }
+};
+#endif
+
+#if CXXPH_COMPILER_SUPPORTS_X86_AVX2
+// NOTE: non-temporal hint is effective only for write-combining memory
+struct avx2_m256i_load_stream {
+    static __m256i load(const __m256i *mem_addr) { return _mm256_stream_load_si256(const_cast<__m256i *>(mem_addr)); }
+};
+#endif
+
+#if CXXPH_COMPILER_SUPPORTS_X86_AVX512F
+struct avx512f_m512_load_aligned {
+    static __m512 load(const float *mem_addr) { return _mm512_load_ps(mem_addr); }
+};
+
+struct avx512f_m512_load_unaligned {
+    static __m512 load(const float *mem_addr) { return _mm512_loadu_ps(mem_addr); }
+};
+
+struct avx512f_m512_store_aligned {
+    static void store(float *mem_addr, const __m512 &a) { _mm512_store_ps(mem_addr, a); }
+    static void fence() {}
+};
+
+struct avx512f_m512_store_unaligned {
+    static void store(float *mem_addr, const __m512 &a) { _mm512_storeu_ps(mem_addr, a); }
+    static void fence() {}
+};
+
+struct avx512f_m512_store_stream {
+    static void store(float *mem_addr, const __m512 &a) { _mm512_stream_ps(mem_addr, a); }
+    static void fence() { _mm_sfence(); }
+};
+
+struct avx512f_m512d_load_aligned {
+    static __m512d load(const double *mem_addr) { return _mm512_load_pd(mem_addr); }
+};
+
+struct avx512f_m512d_load_unaligned {
+    static __m512d load(const double *mem_addr) { return _mm512_loadu_pd(mem_addr); }
+};
+
+struct avx512f_m512d_store_aligned {
+    static void store(double *mem_addr, const __m512d &a) { _mm512_store_pd(mem_addr, a); }
+    static void fence() {}
+};
+
+struct avx512f_m512d_store_unaligned {
+    static void store(double *mem_addr, const __m512d &a) { _mm512_storeu_pd(mem_addr, a); }
+    static void fence() {}
+};
+
+struct avx512f_m512d_store_stream {
+    static void store(double *mem_addr, const __m512d &a) { _mm512_stream_pd(mem_addr, a); }
+    static void fence() { _mm_sfence(); }
+};
+
+struct avx512f_m512i_load_aligned {
+    static __m512i load(const __m512i *mem_addr) { return _mm512_load_si512(mem_addr); }
+};
+
+struct avx512f_m512i_load_unaligned {
+    static __m512i load(const __m512i *mem_addr) { return _mm512_loadu_si512(mem_addr); }
+};
+
+struct avx512f_m512i_store_aligned {
+    static void store(__m512i *mem_addr, const __m512i &a) { _mm512_store_si512(mem_addr, a); }
+    static void fence() {}
+};
+
+struct avx512f_m512i_store_unaligned {
+    static void store(__m512i *mem_addr, const __m512i &a) { _mm512_storeu_si512(mem_addr, a); }
+    static void fence() {}
+};
+
+struct avx512f_m512i_store_stream {
+    static void store(__m512i *mem_addr, const __m512i &a) { _mm512_stream_si512(mem_addr, a); }
+    static void fence() { _mm_sfence(); }
+};
+
+// NOTE: non-temporal hint is effective only for write-combining memory
+struct avx512f_m512i_load_stream {
+    static __m512i load(const __m512i *mem_addr) { return _mm512_stream_load_si512(const_cast<__m512i *>(mem_addr)); }
+};
+#endif
+
 } // namespace x86intrinsics
 } // namespace cxxporthelper
 
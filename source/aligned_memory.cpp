@@ -20,6 +20,8 @@
 #include <cstring>
 
 #include <cxxporthelper/cstdint>
+#include <cxxporthelper/aligned_memory_ops.hpp>
+#include <cxxporthelper/realtime_safety_monitor.hpp>
 
 namespace cxxporthelper {
 
@@ -35,6 +37,8 @@ void *aligned_memory_static_impl::alloc_aligned(std::size_t size, std::size_t al
     // check alignment size
     assert(is_pow_of_two(alignment));
 
+    realtime_safety::notify_alloc();
+
     const size_t ptr_size = sizeof(void *);
     const size_t actual_alignment = (alignment > ptr_size) ? alignment : ptr_size;
     const size_t actual_alloc_size = size + (actual_alignment - 1) + ptr_size;
@@ -45,15 +49,19 @@ void *aligned_memory_static_impl::alloc_aligned(std::size_t size, std::size_t al
     if (!ptr)
         return nullptr;
 
-    if (zero_clear) {
-        ::memset(ptr, 0, actual_alloc_size);
-    }
-
     uintptr_t ptr_addr = reinterpret_cast<uintptr_t>(ptr);
 
     uintptr_t aligned_addr = (ptr_addr + actual_alignment) & ~(actual_alignment - 1);
     void *aligned_ptr = reinterpret_cast<void *>(aligned_addr);
 
+    if (zero_clear) {
+        if (actual_alignment >= aligned_memory_ops::REQUIRED_ALIGNMENT) {
+            aligned_memory_ops::zero(aligned_ptr, size);
+        } else {
+            ::memset(aligned_ptr, 0, size);
+        }
+    }
+
     // store original allocated address
     static_cast<void **>(aligned_ptr)[-1] = ptr;
 
@@ -63,6 +71,8 @@ void *aligned_memory_static_impl::alloc_aligned(std::size_t size, std::size_t al
 void aligned_memory_static_impl::free_aligned(void *ptr) CXXPH_NOEXCEPT
 {
     if (ptr) {
+        realtime_safety::notify_free();
+
         // obtain original allocated address
         void *allocated_ptr = static_cast<void **>(ptr)[-1];
 
@@ -0,0 +1,58 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include <cxxporthelper/aligned_memory_ops.hpp>
+
+#include <cxxporthelper/dispatch.hpp>
+#include <cxxporthelper/impl/kernel_isa.hpp>
+
+namespace cxxporthelper {
+namespace aligned_memory_ops {
+
+typedef void (*fill_func_t)(void *, int, std::size_t);
+typedef void (*copy_func_t)(void *, const void *, std::size_t);
+
+CXXPH_KERNEL_DECLARE_VARIANTS(void, fill_kernel, (void *dest, int value, std::size_t size))
+CXXPH_KERNEL_DECLARE_VARIANTS(void, copy_kernel, (void *dest, const void *src, std::size_t size))
+CXXPH_KERNEL_DECLARE_VARIANTS(void, move_kernel, (void *dest, const void *src, std::size_t size))
+
+static const dispatch::kernel_variant<fill_func_t> fill_variants[] = {
+    CXXPH_KERNEL_VARIANT_TABLE_ENTRIES(fill_kernel)
+};
+
+static const dispatch::kernel_variant<copy_func_t> copy_variants[] = {
+    CXXPH_KERNEL_VARIANT_TABLE_ENTRIES(copy_kernel)
+};
+
+static const dispatch::kernel_variant<copy_func_t> move_variants[] = {
+    CXXPH_KERNEL_VARIANT_TABLE_ENTRIES(move_kernel)
+};
+
+CXXPH_DISPATCH_DEFINE_FUNCTION(void, fill, (void *dest, int value, std::size_t size), (dest, value, size),
+                               fill_variants)
+
+CXXPH_DISPATCH_DEFINE_FUNCTION(void, copy, (void *dest, const void *src, std::size_t size), (dest, src, size),
+                               copy_variants)
+
+CXXPH_DISPATCH_DEFINE_FUNCTION(void, move, (void *dest, const void *src, std::size_t size), (dest, src, size),
+                               move_variants)
+
+std::size_t get_libc_threshold() CXXPH_NOEXCEPT { return CXXPH_CONFIG_ALIGNED_MEMORY_OPS_LIBC_THRESHOLD; }
+
+std::size_t get_non_temporal_store_threshold() CXXPH_NOEXCEPT { return CXXPH_CONFIG_NON_TEMPORAL_STORE_THRESHOLD; }
+
+} // namespace aligned_memory_ops
+} // namespace cxxporthelper
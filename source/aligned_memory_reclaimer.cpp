@@ -0,0 +1,232 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include <cxxporthelper/aligned_memory_reclaimer.hpp>
+
+#include <cxxporthelper/atomic>
+#include <cxxporthelper/cstdint>
+#include <cxxporthelper/memory>
+
+#if !CXXPH_CONFIG_USE_STLPORT
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+namespace cxxporthelper {
+
+//
+// Bounded MPMC queue (D. Vyukov's algorithm)
+//
+class aligned_memory_reclaimer::impl {
+public:
+    explicit impl(std::size_t capacity)
+        : cells_(), mask_(0), enqueue_pos_(0), dequeue_pos_(0)
+#if !CXXPH_CONFIG_USE_STLPORT
+          ,
+          thread_(), mutex_(), cond_(), stop_requested_(false)
+#endif
+    {
+        std::size_t n = 2;
+        while (n < capacity) {
+            n <<= 1;
+        }
+
+        cells_.reset(new cell_t[n]);
+        mask_ = n - 1;
+
+        for (std::size_t i = 0; i < n; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+            cells_[i].ptr = nullptr;
+        }
+    }
+
+    ~impl()
+    {
+        stop();
+        reclaim();
+    }
+
+    bool enqueue(void *ptr) CXXPH_NOEXCEPT
+    {
+        std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        cell_t *cell;
+
+        for (;;) {
+            cell = &cells_[pos & mask_];
+
+            const std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // full
+                return false;
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->ptr = ptr;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    bool dequeue(void **ptr) CXXPH_NOEXCEPT
+    {
+        std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        cell_t *cell;
+
+        for (;;) {
+            cell = &cells_[pos & mask_];
+
+            const std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // empty
+                return false;
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        (*ptr) = cell->ptr;
+        cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    std::size_t reclaim() CXXPH_NOEXCEPT
+    {
+        std::size_t count = 0;
+        void *ptr = nullptr;
+
+        while (dequeue(&ptr)) {
+            aligned_memory_static_impl::free_aligned(ptr);
+            ++count;
+        }
+
+        return count;
+    }
+
+    std::size_t capacity() const CXXPH_NOEXCEPT { return mask_ + 1; }
+
+#if !CXXPH_CONFIG_USE_STLPORT
+    bool start(unsigned int interval_ms)
+    {
+        if (thread_.joinable()) {
+            return true;
+        }
+
+        stop_requested_ = false;
+        thread_ = std::thread(&impl::worker, this, interval_ms);
+
+        return thread_.joinable();
+    }
+
+    void stop()
+    {
+        if (!thread_.joinable()) {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_requested_ = true;
+        }
+        cond_.notify_all();
+
+        thread_.join();
+    }
+#else
+    // std::thread is not available
+    bool start(unsigned int interval_ms)
+    {
+        (void)interval_ms;
+        return false;
+    }
+
+    void stop() {}
+#endif
+
+private:
+    struct cell_t {
+        std::atomic<std::size_t> sequence;
+        void *ptr;
+    };
+
+#if !CXXPH_CONFIG_USE_STLPORT
+    void worker(unsigned int interval_ms)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        while (!stop_requested_) {
+            cond_.wait_for(lock, std::chrono::milliseconds(interval_ms));
+
+            lock.unlock();
+            reclaim();
+            lock.lock();
+        }
+    }
+#endif
+
+    std::unique_ptr<cell_t[]> cells_;
+    std::size_t mask_;
+
+    // padding to avoid false sharing between producers and consumers
+    char pad0_[CXXPH_PLATFORM_CACHE_LINE_SIZE];
+    std::atomic<std::size_t> enqueue_pos_;
+    char pad1_[CXXPH_PLATFORM_CACHE_LINE_SIZE];
+    std::atomic<std::size_t> dequeue_pos_;
+    char pad2_[CXXPH_PLATFORM_CACHE_LINE_SIZE];
+
+#if !CXXPH_CONFIG_USE_STLPORT
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    bool stop_requested_;
+#endif
+};
+
+aligned_memory_reclaimer::aligned_memory_reclaimer(std::size_t capacity) : impl_(new impl(capacity)) {}
+
+aligned_memory_reclaimer::~aligned_memory_reclaimer() { delete impl_; }
+
+bool aligned_memory_reclaimer::start(unsigned int interval_ms) { return impl_->start(interval_ms); }
+
+void aligned_memory_reclaimer::stop()
+{
+    impl_->stop();
+    impl_->reclaim();
+}
+
+bool aligned_memory_reclaimer::enqueue(void *ptr) CXXPH_NOEXCEPT { return impl_->enqueue(ptr); }
+
+std::size_t aligned_memory_reclaimer::reclaim() CXXPH_NOEXCEPT { return impl_->reclaim(); }
+
+std::size_t aligned_memory_reclaimer::capacity() const CXXPH_NOEXCEPT { return impl_->capacity(); }
+
+} // namespace cxxporthelper
@@ -0,0 +1,59 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include <cxxporthelper/compiler.hpp>
+
+// NOTE: compiled with the CRC32 extension enabled (see CMakeLists.txt and Android.mk),
+//       only called if support_arm_crc32() is true
+#if ((CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM64)) && defined(__ARM_FEATURE_CRC32)
+
+#include <arm_acle.h>
+#include <cstring>
+#include <cxxporthelper/cstddef>
+#include <cxxporthelper/cstdint>
+
+namespace cxxporthelper {
+namespace crc32c {
+
+uint32_t arm_crc32_update(uint32_t crc, const void *data, std::size_t size)
+{
+    const unsigned char *p = static_cast<const unsigned char *>(data);
+    uint32_t state = ~crc;
+
+    // align to 8 bytes
+    while ((size > 0) && (reinterpret_cast<uintptr_t>(p) & 7)) {
+        state = __crc32cb(state, *p);
+        ++p;
+        --size;
+    }
+
+    for (; size >= 8; p += 8, size -= 8) {
+        uint64_t x;
+        std::memcpy(&x, p, sizeof(x));
+        state = __crc32cd(state, x);
+    }
+
+    for (; size > 0; ++p, --size) {
+        state = __crc32cb(state, *p);
+    }
+
+    return ~state;
+}
+
+} // namespace crc32c
+} // namespace cxxporthelper
+
+#endif
@@ -0,0 +1,103 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include <cxxporthelper/compiler.hpp>
+
+#if (CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM64)
+
+#include <cxxporthelper/cstdint>
+#include <cxxporthelper/denormal_mode.hpp>
+
+// FPCR (AArch64) is always available, FPSCR (AArch32) requires a VFP unit
+#if (CXXPH_COMPILER_IS_GCC || CXXPH_COMPILER_IS_CLANG) &&                                                              \
+    ((CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM64) || defined(__ARM_FP))
+#define CXXPH_DENORMAL_MODE_HAS_FZ_BIT 1
+#else
+#define CXXPH_DENORMAL_MODE_HAS_FZ_BIT 0
+#endif
+
+namespace cxxporthelper {
+namespace denormal_mode {
+
+#if CXXPH_DENORMAL_MODE_HAS_FZ_BIT
+// NOTE: FZ flushes both denormal inputs and results. AArch32 NEON instructions
+// always behave so regardless of this bit.
+static const uint32_t FPCR_FZ = (1u << 24);
+
+#if (CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM64)
+static inline uint32_t read_fpcr() CXXPH_NOEXCEPT
+{
+    uint64_t value;
+    __asm__ __volatile__("mrs %0, fpcr" : "=r"(value));
+    return static_cast<uint32_t>(value);
+}
+
+static inline void write_fpcr(uint32_t value) CXXPH_NOEXCEPT
+{
+    const uint64_t value64 = value;
+    __asm__ __volatile__("msr fpcr, %0" : : "r"(value64));
+}
+#else
+static inline uint32_t read_fpcr() CXXPH_NOEXCEPT
+{
+    uint32_t value;
+    __asm__ __volatile__("vmrs %0, fpscr" : "=r"(value));
+    return value;
+}
+
+static inline void write_fpcr(uint32_t value) CXXPH_NOEXCEPT
+{
+    __asm__ __volatile__("vmsr fpscr, %0" : : "r"(value));
+}
+#endif
+
+static inline unsigned int fpcr_to_mode(uint32_t fpcr) CXXPH_NOEXCEPT
+{
+    return (fpcr & FPCR_FZ) ? (MODE_FLUSH_TO_ZERO | MODE_DENORMALS_ARE_ZERO) : 0;
+}
+
+unsigned int get_supported_modes() CXXPH_NOEXCEPT { return (MODE_FLUSH_TO_ZERO | MODE_DENORMALS_ARE_ZERO); }
+
+unsigned int get_mode() CXXPH_NOEXCEPT { return fpcr_to_mode(read_fpcr()); }
+
+unsigned int set_mode(unsigned int mode) CXXPH_NOEXCEPT
+{
+    const uint32_t fpcr = read_fpcr();
+    const uint32_t new_fpcr = (mode & (MODE_FLUSH_TO_ZERO | MODE_DENORMALS_ARE_ZERO)) ? (fpcr | FPCR_FZ)
+                                                                                       : (fpcr & ~FPCR_FZ);
+
+    if (new_fpcr != fpcr) {
+        write_fpcr(new_fpcr);
+    }
+
+    return fpcr_to_mode(fpcr);
+}
+#else
+unsigned int get_supported_modes() CXXPH_NOEXCEPT { return 0; }
+
+unsigned int get_mode() CXXPH_NOEXCEPT { return 0; }
+
+unsigned int set_mode(unsigned int mode) CXXPH_NOEXCEPT
+{
+    (void)mode;
+    return 0;
+}
+#endif
+
+} // namespace denormal_mode
+} // namespace cxxporthelper
+
+#endif
@@ -63,12 +63,17 @@ static void arm_collect_platform_info_impl(std::bitset<platform_info_provider::N
         features.set(flags::FEATURE_INDEX_ARM_V7, (cpu_features & ANDROID_CPU_ARM_FEATURE_ARMv7) ? 1 : 0);
         features.set(flags::FEATURE_INDEX_ARM_VFP_V3, (cpu_features & ANDROID_CPU_ARM_FEATURE_VFPv3) ? 1 : 0);
         features.set(flags::FEATURE_INDEX_ARM_NEON, (cpu_features & ANDROID_CPU_ARM_FEATURE_NEON) ? 1 : 0);
+        features.set(flags::FEATURE_INDEX_ARM_FP16, (cpu_features & ANDROID_CPU_ARM_FEATURE_VFP_FP16) ? 1 : 0);
+        features.set(flags::FEATURE_INDEX_ARM_CRC32, (cpu_features & ANDROID_CPU_ARM_FEATURE_CRC32) ? 1 : 0);
     }
 #endif
 
 #if CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM64
     if (cpu_family == ANDROID_CPU_FAMILY_ARM64) {
         features.set(flags::FEATURE_INDEX_ARM_NEON, (cpu_features & ANDROID_CPU_ARM64_FEATURE_ASIMD) ? 1 : 0);
+        // half-precision conversion is a part of AArch64 Advanced SIMD
+        features.set(flags::FEATURE_INDEX_ARM_FP16, (cpu_features & ANDROID_CPU_ARM64_FEATURE_ASIMD) ? 1 : 0);
+        features.set(flags::FEATURE_INDEX_ARM_CRC32, (cpu_features & ANDROID_CPU_ARM64_FEATURE_CRC32) ? 1 : 0);
     }
 #endif
 }
@@ -107,9 +112,13 @@ static void arm_collect_platform_info_impl(std::bitset<platform_info_provider::N
 
     const std::string features_prefix("Features\t");
     const std::string cpu_arch_prefix("CPU architecture:");
+    const std::string cpu_implementer_prefix("CPU implementer\t");
+    const std::string cpu_part_prefix("CPU part\t");
 
     std::vector<std::string> features_list;
     int cpu_arch_no = 0;
+    long cpu_implementer = -1;
+    long cpu_part = -1;
 
     std::string line;
     while (std::getline(ifs_cpuinfo, line)) {
@@ -129,6 +138,17 @@ static void arm_collect_platform_info_impl(std::bitset<platform_info_provider::N
                     cpu_arch_no = l;
                 }
             }
+        } else if (starts_with(line, cpu_implementer_prefix) || starts_with(line, cpu_part_prefix)) {
+            const std::string::size_type colon_pos = line.find_first_of(':');
+
+            if (colon_pos != std::string::npos) {
+                const long l = strtol(&line[colon_pos + 1], nullptr, 0);
+                if (starts_with(line, cpu_implementer_prefix)) {
+                    cpu_implementer = l;
+                } else {
+                    cpu_part = l;
+                }
+            }
         }
     }
 
@@ -137,16 +157,32 @@ static void arm_collect_platform_info_impl(std::bitset<platform_info_provider::N
     }
 
     for (const auto &flag : features_list) {
+        if (flag == "crc32") {
+            features.set(flags::FEATURE_INDEX_ARM_CRC32, 1);
+        }
+
 #if CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM
         if (flag == "neon") {
             features.set(flags::FEATURE_INDEX_ARM_NEON, 1);
         } else if (flag == "vfpv3") {
             features.set(flags::FEATURE_INDEX_ARM_VFP_V3, 1);
+
+            // NOTE: the kernel has no flag for the half-precision extension of
+            // VFPv3 ("half" means the halfword load/store instructions and is
+            // reported by ARMv4 and later), so identify the cores having it
+            if ((cpu_implementer == 0x41) && (cpu_part == 0xc09)) {
+                // Cortex-A9
+                features.set(flags::FEATURE_INDEX_ARM_FP16, 1);
+            }
+        } else if (flag == "vfpv4") {
+            // VFPv4 always includes the half-precision extension
+            features.set(flags::FEATURE_INDEX_ARM_FP16, 1);
         }
 #endif
 #if CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM64
         if (flag == "asimd") {
             features.set(flags::FEATURE_INDEX_ARM_NEON, 1);
+            features.set(flags::FEATURE_INDEX_ARM_FP16, 1);
         }
 #endif
     }
@@ -183,6 +219,8 @@ void arm_collect_platform_info(std::bitset<platform_info_provider::NUM_FEATURE_I
     printf("armv7 - %d\n", static_cast<bool>(features[flags::FEATURE_INDEX_ARM_V7]));
     printf("vfpv3 - %d\n", static_cast<bool>(features[flags::FEATURE_INDEX_ARM_VFP_V3]));
     printf("neon - %d\n", static_cast<bool>(features[flags::FEATURE_INDEX_ARM_NEON]));
+    printf("fp16 - %d\n", static_cast<bool>(features[flags::FEATURE_INDEX_ARM_FP16]));
+    printf("crc32 - %d\n", static_cast<bool>(features[flags::FEATURE_INDEX_ARM_CRC32]));
 #endif
 }
 
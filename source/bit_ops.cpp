@@ -0,0 +1,61 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include <cxxporthelper/bit_ops.hpp>
+
+#include <cxxporthelper/dispatch.hpp>
+#include <cxxporthelper/impl/kernel_isa.hpp>
+
+namespace cxxporthelper {
+namespace bit_ops {
+
+typedef std::size_t (*scan_func_t)(const uint64_t *, std::size_t);
+typedef std::size_t (*collect_func_t)(uint32_t *, const uint64_t *, std::size_t);
+typedef void (*elementwise_func_t)(uint32_t *, const uint32_t *, std::size_t);
+
+#define CXXPH_BIT_OPS_DEFINE_FUNCTION(ret, name, func_t, params, args)                                                 \
+    CXXPH_KERNEL_DECLARE_VARIANTS(ret, name##_kernel, params)                                                          \
+                                                                                                                       \
+    static const dispatch::kernel_variant<func_t> name##_variants[] = {                                                \
+        CXXPH_KERNEL_VARIANT_TABLE_ENTRIES(name##_kernel)                                                              \
+    };                                                                                                                 \
+                                                                                                                       \
+    CXXPH_DISPATCH_DEFINE_FUNCTION(ret, name, params, args, name##_variants)
+
+#define CXXPH_BIT_OPS_DEFINE_SCAN_FUNCTION(name)                                                                       \
+    CXXPH_BIT_OPS_DEFINE_FUNCTION(std::size_t, name, scan_func_t, (const uint64_t *bitmap, std::size_t num_words),     \
+                                  (bitmap, num_words))
+
+#define CXXPH_BIT_OPS_DEFINE_ELEMENTWISE_FUNCTION(name)                                                                \
+    CXXPH_BIT_OPS_DEFINE_FUNCTION(void, name, elementwise_func_t,                                                      \
+                                  (uint32_t *dest, const uint32_t *src, std::size_t n), (dest, src, n))
+
+// bitmaps
+CXXPH_BIT_OPS_DEFINE_SCAN_FUNCTION(count_ones_bitmap)
+CXXPH_BIT_OPS_DEFINE_SCAN_FUNCTION(find_first_set)
+CXXPH_BIT_OPS_DEFINE_SCAN_FUNCTION(find_first_clear)
+CXXPH_BIT_OPS_DEFINE_SCAN_FUNCTION(find_last_set)
+CXXPH_BIT_OPS_DEFINE_FUNCTION(std::size_t, collect_set_bits, collect_func_t,
+                              (uint32_t *dest, const uint64_t *bitmap, std::size_t num_words),
+                              (dest, bitmap, num_words))
+
+// element-wise
+CXXPH_BIT_OPS_DEFINE_ELEMENTWISE_FUNCTION(count_ones_elementwise)
+CXXPH_BIT_OPS_DEFINE_ELEMENTWISE_FUNCTION(count_leading_zeros)
+CXXPH_BIT_OPS_DEFINE_ELEMENTWISE_FUNCTION(count_trailing_zeros)
+
+} // namespace bit_ops
+} // namespace cxxporthelper
@@ -0,0 +1,93 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include <cxxporthelper/complex_math.hpp>
+
+#include <cxxporthelper/dispatch.hpp>
+#include <cxxporthelper/impl/kernel_isa.hpp>
+
+namespace cxxporthelper {
+namespace complex_math {
+
+typedef void (*interleaved_binary_func_t)(float *, const float *, const float *, std::size_t);
+typedef void (*interleaved_to_real_func_t)(float *, const float *, std::size_t);
+typedef void (*split_binary_func_t)(float *, float *, const float *, const float *, const float *, const float *,
+                                    std::size_t);
+typedef void (*split_to_real_func_t)(float *, const float *, const float *, std::size_t);
+typedef void (*interleaved_to_split_func_t)(float *, float *, const float *, std::size_t);
+typedef void (*split_to_interleaved_func_t)(float *, const float *, const float *, std::size_t);
+
+#define CXXPH_COMPLEX_MATH_DEFINE_FUNCTION(name, func_t, params, args)                                                 \
+    CXXPH_KERNEL_DECLARE_VARIANTS(void, name##_kernel, params)                                                         \
+                                                                                                                       \
+    static const dispatch::kernel_variant<func_t> name##_variants[] = {                                                \
+        CXXPH_KERNEL_VARIANT_TABLE_ENTRIES(name##_kernel)                                                              \
+    };                                                                                                                 \
+                                                                                                                       \
+    CXXPH_DISPATCH_DEFINE_FUNCTION(void, name, params, args, name##_variants)
+
+#define CXXPH_COMPLEX_MATH_DEFINE_INTERLEAVED_BINARY_FUNCTION(name)                                                    \
+    CXXPH_COMPLEX_MATH_DEFINE_FUNCTION(name##_interleaved, interleaved_binary_func_t,                                  \
+                                       (float *dest, const float *a, const float *b, std::size_t n), (dest, a, b, n))
+
+#define CXXPH_COMPLEX_MATH_DEFINE_INTERLEAVED_TO_REAL_FUNCTION(name)                                                   \
+    CXXPH_COMPLEX_MATH_DEFINE_FUNCTION(name##_interleaved, interleaved_to_real_func_t,                                 \
+                                       (float *dest, const float *src, std::size_t n), (dest, src, n))
+
+#define CXXPH_COMPLEX_MATH_DEFINE_SPLIT_BINARY_FUNCTION(name)                                                          \
+    CXXPH_COMPLEX_MATH_DEFINE_FUNCTION(name##_split, split_binary_func_t,                                              \
+                                       (float *dest_re, float *dest_im, const float *a_re, const float *a_im,          \
+                                        const float *b_re, const float *b_im, std::size_t n),                          \
+                                       (dest_re, dest_im, a_re, a_im, b_re, b_im, n))
+
+#define CXXPH_COMPLEX_MATH_DEFINE_SPLIT_TO_REAL_FUNCTION(name)                                                         \
+    CXXPH_COMPLEX_MATH_DEFINE_FUNCTION(name##_split, split_to_real_func_t,                                             \
+                                       (float *dest, const float *src_re, const float *src_im, std::size_t n),         \
+                                       (dest, src_re, src_im, n))
+
+// interleaved layout
+CXXPH_COMPLEX_MATH_DEFINE_INTERLEAVED_BINARY_FUNCTION(multiply)
+CXXPH_COMPLEX_MATH_DEFINE_INTERLEAVED_BINARY_FUNCTION(multiply_conj)
+CXXPH_COMPLEX_MATH_DEFINE_INTERLEAVED_BINARY_FUNCTION(multiply_accumulate)
+CXXPH_COMPLEX_MATH_DEFINE_INTERLEAVED_TO_REAL_FUNCTION(magnitude)
+CXXPH_COMPLEX_MATH_DEFINE_INTERLEAVED_TO_REAL_FUNCTION(squared_magnitude)
+CXXPH_COMPLEX_MATH_DEFINE_INTERLEAVED_TO_REAL_FUNCTION(phase)
+
+// split layout
+CXXPH_COMPLEX_MATH_DEFINE_SPLIT_BINARY_FUNCTION(multiply)
+CXXPH_COMPLEX_MATH_DEFINE_SPLIT_BINARY_FUNCTION(multiply_conj)
+CXXPH_COMPLEX_MATH_DEFINE_SPLIT_BINARY_FUNCTION(multiply_accumulate)
+CXXPH_COMPLEX_MATH_DEFINE_SPLIT_TO_REAL_FUNCTION(magnitude)
+CXXPH_COMPLEX_MATH_DEFINE_SPLIT_TO_REAL_FUNCTION(squared_magnitude)
+CXXPH_COMPLEX_MATH_DEFINE_SPLIT_TO_REAL_FUNCTION(phase)
+
+// layout conversion
+CXXPH_COMPLEX_MATH_DEFINE_FUNCTION(interleaved_to_split, interleaved_to_split_func_t,
+                                   (float *dest_re, float *dest_im, const float *src, std::size_t n),
+                                   (dest_re, dest_im, src, n))
+
+CXXPH_COMPLEX_MATH_DEFINE_FUNCTION(split_to_interleaved, split_to_interleaved_func_t,
+                                   (float *dest, const float *src_re, const float *src_im, std::size_t n),
+                                   (dest, src_re, src_im, n))
+
+#undef CXXPH_COMPLEX_MATH_DEFINE_FUNCTION
+#undef CXXPH_COMPLEX_MATH_DEFINE_INTERLEAVED_BINARY_FUNCTION
+#undef CXXPH_COMPLEX_MATH_DEFINE_INTERLEAVED_TO_REAL_FUNCTION
+#undef CXXPH_COMPLEX_MATH_DEFINE_SPLIT_BINARY_FUNCTION
+#undef CXXPH_COMPLEX_MATH_DEFINE_SPLIT_TO_REAL_FUNCTION
+
+} // namespace complex_math
+} // namespace cxxporthelper
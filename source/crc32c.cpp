@@ -0,0 +1,54 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include <cxxporthelper/crc32c.hpp>
+
+#include <cxxporthelper/dispatch.hpp>
+#include <cxxporthelper/platform_info.hpp>
+#include <cxxporthelper/impl/kernel_isa.hpp>
+
+namespace cxxporthelper {
+namespace crc32c {
+
+typedef uint32_t (*update_func_t)(uint32_t, const void *, std::size_t);
+
+CXXPH_KERNEL_DECLARE_VARIANTS(uint32_t, update_kernel, (uint32_t crc, const void *data, std::size_t size))
+
+static const dispatch::kernel_variant<update_func_t> update_variants[] = {
+    CXXPH_KERNEL_VARIANT_TABLE_ENTRIES(update_kernel)
+};
+
+#if CXXPH_CRC32C_ARM_CRC32_ENABLED
+// source/arm__arm64/crc32c_arm.cpp (compiled with the CRC32 extension enabled)
+extern uint32_t arm_crc32_update(uint32_t crc, const void *data, std::size_t size);
+
+CXXPH_DISPATCH_DEFINE_FUNCTION(uint32_t, update_by_isa_level, (uint32_t crc, const void *data, std::size_t size),
+                               (crc, data, size), update_variants)
+
+uint32_t update(uint32_t crc, const void *data, std::size_t size)
+{
+    // NOTE: the CRC32 extension is optional on ARMv8.0, and not a part of any ISA level
+    static const update_func_t func = (platform_info::support_arm_crc32()) ? &arm_crc32_update : &update_by_isa_level;
+
+    return func(crc, data, size);
+}
+#else
+CXXPH_DISPATCH_DEFINE_FUNCTION(uint32_t, update, (uint32_t crc, const void *data, std::size_t size), (crc, data, size),
+                               update_variants)
+#endif
+
+} // namespace crc32c
+} // namespace cxxporthelper
@@ -0,0 +1,39 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include <cxxporthelper/denormal_mode.hpp>
+
+// NOTE: x86 and ARM are implemented in source/x86__x86_64 and source/arm__arm64
+#if !((CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64) ||                            \
+      (CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM64))
+
+namespace cxxporthelper {
+namespace denormal_mode {
+
+unsigned int get_supported_modes() CXXPH_NOEXCEPT { return 0; }
+
+unsigned int get_mode() CXXPH_NOEXCEPT { return 0; }
+
+unsigned int set_mode(unsigned int mode) CXXPH_NOEXCEPT
+{
+    (void)mode;
+    return 0;
+}
+
+} // namespace denormal_mode
+} // namespace cxxporthelper
+
+#endif
@@ -0,0 +1,283 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include <cxxporthelper/dispatch.hpp>
+
+#include <bitset>
+#include <cstring>
+#include <cxxporthelper/platform_info.hpp>
+#include <cxxporthelper/impl/kernel_isa.hpp>
+
+namespace cxxporthelper {
+namespace dispatch {
+
+using namespace ::cxxporthelper::platform_info;
+
+// NOTE: constant-initialized, so registration works during static initialization
+static std::atomic<dispatcher_info *> g_first_dispatcher(nullptr);
+static std::atomic<int> g_isa_level_limit(static_cast<int>(NUM_ISA_LEVELS));
+
+// rank within the architecture (used for limiting)
+static int get_isa_level_rank(int level) CXXPH_NOEXCEPT
+{
+    switch (level) {
+    case ISA_LEVEL_GENERIC:
+        return 0;
+    case ISA_LEVEL_X86_SSE4_2:
+        return 1;
+    case ISA_LEVEL_X86_AVX2:
+        return 2;
+    case ISA_LEVEL_X86_AVX512:
+        return 3;
+    case ISA_LEVEL_ARM_NEON:
+        return 1;
+    default:
+        return 0x7fff;
+    }
+}
+
+typedef platform_info_provider::feature_index_t feature_index_t;
+typedef std::bitset<platform_info_provider::NUM_FEATURE_INDICES> feature_bits_t;
+
+struct runtime_features {
+    bool has(feature_index_t index) const CXXPH_NOEXCEPT { return check_feature(index); }
+};
+
+struct collected_features {
+    const feature_bits_t &bits;
+    bool has(feature_index_t index) const CXXPH_NOEXCEPT { return bits[index]; }
+};
+
+template <typename Features>
+static bool check_isa_level_features(int level, const Features &f) CXXPH_NOEXCEPT
+{
+    typedef platform_info_provider pip;
+
+    switch (level) {
+    case ISA_LEVEL_GENERIC:
+        return true;
+    case ISA_LEVEL_X86_SSE4_2:
+        return f.has(pip::FEATURE_INDEX_X86_SSE2) && f.has(pip::FEATURE_INDEX_X86_SSE3) &&
+               f.has(pip::FEATURE_INDEX_X86_SSSE3) && f.has(pip::FEATURE_INDEX_X86_SSE4_1) &&
+               f.has(pip::FEATURE_INDEX_X86_SSE4_2) && f.has(pip::FEATURE_INDEX_X86_POPCNT);
+    case ISA_LEVEL_X86_AVX2:
+        return check_isa_level_features(ISA_LEVEL_X86_SSE4_2, f) && f.has(pip::FEATURE_INDEX_X86_AVX) &&
+               f.has(pip::FEATURE_INDEX_X86_AVX2) && f.has(pip::FEATURE_INDEX_X86_FMA) &&
+               f.has(pip::FEATURE_INDEX_X86_F16C) && f.has(pip::FEATURE_INDEX_X86_BMI1) &&
+               f.has(pip::FEATURE_INDEX_X86_BMI2) && f.has(pip::FEATURE_INDEX_X86_LZCNT) &&
+               f.has(pip::FEATURE_INDEX_X86_MOVBE);
+    case ISA_LEVEL_X86_AVX512:
+        return check_isa_level_features(ISA_LEVEL_X86_AVX2, f) && f.has(pip::FEATURE_INDEX_X86_AVX512F) &&
+               f.has(pip::FEATURE_INDEX_X86_AVX512CD) && f.has(pip::FEATURE_INDEX_X86_AVX512DQ) &&
+               f.has(pip::FEATURE_INDEX_X86_AVX512BW) && f.has(pip::FEATURE_INDEX_X86_AVX512VL);
+    case ISA_LEVEL_ARM_NEON:
+        return f.has(pip::FEATURE_INDEX_ARM_NEON);
+    default:
+        return false;
+    }
+}
+
+bool is_isa_level_supported(isa_level_t level) CXXPH_NOEXCEPT
+{
+    return check_isa_level_features(level, runtime_features());
+}
+
+bool is_isa_level_enabled(isa_level_t level) CXXPH_NOEXCEPT
+{
+    const int limit = g_isa_level_limit.load(std::memory_order_relaxed);
+
+    return is_isa_level_supported(level) && (get_isa_level_rank(level) <= get_isa_level_rank(limit));
+}
+
+isa_level_t get_best_isa_level() CXXPH_NOEXCEPT
+{
+    static const isa_level_t candidates[] = { ISA_LEVEL_X86_AVX512, ISA_LEVEL_X86_AVX2, ISA_LEVEL_X86_SSE4_2,
+                                              ISA_LEVEL_ARM_NEON, };
+
+    for (std::size_t i = 0; i < (sizeof(candidates) / sizeof(candidates[0])); ++i) {
+        if (is_isa_level_enabled(candidates[i])) {
+            return candidates[i];
+        }
+    }
+
+    return ISA_LEVEL_GENERIC;
+}
+
+const char *get_isa_level_name(isa_level_t level) CXXPH_NOEXCEPT
+{
+    switch (level) {
+    case ISA_LEVEL_GENERIC:
+        return "generic";
+    case ISA_LEVEL_X86_SSE4_2:
+        return "x86_sse4_2";
+    case ISA_LEVEL_X86_AVX2:
+        return "x86_avx2";
+    case ISA_LEVEL_X86_AVX512:
+        return "x86_avx512";
+    case ISA_LEVEL_ARM_NEON:
+        return "arm_neon";
+    default:
+        return "unknown";
+    }
+}
+
+void set_isa_level_limit(isa_level_t level) CXXPH_NOEXCEPT
+{
+    g_isa_level_limit.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+isa_level_t get_isa_level_limit() CXXPH_NOEXCEPT
+{
+    return static_cast<isa_level_t>(g_isa_level_limit.load(std::memory_order_relaxed));
+}
+
+void register_dispatcher(dispatcher_info *info) CXXPH_NOEXCEPT
+{
+    if (!info || info->registered_) {
+        return;
+    }
+
+    info->registered_ = true;
+
+    dispatcher_info *head = g_first_dispatcher.load(std::memory_order_relaxed);
+    do {
+        info->next_ = head;
+    } while (!g_first_dispatcher.compare_exchange_weak(head, info, std::memory_order_release,
+                                                       std::memory_order_relaxed));
+}
+
+#if CXXPH_DISPATCH_USE_IFUNC
+} // namespace dispatch
+
+namespace platform_info {
+extern void
+i386_x86_64_collect_platform_info(std::bitset<platform_info_provider::NUM_FEATURE_INDICES> &features) CXXPH_NOEXCEPT;
+} // namespace platform_info
+
+namespace dispatch {
+
+// NOTE:
+// IFUNC resolvers run while the dynamic loader is relocating, before any
+// constructor (including the function-local static in
+// get_platform_info_provider_instance()). Only plain static data and the
+// CPUID based collector are used here.
+static bool g_load_time_features_collected = false;
+static feature_bits_t g_load_time_features;
+
+int select_kernel_variant_at_load_time(const isa_level_t *levels, std::size_t stride,
+                                       std::size_t num_variants) CXXPH_NOEXCEPT
+{
+    if (num_variants == 0) {
+        return -1;
+    }
+
+    if (!g_load_time_features_collected) {
+        i386_x86_64_collect_platform_info(g_load_time_features);
+        g_load_time_features_collected = true;
+    }
+
+    const collected_features features = { g_load_time_features };
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(levels);
+
+    for (std::size_t i = 0; i < num_variants; ++i) {
+        const isa_level_t level = *reinterpret_cast<const isa_level_t *>(p + stride * i);
+
+        if (check_isa_level_features(level, features)) {
+            return static_cast<int>(i);
+        }
+    }
+
+    return static_cast<int>(num_variants - 1);
+}
+#endif
+
+int select_kernel_variant(const isa_level_t *levels, std::size_t stride, std::size_t num_variants) CXXPH_NOEXCEPT
+{
+    if (num_variants == 0) {
+        return -1;
+    }
+
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(levels);
+
+    for (std::size_t i = 0; i < num_variants; ++i) {
+        const isa_level_t level = *reinterpret_cast<const isa_level_t *>(p + stride * i);
+
+        if (is_isa_level_enabled(level)) {
+            return static_cast<int>(i);
+        }
+    }
+
+    return static_cast<int>(num_variants - 1);
+}
+
+const dispatcher_info *get_first_dispatcher() CXXPH_NOEXCEPT
+{
+    return g_first_dispatcher.load(std::memory_order_acquire);
+}
+
+const dispatcher_info *find_dispatcher(const char *name) CXXPH_NOEXCEPT
+{
+    if (!name) {
+        return nullptr;
+    }
+
+    for (const dispatcher_info *info = get_first_dispatcher(); info; info = info->next()) {
+        if (std::strcmp(info->name(), name) == 0) {
+            return info;
+        }
+    }
+
+    return nullptr;
+}
+
+void resolve_all_dispatchers() CXXPH_NOEXCEPT
+{
+    for (const dispatcher_info *info = get_first_dispatcher(); info; info = info->next()) {
+        const_cast<dispatcher_info *>(info)->resolve();
+    }
+}
+
+bool is_isa_level_built(isa_level_t level) CXXPH_NOEXCEPT
+{
+    switch (level) {
+    case ISA_LEVEL_GENERIC:
+        return true;
+    case ISA_LEVEL_X86_SSE4_2:
+        return CXXPH_KERNEL_ISA_X86_SSE4_2_ENABLED;
+    case ISA_LEVEL_X86_AVX2:
+        return CXXPH_KERNEL_ISA_X86_AVX2_ENABLED;
+    case ISA_LEVEL_X86_AVX512:
+        return CXXPH_KERNEL_ISA_X86_AVX512_ENABLED;
+    case ISA_LEVEL_ARM_NEON:
+        return CXXPH_KERNEL_ISA_ARM_NEON_ENABLED;
+    default:
+        return false;
+    }
+}
+
+// probe (source/kernels/kernel_isa_probe.cpp)
+CXXPH_KERNEL_DECLARE_VARIANTS(int, kernels_isa_level, ())
+
+static const kernel_variant<int (*)()> kernels_isa_level_variants[] = {
+    CXXPH_KERNEL_VARIANT_TABLE_ENTRIES(kernels_isa_level)
+};
+
+CXXPH_DISPATCH_DEFINE_FUNCTION(int, kernels_isa_level, (), (), kernels_isa_level_variants)
+
+isa_level_t get_kernels_isa_level() CXXPH_NOEXCEPT { return static_cast<isa_level_t>(kernels_isa_level()); }
+
+} // namespace dispatch
+} // namespace cxxporthelper
@@ -0,0 +1,51 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+
+#include <cxxporthelper/fir_filter.hpp>
+
+#include <cxxporthelper/dispatch.hpp>
+#include <cxxporthelper/impl/kernel_isa.hpp>
+
+namespace cxxporthelper {
+namespace fir_filter {
+
+typedef void (*direct_form_func_t)(float *, const float *, std::size_t, const float *, std::size_t, std::size_t);
+typedef void (*transposed_form_func_t)(float *, const float *, const float *, std::size_t, float *, std::size_t);
+
+CXXPH_KERNEL_DECLARE_VARIANTS(void, direct_form_kernel, (float *dest, const float *src, std::size_t stride,
+                                                         const float *coeffs, std::size_t num_taps, std::size_t n))
+CXXPH_KERNEL_DECLARE_VARIANTS(void, transposed_form_kernel, (float *dest, const float *src, const float *coeffs,
+                                                             std::size_t num_taps, float *state, std::size_t n))
+
+static const dispatch::kernel_variant<direct_form_func_t> direct_form_variants[] = {
+    CXXPH_KERNEL_VARIANT_TABLE_ENTRIES(direct_form_kernel)
+};
+
+static const dispatch::kernel_variant<transposed_form_func_t> transposed_form_variants[] = {
+    CXXPH_KERNEL_VARIANT_TABLE_ENTRIES(transposed_form_kernel)
+};
+
+CXXPH_DISPATCH_DEFINE_FUNCTION(void, direct_form, (float *dest, const float *src, std::size_t stride,
+                                                   const float *coeffs, std::size_t num_taps, std::size_t n),
+                               (dest, src, stride, coeffs, num_taps, n), direct_form_variants)
+
+CXXPH_DISPATCH_DEFINE_FUNCTION(void, process_transposed, (float *dest, const float *src, const float *coeffs,
+                                                          std::size_t num_taps, float *state, std::size_t n),
+                               (dest, src, coeffs, num_taps, state, n), transposed_form_variants)
+
+} // namespace fir_filter
+} // namespace cxxporthelper
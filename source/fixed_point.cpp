@@ -0,0 +1,60 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include <cxxporthelper/fixed_point.hpp>
+
+#include <cxxporthelper/dispatch.hpp>
+#include <cxxporthelper/impl/kernel_isa.hpp>
+
+namespace cxxporthelper {
+namespace fixed_point {
+
+typedef void (*binary_q15_func_t)(int16_t *, const int16_t *, const int16_t *, std::size_t);
+typedef void (*scale_q15_func_t)(int16_t *, const int16_t *, int16_t, std::size_t);
+typedef void (*binary_q31_func_t)(int32_t *, const int32_t *, const int32_t *, std::size_t);
+typedef void (*scale_q31_func_t)(int32_t *, const int32_t *, int32_t, std::size_t);
+
+#define CXXPH_FIXED_POINT_DEFINE_FUNCTION(name, func_t, params, args)                                                  \
+    CXXPH_KERNEL_DECLARE_VARIANTS(void, name##_kernel, params)                                                         \
+                                                                                                                       \
+    static const dispatch::kernel_variant<func_t> name##_variants[] = {                                                \
+        CXXPH_KERNEL_VARIANT_TABLE_ENTRIES(name##_kernel)                                                              \
+    };                                                                                                                 \
+                                                                                                                       \
+    CXXPH_DISPATCH_DEFINE_FUNCTION(void, name, params, args, name##_variants)
+
+#define CXXPH_FIXED_POINT_DEFINE_BINARY_FUNCTIONS(name)                                                                \
+    CXXPH_FIXED_POINT_DEFINE_FUNCTION(name##_q15, binary_q15_func_t,                                                   \
+                                      (int16_t *dest, const int16_t *a, const int16_t *b, std::size_t n),              \
+                                      (dest, a, b, n))                                                                 \
+    CXXPH_FIXED_POINT_DEFINE_FUNCTION(name##_q31, binary_q31_func_t,                                                   \
+                                      (int32_t *dest, const int32_t *a, const int32_t *b, std::size_t n),              \
+                                      (dest, a, b, n))
+
+CXXPH_FIXED_POINT_DEFINE_BINARY_FUNCTIONS(multiply)
+CXXPH_FIXED_POINT_DEFINE_BINARY_FUNCTIONS(multiply_accumulate)
+CXXPH_FIXED_POINT_DEFINE_BINARY_FUNCTIONS(add)
+CXXPH_FIXED_POINT_DEFINE_BINARY_FUNCTIONS(subtract)
+
+CXXPH_FIXED_POINT_DEFINE_FUNCTION(scale_q15, scale_q15_func_t,
+                                  (int16_t *dest, const int16_t *src, int16_t gain, std::size_t n),
+                                  (dest, src, gain, n))
+CXXPH_FIXED_POINT_DEFINE_FUNCTION(scale_q31, scale_q31_func_t,
+                                  (int32_t *dest, const int32_t *src, int32_t gain, std::size_t n),
+                                  (dest, src, gain, n))
+
+} // namespace fixed_point
+} // namespace cxxporthelper
@@ -0,0 +1,43 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include <cxxporthelper/half_float.hpp>
+
+#include <cxxporthelper/dispatch.hpp>
+#include <cxxporthelper/impl/kernel_isa.hpp>
+
+namespace cxxporthelper {
+namespace half_float {
+
+CXXPH_KERNEL_DECLARE_VARIANTS(void, to_float_kernel, (float *dest, const uint16_t *src, std::size_t n))
+CXXPH_KERNEL_DECLARE_VARIANTS(void, from_float_kernel, (uint16_t *dest, const float *src, std::size_t n))
+
+static const dispatch::kernel_variant<void (*)(float *, const uint16_t *, std::size_t)> to_float_variants[] = {
+    CXXPH_KERNEL_VARIANT_TABLE_ENTRIES(to_float_kernel)
+};
+
+static const dispatch::kernel_variant<void (*)(uint16_t *, const float *, std::size_t)> from_float_variants[] = {
+    CXXPH_KERNEL_VARIANT_TABLE_ENTRIES(from_float_kernel)
+};
+
+CXXPH_DISPATCH_DEFINE_FUNCTION(void, to_float, (float *dest, const uint16_t *src, std::size_t n), (dest, src, n),
+                               to_float_variants)
+
+CXXPH_DISPATCH_DEFINE_FUNCTION(void, from_float, (uint16_t *dest, const float *src, std::size_t n), (dest, src, n),
+                               from_float_variants)
+
+} // namespace half_float
+} // namespace cxxporthelper
@@ -0,0 +1,233 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include <cxxporthelper/impl/kernel_isa.hpp>
+
+#include <cassert>
+#include <cstring>
+#include <cxxporthelper/cstdint>
+#include <cxxporthelper/impl/cxxporthelper_config.hpp>
+
+namespace cxxporthelper {
+namespace aligned_memory_ops {
+namespace CXXPH_KERNEL_ISA_NAMESPACE {
+
+using simd::i32x8;
+
+namespace {
+
+// one cache line per step
+const std::size_t BLOCK_SIZE = CXXPH_PLATFORM_CACHE_LINE_SIZE;
+const std::size_t VECTORS_PER_BLOCK = BLOCK_SIZE / sizeof(i32x8::value_type) / i32x8::num_lanes;
+const std::size_t STEP = BLOCK_SIZE / sizeof(i32x8::value_type);
+
+inline bool is_aligned(const void *p) CXXPH_NOEXCEPT
+{
+    return (reinterpret_cast<uintptr_t>(p) & (BLOCK_SIZE - 1)) == 0;
+}
+
+inline bool use_libc(std::size_t size) CXXPH_NOEXCEPT
+{
+    return (size < CXXPH_CONFIG_ALIGNED_MEMORY_OPS_LIBC_THRESHOLD);
+}
+
+inline bool use_non_temporal_store(std::size_t size) CXXPH_NOEXCEPT
+{
+    return (CXXPH_CONFIG_NON_TEMPORAL_STORE_THRESHOLD > 0) && (size >= CXXPH_CONFIG_NON_TEMPORAL_STORE_THRESHOLD);
+}
+
+// processes UNROLL blocks per loop iteration (the loop overhead dominates for small blocks)
+const std::size_t UNROLL = 4;
+
+template <bool NonTemporal, std::size_t N>
+inline void store_vectors(int32_t *dest, const i32x8 (&v)[N]) CXXPH_NOEXCEPT
+{
+    for (std::size_t k = 0; k < N; ++k) {
+        if (NonTemporal) {
+            v[k].store_stream(&dest[k * i32x8::num_lanes]);
+        } else {
+            v[k].store_aligned(&dest[k * i32x8::num_lanes]);
+        }
+    }
+}
+
+template <std::size_t N>
+inline void load_vectors(const int32_t *src, i32x8 (&v)[N]) CXXPH_NOEXCEPT
+{
+    for (std::size_t k = 0; k < N; ++k) {
+        v[k] = i32x8::load_aligned(&src[k * i32x8::num_lanes]);
+    }
+}
+
+template <bool NonTemporal>
+void fill_blocks(int32_t *dest, const i32x8 &value, std::size_t num_blocks) CXXPH_NOEXCEPT
+{
+    i32x8 v[UNROLL * VECTORS_PER_BLOCK];
+    i32x8 v1[VECTORS_PER_BLOCK];
+    std::size_t i = 0;
+
+    for (std::size_t k = 0; k < (UNROLL * VECTORS_PER_BLOCK); ++k) {
+        v[k] = value;
+    }
+
+    for (std::size_t k = 0; k < VECTORS_PER_BLOCK; ++k) {
+        v1[k] = value;
+    }
+
+    for (; (i + UNROLL) <= num_blocks; i += UNROLL) {
+        store_vectors<NonTemporal>(&dest[i * STEP], v);
+    }
+
+    for (; i < num_blocks; ++i) {
+        store_vectors<NonTemporal>(&dest[i * STEP], v1);
+    }
+}
+
+// NOTE: the blocks are loaded completely before they are stored,
+// so forward copy also works for overlapping blocks with dest < src
+template <bool NonTemporal>
+void copy_blocks_forward(int32_t *dest, const int32_t *src, std::size_t num_blocks) CXXPH_NOEXCEPT
+{
+    i32x8 v[UNROLL * VECTORS_PER_BLOCK];
+    i32x8 v1[VECTORS_PER_BLOCK];
+    std::size_t i = 0;
+
+    for (; (i + UNROLL) <= num_blocks; i += UNROLL) {
+        load_vectors(&src[i * STEP], v);
+        store_vectors<NonTemporal>(&dest[i * STEP], v);
+    }
+
+    for (; i < num_blocks; ++i) {
+        load_vectors(&src[i * STEP], v1);
+        store_vectors<NonTemporal>(&dest[i * STEP], v1);
+    }
+}
+
+void copy_blocks_backward(int32_t *dest, const int32_t *src, std::size_t num_blocks) CXXPH_NOEXCEPT
+{
+    i32x8 v[UNROLL * VECTORS_PER_BLOCK];
+    i32x8 v1[VECTORS_PER_BLOCK];
+    std::size_t i = num_blocks;
+
+    for (; i >= UNROLL; i -= UNROLL) {
+        load_vectors(&src[(i - UNROLL) * STEP], v);
+        store_vectors<false>(&dest[(i - UNROLL) * STEP], v);
+    }
+
+    for (; i > 0; --i) {
+        load_vectors(&src[(i - 1) * STEP], v1);
+        store_vectors<false>(&dest[(i - 1) * STEP], v1);
+    }
+}
+
+} // namespace
+
+void fill_kernel(void *dest, int value, std::size_t size)
+{
+    assert(is_aligned(dest));
+
+    if (use_libc(size)) {
+        std::memset(dest, value, size);
+        return;
+    }
+
+    const std::size_t num_blocks = size / BLOCK_SIZE;
+    const std::size_t tail = size % BLOCK_SIZE;
+    const i32x8 v(static_cast<int32_t>(0x01010101U * static_cast<unsigned char>(value)));
+    int32_t *d = static_cast<int32_t *>(dest);
+
+    if (use_non_temporal_store(size)) {
+        fill_blocks<true>(d, v, num_blocks);
+        simd::stream_fence();
+    } else {
+        fill_blocks<false>(d, v, num_blocks);
+    }
+
+    if (tail) {
+        std::memset(static_cast<unsigned char *>(dest) + (size - tail), value, tail);
+    }
+}
+
+void copy_kernel(void *dest, const void *src, std::size_t size)
+{
+    assert(is_aligned(dest) && is_aligned(src));
+
+    if (use_libc(size)) {
+        std::memcpy(dest, src, size);
+        return;
+    }
+
+    const std::size_t num_blocks = size / BLOCK_SIZE;
+    const std::size_t tail = size % BLOCK_SIZE;
+    int32_t *d = static_cast<int32_t *>(dest);
+    const int32_t *s = static_cast<const int32_t *>(src);
+
+    if (use_non_temporal_store(size)) {
+        copy_blocks_forward<true>(d, s, num_blocks);
+        simd::stream_fence();
+    } else {
+        copy_blocks_forward<false>(d, s, num_blocks);
+    }
+
+    if (tail) {
+        std::memcpy(static_cast<unsigned char *>(dest) + (size - tail),
+                    static_cast<const unsigned char *>(src) + (size - tail), tail);
+    }
+}
+
+void move_kernel(void *dest, const void *src, std::size_t size)
+{
+    assert(is_aligned(dest) && is_aligned(src));
+
+    if (use_libc(size)) {
+        std::memmove(dest, src, size);
+        return;
+    }
+
+    const uintptr_t d_addr = reinterpret_cast<uintptr_t>(dest);
+    const uintptr_t s_addr = reinterpret_cast<uintptr_t>(src);
+
+    if (d_addr == s_addr) {
+        return;
+    }
+
+    const bool overlapped = (d_addr < s_addr) ? ((s_addr - d_addr) < size) : ((d_addr - s_addr) < size);
+
+    if (!overlapped) {
+        copy_kernel(dest, src, size);
+        return;
+    }
+
+    const std::size_t num_blocks = size / BLOCK_SIZE;
+    const std::size_t tail = size % BLOCK_SIZE;
+    int32_t *d = static_cast<int32_t *>(dest);
+    const int32_t *s = static_cast<const int32_t *>(src);
+    unsigned char *d_tail = static_cast<unsigned char *>(dest) + (size - tail);
+    const unsigned char *s_tail = static_cast<const unsigned char *>(src) + (size - tail);
+
+    // the tail does not overlap the blocks that are processed before it
+    if (d_addr < s_addr) {
+        copy_blocks_forward<false>(d, s, num_blocks);
+        std::memmove(d_tail, s_tail, tail);
+    } else {
+        std::memmove(d_tail, s_tail, tail);
+        copy_blocks_backward(d, s, num_blocks);
+    }
+}
+
+} // namespace CXXPH_KERNEL_ISA_NAMESPACE
+} // namespace aligned_memory_ops
+} // namespace cxxporthelper
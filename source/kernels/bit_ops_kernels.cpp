@@ -0,0 +1,322 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include <cxxporthelper/impl/kernel_isa.hpp>
+
+#include <cstring>
+#include <cxxporthelper/bit_ops.hpp>
+
+#if CXXPH_SIMD_USE_ARM_NEON
+#include <cxxporthelper/arm_neon.hpp>
+#endif
+
+namespace cxxporthelper {
+namespace bit_ops {
+namespace CXXPH_KERNEL_ISA_NAMESPACE {
+
+using simd::i32x4;
+using simd::i32x8;
+
+namespace {
+
+//
+// scalar operations (POPCNT / TZCNT / LZCNT if the build enables them)
+//
+CXXPH_FORCEINLINE unsigned int popcount64(uint64_t x) CXXPH_NOEXCEPT
+{
+#if (CXXPH_COMPILER_IS_GCC || CXXPH_COMPILER_IS_CLANG) && (defined(__POPCNT__) || CXXPH_SIMD_USE_ARM_NEON)
+    return static_cast<unsigned int>(__builtin_popcountll(x));
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ull);
+    x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+    x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0full;
+    return static_cast<unsigned int>((x * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+// NOTE: x must not be 0
+CXXPH_FORCEINLINE unsigned int ctz64(uint64_t x) CXXPH_NOEXCEPT
+{
+#if CXXPH_COMPILER_IS_GCC || CXXPH_COMPILER_IS_CLANG
+    return static_cast<unsigned int>(__builtin_ctzll(x));
+#else
+    return popcount64(~x & (x - 1));
+#endif
+}
+
+// NOTE: x must not be 0
+CXXPH_FORCEINLINE unsigned int clz64(uint64_t x) CXXPH_NOEXCEPT
+{
+#if CXXPH_COMPILER_IS_GCC || CXXPH_COMPILER_IS_CLANG
+    return static_cast<unsigned int>(__builtin_clzll(x));
+#else
+    x |= (x >> 1);
+    x |= (x >> 2);
+    x |= (x >> 4);
+    x |= (x >> 8);
+    x |= (x >> 16);
+    x |= (x >> 32);
+    return 64 - popcount64(x);
+#endif
+}
+
+//
+// vector operations (32-bit lanes)
+//
+#if CXXPH_SIMD_USE_ARM_NEON
+CXXPH_FORCEINLINE i32x4 popcount32(const i32x4 &x) CXXPH_NOEXCEPT
+{
+    return vreinterpretq_s32_u32(vpaddlq_u16(vpaddlq_u8(vcntq_u8(vreinterpretq_u8_s32(x.v)))));
+}
+
+CXXPH_FORCEINLINE i32x4 clz32(const i32x4 &x) CXXPH_NOEXCEPT { return vclzq_s32(x.v); }
+
+CXXPH_FORCEINLINE i32x8 popcount32(const i32x8 &x) CXXPH_NOEXCEPT
+{
+    return simd::combine(popcount32(simd::low(x)), popcount32(simd::high(x)));
+}
+
+CXXPH_FORCEINLINE i32x8 clz32(const i32x8 &x) CXXPH_NOEXCEPT
+{
+    return simd::combine(clz32(simd::low(x)), clz32(simd::high(x)));
+}
+#else
+CXXPH_FORCEINLINE i32x8 popcount32(i32x8 x) CXXPH_NOEXCEPT
+{
+    x = x - (simd::srl<1>(x) & i32x8(0x55555555));
+    x = (x & i32x8(0x33333333)) + (simd::srl<2>(x) & i32x8(0x33333333));
+    x = (x + simd::srl<4>(x)) & i32x8(0x0f0f0f0f);
+    x = x + simd::srl<8>(x);
+    x = x + simd::srl<16>(x);
+    return x & i32x8(0x3f);
+}
+
+CXXPH_FORCEINLINE i32x8 clz32(i32x8 x) CXXPH_NOEXCEPT
+{
+#if CXXPH_SIMD_USE_X86_AVX512F && defined(__AVX512CD__) && defined(__AVX512VL__)
+    return _mm256_lzcnt_epi32(x.v);
+#else
+    // 32 - (number of bits below and including the highest set bit)
+    x = x | simd::srl<1>(x);
+    x = x | simd::srl<2>(x);
+    x = x | simd::srl<4>(x);
+    x = x | simd::srl<8>(x);
+    x = x | simd::srl<16>(x);
+    return i32x8(32) - popcount32(x);
+#endif
+}
+#endif
+
+CXXPH_FORCEINLINE i32x8 ctz32(const i32x8 &x) CXXPH_NOEXCEPT
+{
+    // bits below the lowest set bit (all bits for 0)
+    return popcount32((x ^ i32x8(-1)) & (x - i32x8(1)));
+}
+
+// the last partial vector is processed through a zero padded buffer
+template <typename Op>
+void transform_elementwise(uint32_t *dest, const uint32_t *src, std::size_t n, Op op)
+{
+    const std::size_t N = i32x8::num_lanes;
+    std::size_t i = 0;
+
+    for (; (i + N) <= n; i += N) {
+        op(i32x8::load(reinterpret_cast<const int32_t *>(&src[i]))).store(reinterpret_cast<int32_t *>(&dest[i]));
+    }
+
+    if (i < n) {
+        int32_t tmp[N] = { 0 };
+        std::memcpy(tmp, &src[i], sizeof(uint32_t) * (n - i));
+        op(i32x8::load(tmp)).store(tmp);
+        std::memcpy(&dest[i], tmp, sizeof(uint32_t) * (n - i));
+    }
+}
+
+struct popcount32_op {
+    i32x8 operator()(const i32x8 &x) const { return popcount32(x); }
+};
+
+struct clz32_op {
+    i32x8 operator()(const i32x8 &x) const { return clz32(x); }
+};
+
+struct ctz32_op {
+    i32x8 operator()(const i32x8 &x) const { return ctz32(x); }
+};
+
+//
+// bitmap scans; all-clear (or all-set) runs are skipped 256 bits at a time
+//
+const std::size_t WORDS_PER_VECTOR = sizeof(i32x8) / sizeof(uint64_t);
+
+CXXPH_FORCEINLINE bool all_equal(const uint64_t *words, int32_t value) CXXPH_NOEXCEPT
+{
+    return simd::all(simd::cmp_eq(i32x8::load(reinterpret_cast<const int32_t *>(words)), i32x8(value)));
+}
+
+template <bool Clear>
+std::size_t find_first(const uint64_t *bitmap, std::size_t num_words) CXXPH_NOEXCEPT
+{
+    const uint64_t flip = Clear ? ~0ull : 0ull;
+    std::size_t i = 0;
+
+    for (; (i + WORDS_PER_VECTOR) <= num_words; i += WORDS_PER_VECTOR) {
+        if (!all_equal(&bitmap[i], Clear ? -1 : 0)) {
+            break;
+        }
+    }
+
+    for (; i < num_words; ++i) {
+        const uint64_t w = bitmap[i] ^ flip;
+
+        if (w) {
+            return i * 64 + ctz64(w);
+        }
+    }
+
+    return npos;
+}
+
+} // namespace
+
+std::size_t count_ones_bitmap_kernel(const uint64_t *bitmap, std::size_t num_words)
+{
+    std::size_t i = 0;
+    std::size_t count = 0;
+
+#if CXXPH_SIMD_USE_X86_AVX2
+    // nibble lookup (pshufb) + byte sums (psadbw)
+    const __m256i lut = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2,
+                                         2, 3, 2, 3, 3, 4);
+    const __m256i low_mask = _mm256_set1_epi8(0x0f);
+    __m256i acc = _mm256_setzero_si256();
+
+    for (; (i + 4) <= num_words; i += 4) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&bitmap[i]));
+        const __m256i lo = _mm256_shuffle_epi8(lut, _mm256_and_si256(v, low_mask));
+        const __m256i hi = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256()));
+    }
+
+    CXXPH_ALIGNAS(32) uint64_t sums[4];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(sums), acc);
+    count = static_cast<std::size_t>(sums[0] + sums[1] + sums[2] + sums[3]);
+#elif CXXPH_SIMD_USE_ARM_NEON
+    // per byte counts (vcnt), summed into 16-bit lanes that grow by at most 16 per iteration,
+    // so they are widened every 2048 iterations (2048 * 16 = 32768 < 65536)
+    const std::size_t max_block_size = 2048;
+    uint32x4_t acc = vdupq_n_u32(0);
+
+    while ((i + 2) <= num_words) {
+        const std::size_t block_end = i + ((((num_words - i) / 2) < max_block_size) ? ((num_words - i) & ~1)
+                                                                                      : (max_block_size * 2));
+        uint16x8_t acc16 = vdupq_n_u16(0);
+
+        for (; i < block_end; i += 2) {
+            acc16 = vpadalq_u8(acc16, vcntq_u8(vld1q_u8(reinterpret_cast<const uint8_t *>(&bitmap[i]))));
+        }
+
+        acc = vpadalq_u16(acc, acc16);
+    }
+
+    const uint64x2_t acc64 = vpaddlq_u32(acc);
+    count = static_cast<std::size_t>(vgetq_lane_u64(acc64, 0) + vgetq_lane_u64(acc64, 1));
+#else
+    std::size_t c0 = 0, c1 = 0, c2 = 0, c3 = 0;
+
+    for (; (i + 4) <= num_words; i += 4) {
+        c0 += popcount64(bitmap[i + 0]);
+        c1 += popcount64(bitmap[i + 1]);
+        c2 += popcount64(bitmap[i + 2]);
+        c3 += popcount64(bitmap[i + 3]);
+    }
+
+    count = (c0 + c1) + (c2 + c3);
+#endif
+
+    for (; i < num_words; ++i) {
+        count += popcount64(bitmap[i]);
+    }
+
+    return count;
+}
+
+std::size_t find_first_set_kernel(const uint64_t *bitmap, std::size_t num_words)
+{
+    return find_first<false>(bitmap, num_words);
+}
+
+std::size_t find_first_clear_kernel(const uint64_t *bitmap, std::size_t num_words)
+{
+    return find_first<true>(bitmap, num_words);
+}
+
+std::size_t find_last_set_kernel(const uint64_t *bitmap, std::size_t num_words)
+{
+    std::size_t i = num_words;
+
+    for (; i >= WORDS_PER_VECTOR; i -= WORDS_PER_VECTOR) {
+        if (!all_equal(&bitmap[i - WORDS_PER_VECTOR], 0)) {
+            break;
+        }
+    }
+
+    while (i > 0) {
+        --i;
+
+        if (bitmap[i]) {
+            return i * 64 + (63 - clz64(bitmap[i]));
+        }
+    }
+
+    return npos;
+}
+
+std::size_t collect_set_bits_kernel(uint32_t *dest, const uint64_t *bitmap, std::size_t num_words)
+{
+    std::size_t count = 0;
+
+    for (std::size_t i = 0; i < num_words; ++i) {
+        const uint32_t base = static_cast<uint32_t>(i * 64);
+        uint64_t w = bitmap[i];
+
+        while (w) {
+            dest[count++] = base + ctz64(w);
+            w &= (w - 1); // clear the lowest set bit (BLSR)
+        }
+    }
+
+    return count;
+}
+
+void count_ones_elementwise_kernel(uint32_t *dest, const uint32_t *src, std::size_t n)
+{
+    transform_elementwise(dest, src, n, popcount32_op());
+}
+
+void count_leading_zeros_kernel(uint32_t *dest, const uint32_t *src, std::size_t n)
+{
+    transform_elementwise(dest, src, n, clz32_op());
+}
+
+void count_trailing_zeros_kernel(uint32_t *dest, const uint32_t *src, std::size_t n)
+{
+    transform_elementwise(dest, src, n, ctz32_op());
+}
+
+} // namespace CXXPH_KERNEL_ISA_NAMESPACE
+} // namespace bit_ops
+} // namespace cxxporthelper
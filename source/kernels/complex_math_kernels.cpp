@@ -0,0 +1,363 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include <cxxporthelper/impl/kernel_isa.hpp>
+
+#include <cstring>
+#include <cxxporthelper/simd_math.hpp>
+
+namespace cxxporthelper {
+namespace complex_math {
+namespace CXXPH_KERNEL_ISA_NAMESPACE {
+
+using simd::f32x8;
+
+namespace {
+
+// sign patterns applied to (real, imag) pairs
+const float k_sign_neg_real[8] = { -1.0f, 1.0f, -1.0f, 1.0f, -1.0f, 1.0f, -1.0f, 1.0f };
+const float k_sign_neg_imag[8] = { 1.0f, -1.0f, 1.0f, -1.0f, 1.0f, -1.0f, 1.0f, -1.0f };
+
+// interleaved complex multiplication (4 complex numbers per vector):
+//   a * b       = ar * (br, bi) + ai * (-bi, br)
+//   a * conj(b) = ar * (br, -bi) + ai * (bi, br)
+struct multiply_op {
+    f32x8 sign;
+
+    multiply_op() : sign(f32x8::load(k_sign_neg_real)) {}
+
+    f32x8 operator()(const f32x8 &a, const f32x8 &b) const
+    {
+        const f32x8 ar = simd::shuffle<0, 0, 2, 2>(a);
+        const f32x8 ai = simd::shuffle<1, 1, 3, 3>(a);
+        const f32x8 bs = simd::shuffle<1, 0, 3, 2>(b);
+        return simd::mul_add(ai * bs, sign, ar * b);
+    }
+};
+
+struct multiply_conj_op {
+    f32x8 sign;
+
+    multiply_conj_op() : sign(f32x8::load(k_sign_neg_imag)) {}
+
+    f32x8 operator()(const f32x8 &a, const f32x8 &b) const
+    {
+        const f32x8 ar = simd::shuffle<0, 0, 2, 2>(a);
+        const f32x8 ai = simd::shuffle<1, 1, 3, 3>(a);
+        const f32x8 bs = simd::shuffle<1, 0, 3, 2>(b);
+        return simd::mul_add(ar * b, sign, ai * bs);
+    }
+};
+
+// operations on the real / imaginary parts (8 complex numbers per vector)
+struct magnitude_op {
+    f32x8 operator()(const f32x8 &re, const f32x8 &im) const { return simd::sqrt(simd::mul_add(re, re, im * im)); }
+};
+
+struct squared_magnitude_op {
+    f32x8 operator()(const f32x8 &re, const f32x8 &im) const { return simd::mul_add(re, re, im * im); }
+};
+
+struct phase_op {
+    f32x8 operator()(const f32x8 &re, const f32x8 &im) const { return simd::atan2(im, re); }
+};
+
+// split layout operations (8 complex numbers per vector)
+struct multiply_split_op {
+    enum { reads_dest = 0 };
+
+    void operator()(const f32x8 &ar, const f32x8 &ai, const f32x8 &br, const f32x8 &bi, f32x8 *dr, f32x8 *di) const
+    {
+        (*dr) = simd::mul_add(ar, br, -(ai * bi));
+        (*di) = simd::mul_add(ar, bi, ai * br);
+    }
+};
+
+struct multiply_conj_split_op {
+    enum { reads_dest = 0 };
+
+    void operator()(const f32x8 &ar, const f32x8 &ai, const f32x8 &br, const f32x8 &bi, f32x8 *dr, f32x8 *di) const
+    {
+        (*dr) = simd::mul_add(ar, br, ai * bi);
+        (*di) = simd::mul_add(ai, br, -(ar * bi));
+    }
+};
+
+struct multiply_accumulate_split_op {
+    enum { reads_dest = 1 };
+
+    void operator()(const f32x8 &ar, const f32x8 &ai, const f32x8 &br, const f32x8 &bi, f32x8 *dr, f32x8 *di) const
+    {
+        (*dr) = simd::mul_add(ar, br, simd::mul_add(-ai, bi, *dr));
+        (*di) = simd::mul_add(ar, bi, simd::mul_add(ai, br, *di));
+    }
+};
+
+// the last partial vector is processed through a zero padded buffer,
+// so every element goes through the same code path
+
+template <typename Op>
+void transform_binary(float *dest, const float *a, const float *b, std::size_t n, const Op &op)
+{
+    const std::size_t N = f32x8::num_lanes;
+    const std::size_t nf = 2 * n;
+    std::size_t i = 0;
+
+    for (; (i + N) <= nf; i += N) {
+        op(f32x8::load(&a[i]), f32x8::load(&b[i])).store(&dest[i]);
+    }
+
+    if (i < nf) {
+        float tmp_a[N] = { 0.0f };
+        float tmp_b[N] = { 0.0f };
+        std::memcpy(tmp_a, &a[i], sizeof(float) * (nf - i));
+        std::memcpy(tmp_b, &b[i], sizeof(float) * (nf - i));
+        op(f32x8::load(tmp_a), f32x8::load(tmp_b)).store(tmp_a);
+        std::memcpy(&dest[i], tmp_a, sizeof(float) * (nf - i));
+    }
+}
+
+template <typename Op>
+void transform_to_real(float *dest, const float *src, std::size_t n, const Op &op)
+{
+    const std::size_t N = f32x8::num_lanes;
+    std::size_t i = 0;
+    f32x8 re, im;
+
+    for (; (i + N) <= n; i += N) {
+        simd::deinterleave(f32x8::load(&src[2 * i]), f32x8::load(&src[2 * i + N]), &re, &im);
+        op(re, im).store(&dest[i]);
+    }
+
+    if (i < n) {
+        float tmp[2 * N] = { 0.0f };
+        std::memcpy(tmp, &src[2 * i], sizeof(float) * 2 * (n - i));
+        simd::deinterleave(f32x8::load(&tmp[0]), f32x8::load(&tmp[N]), &re, &im);
+        op(re, im).store(tmp);
+        std::memcpy(&dest[i], tmp, sizeof(float) * (n - i));
+    }
+}
+
+template <typename Op>
+void transform_split_binary(float *dest_re, float *dest_im, const float *a_re, const float *a_im, const float *b_re,
+                            const float *b_im, std::size_t n, const Op &op)
+{
+    const std::size_t N = f32x8::num_lanes;
+    std::size_t i = 0;
+    f32x8 dr, di;
+
+    for (; (i + N) <= n; i += N) {
+        if (Op::reads_dest) {
+            dr = f32x8::load(&dest_re[i]);
+            di = f32x8::load(&dest_im[i]);
+        }
+        op(f32x8::load(&a_re[i]), f32x8::load(&a_im[i]), f32x8::load(&b_re[i]), f32x8::load(&b_im[i]), &dr, &di);
+        dr.store(&dest_re[i]);
+        di.store(&dest_im[i]);
+    }
+
+    if (i < n) {
+        const std::size_t size = sizeof(float) * (n - i);
+        float tmp[6][N] = { { 0.0f } };
+        std::memcpy(tmp[0], &a_re[i], size);
+        std::memcpy(tmp[1], &a_im[i], size);
+        std::memcpy(tmp[2], &b_re[i], size);
+        std::memcpy(tmp[3], &b_im[i], size);
+        if (Op::reads_dest) {
+            std::memcpy(tmp[4], &dest_re[i], size);
+            std::memcpy(tmp[5], &dest_im[i], size);
+        }
+        dr = f32x8::load(tmp[4]);
+        di = f32x8::load(tmp[5]);
+        op(f32x8::load(tmp[0]), f32x8::load(tmp[1]), f32x8::load(tmp[2]), f32x8::load(tmp[3]), &dr, &di);
+        dr.store(tmp[4]);
+        di.store(tmp[5]);
+        std::memcpy(&dest_re[i], tmp[4], size);
+        std::memcpy(&dest_im[i], tmp[5], size);
+    }
+}
+
+template <typename Op>
+void transform_split_to_real(float *dest, const float *src_re, const float *src_im, std::size_t n, const Op &op)
+{
+    const std::size_t N = f32x8::num_lanes;
+    std::size_t i = 0;
+
+    for (; (i + N) <= n; i += N) {
+        op(f32x8::load(&src_re[i]), f32x8::load(&src_im[i])).store(&dest[i]);
+    }
+
+    if (i < n) {
+        float tmp_re[N] = { 0.0f };
+        float tmp_im[N] = { 0.0f };
+        std::memcpy(tmp_re, &src_re[i], sizeof(float) * (n - i));
+        std::memcpy(tmp_im, &src_im[i], sizeof(float) * (n - i));
+        op(f32x8::load(tmp_re), f32x8::load(tmp_im)).store(tmp_re);
+        std::memcpy(&dest[i], tmp_re, sizeof(float) * (n - i));
+    }
+}
+
+} // namespace
+
+//
+// interleaved layout
+//
+
+void multiply_interleaved_kernel(float *dest, const float *a, const float *b, std::size_t n)
+{
+    transform_binary(dest, a, b, n, multiply_op());
+}
+
+void multiply_conj_interleaved_kernel(float *dest, const float *a, const float *b, std::size_t n)
+{
+    transform_binary(dest, a, b, n, multiply_conj_op());
+}
+
+void multiply_accumulate_interleaved_kernel(float *dest, const float *a, const float *b, std::size_t n)
+{
+    const std::size_t N = f32x8::num_lanes;
+    const std::size_t nf = 2 * n;
+    const f32x8 sign = f32x8::load(k_sign_neg_real);
+    std::size_t i = 0;
+
+    // dest + ar * (br, bi) + ai * (-bi, br)
+    for (; (i + N) <= nf; i += N) {
+        const f32x8 a_ = f32x8::load(&a[i]);
+        const f32x8 b_ = f32x8::load(&b[i]);
+        const f32x8 acc = simd::mul_add(simd::shuffle<0, 0, 2, 2>(a_), b_, f32x8::load(&dest[i]));
+        simd::mul_add(simd::shuffle<1, 1, 3, 3>(a_) * simd::shuffle<1, 0, 3, 2>(b_), sign, acc).store(&dest[i]);
+    }
+
+    if (i < nf) {
+        float tmp_a[N] = { 0.0f };
+        float tmp_b[N] = { 0.0f };
+        float tmp_dest[N] = { 0.0f };
+        std::memcpy(tmp_a, &a[i], sizeof(float) * (nf - i));
+        std::memcpy(tmp_b, &b[i], sizeof(float) * (nf - i));
+        std::memcpy(tmp_dest, &dest[i], sizeof(float) * (nf - i));
+        const f32x8 a_ = f32x8::load(tmp_a);
+        const f32x8 b_ = f32x8::load(tmp_b);
+        const f32x8 acc = simd::mul_add(simd::shuffle<0, 0, 2, 2>(a_), b_, f32x8::load(tmp_dest));
+        simd::mul_add(simd::shuffle<1, 1, 3, 3>(a_) * simd::shuffle<1, 0, 3, 2>(b_), sign, acc).store(tmp_dest);
+        std::memcpy(&dest[i], tmp_dest, sizeof(float) * (nf - i));
+    }
+}
+
+void magnitude_interleaved_kernel(float *dest, const float *src, std::size_t n)
+{
+    transform_to_real(dest, src, n, magnitude_op());
+}
+
+void squared_magnitude_interleaved_kernel(float *dest, const float *src, std::size_t n)
+{
+    transform_to_real(dest, src, n, squared_magnitude_op());
+}
+
+void phase_interleaved_kernel(float *dest, const float *src, std::size_t n)
+{
+    transform_to_real(dest, src, n, phase_op());
+}
+
+//
+// split layout
+//
+
+void multiply_split_kernel(float *dest_re, float *dest_im, const float *a_re, const float *a_im, const float *b_re,
+                           const float *b_im, std::size_t n)
+{
+    transform_split_binary(dest_re, dest_im, a_re, a_im, b_re, b_im, n, multiply_split_op());
+}
+
+void multiply_conj_split_kernel(float *dest_re, float *dest_im, const float *a_re, const float *a_im,
+                                const float *b_re, const float *b_im, std::size_t n)
+{
+    transform_split_binary(dest_re, dest_im, a_re, a_im, b_re, b_im, n, multiply_conj_split_op());
+}
+
+void multiply_accumulate_split_kernel(float *dest_re, float *dest_im, const float *a_re, const float *a_im,
+                                      const float *b_re, const float *b_im, std::size_t n)
+{
+    transform_split_binary(dest_re, dest_im, a_re, a_im, b_re, b_im, n, multiply_accumulate_split_op());
+}
+
+void magnitude_split_kernel(float *dest, const float *src_re, const float *src_im, std::size_t n)
+{
+    transform_split_to_real(dest, src_re, src_im, n, magnitude_op());
+}
+
+void squared_magnitude_split_kernel(float *dest, const float *src_re, const float *src_im, std::size_t n)
+{
+    transform_split_to_real(dest, src_re, src_im, n, squared_magnitude_op());
+}
+
+void phase_split_kernel(float *dest, const float *src_re, const float *src_im, std::size_t n)
+{
+    transform_split_to_real(dest, src_re, src_im, n, phase_op());
+}
+
+//
+// layout conversion
+//
+
+void interleaved_to_split_kernel(float *dest_re, float *dest_im, const float *src, std::size_t n)
+{
+    const std::size_t N = f32x8::num_lanes;
+    std::size_t i = 0;
+    f32x8 re, im;
+
+    for (; (i + N) <= n; i += N) {
+        simd::deinterleave(f32x8::load(&src[2 * i]), f32x8::load(&src[2 * i + N]), &re, &im);
+        re.store(&dest_re[i]);
+        im.store(&dest_im[i]);
+    }
+
+    if (i < n) {
+        float tmp[2 * N] = { 0.0f };
+        std::memcpy(tmp, &src[2 * i], sizeof(float) * 2 * (n - i));
+        simd::deinterleave(f32x8::load(&tmp[0]), f32x8::load(&tmp[N]), &re, &im);
+        re.store(&tmp[0]);
+        im.store(&tmp[N]);
+        std::memcpy(&dest_re[i], &tmp[0], sizeof(float) * (n - i));
+        std::memcpy(&dest_im[i], &tmp[N], sizeof(float) * (n - i));
+    }
+}
+
+void split_to_interleaved_kernel(float *dest, const float *src_re, const float *src_im, std::size_t n)
+{
+    const std::size_t N = f32x8::num_lanes;
+    std::size_t i = 0;
+    f32x8 lo, hi;
+
+    for (; (i + N) <= n; i += N) {
+        simd::interleave(f32x8::load(&src_re[i]), f32x8::load(&src_im[i]), &lo, &hi);
+        lo.store(&dest[2 * i]);
+        hi.store(&dest[2 * i + N]);
+    }
+
+    if (i < n) {
+        float tmp[2 * N] = { 0.0f };
+        std::memcpy(&tmp[0], &src_re[i], sizeof(float) * (n - i));
+        std::memcpy(&tmp[N], &src_im[i], sizeof(float) * (n - i));
+        simd::interleave(f32x8::load(&tmp[0]), f32x8::load(&tmp[N]), &lo, &hi);
+        lo.store(&tmp[0]);
+        hi.store(&tmp[N]);
+        std::memcpy(&dest[2 * i], tmp, sizeof(float) * 2 * (n - i));
+    }
+}
+
+} // namespace CXXPH_KERNEL_ISA_NAMESPACE
+} // namespace complex_math
+} // namespace cxxporthelper
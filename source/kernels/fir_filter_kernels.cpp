@@ -0,0 +1,269 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+
+#include <cxxporthelper/impl/kernel_isa.hpp>
+
+#include <cstring>
+
+#if CXXPH_KERNEL_ISA == CXXPH_KERNEL_ISA_ARM_NEON
+#include <cxxporthelper/arm_neon.hpp>
+#endif
+
+namespace cxxporthelper {
+namespace fir_filter {
+namespace CXXPH_KERNEL_ISA_NAMESPACE {
+
+using simd::f32x4;
+using simd::f32x8;
+
+namespace {
+
+const std::size_t N = f32x8::num_lanes;
+
+// number of output vectors computed at once by the direct form (hides the multiply-add latency)
+const std::size_t NUM_ACCUMULATORS = 4;
+
+// c + a * (lane L of b)
+template <int L>
+inline f32x8 mul_add_lane(const f32x8 &a, const f32x4 &b, const f32x8 &c) CXXPH_NOEXCEPT
+{
+#if CXXPH_KERNEL_ISA == CXXPH_KERNEL_ISA_ARM_NEON
+    // multiply-accumulate by element (vmla.f32 qd, qn, dm[x] / fmla vd.4s, vn.4s, vm.s[x]), b is not broadcasted
+    const float32x2_t b_half = (L < 2) ? vget_low_f32(b.v) : vget_high_f32(b.v);
+
+    return simd::combine(f32x4(vmlaq_lane_f32_compat(simd::low(c).v, simd::low(a).v, b_half, (L & 1))),
+                         f32x4(vmlaq_lane_f32_compat(simd::high(c).v, simd::high(a).v, b_half, (L & 1))));
+#else
+    const f32x4 t = simd::shuffle<L, L, L, L>(b);
+
+    return simd::mul_add(a, simd::combine(t, t), c);
+#endif
+}
+
+//
+// Direct form
+//
+//   dest[i] = sum(coeffs[k] * src[i + (num_taps - 1 - k) * stride]) for k in [0, num_taps)
+//
+// R output vectors per call, 4 taps per step (one coefficient vector, used by lane)
+//
+template <std::size_t R>
+inline void direct_form_block(float *dest, const float *src, std::size_t stride, const float *coeffs,
+                              std::size_t num_taps) CXXPH_NOEXCEPT
+{
+    const float *x = &src[(num_taps - 1) * stride];
+    f32x8 acc[R];
+    std::size_t k = 0;
+
+    for (std::size_t r = 0; r < R; ++r) {
+        acc[r] = f32x8::zero();
+    }
+
+    for (; (k + 4) <= num_taps; k += 4) {
+        const f32x4 c = f32x4::load(&coeffs[k]);
+        const float *x0 = x - k * stride;
+        const float *x1 = x0 - stride;
+        const float *x2 = x1 - stride;
+        const float *x3 = x2 - stride;
+
+        for (std::size_t r = 0; r < R; ++r) {
+            acc[r] = mul_add_lane<0>(f32x8::load(&x0[r * N]), c, acc[r]);
+        }
+        for (std::size_t r = 0; r < R; ++r) {
+            acc[r] = mul_add_lane<1>(f32x8::load(&x1[r * N]), c, acc[r]);
+        }
+        for (std::size_t r = 0; r < R; ++r) {
+            acc[r] = mul_add_lane<2>(f32x8::load(&x2[r * N]), c, acc[r]);
+        }
+        for (std::size_t r = 0; r < R; ++r) {
+            acc[r] = mul_add_lane<3>(f32x8::load(&x3[r * N]), c, acc[r]);
+        }
+    }
+
+    for (; k < num_taps; ++k) {
+        const f32x8 c(coeffs[k]);
+        const float *xk = x - k * stride;
+
+        for (std::size_t r = 0; r < R; ++r) {
+            acc[r] = simd::mul_add(f32x8::load(&xk[r * N]), c, acc[r]);
+        }
+    }
+
+    for (std::size_t r = 0; r < R; ++r) {
+        acc[r].store(&dest[r * N]);
+    }
+}
+
+//
+// Block transposed form
+//
+// For a block of 4 input samples x[0 .. 4) and the partial sums s[0 .. L)
+// (L = num_taps - 1):
+//
+//   y[q]  = s[q] + sum(h[q - p] * x[p]) for p in [0, q]
+//   s'[k] = s[k + 4] + sum(h[k + 4 - q] * x[q]) for q in [0, 4)
+//
+// where s[k] = 0 for k >= L and h[k] = 0 for k >= num_taps. s' is computed
+// in place in ascending order (s[k + 4] is read before it is overwritten).
+//
+// Up to MAX_PADDED_STATE_SIZE, the partial sums and the coefficients are
+// copied to zero padded buffers, so the vectors cover s' entirely (the
+// padding stays zero, as h is zero there). Longer state is updated in place,
+// the last elements by scalar code.
+//
+const std::size_t MAX_PADDED_STATE_SIZE = 512;
+const std::size_t STATE_PADDING = N + 4;
+
+inline std::size_t round_up(std::size_t x, std::size_t a) CXXPH_NOEXCEPT { return (x + (a - 1)) / a * a; }
+
+inline std::size_t num_full_vectors(std::size_t size, std::size_t offset) CXXPH_NOEXCEPT
+{
+    // elements covered by the vectors that do not read beyond [0, size) at +offset
+    return (size >= (N + offset)) ? (((size - (N + offset)) / N + 1) * N) : 0;
+}
+
+// NOTE: s[0 .. 4) and h[0 .. 4) must be readable (zero padded if L < 4)
+void transposed_form_block4(float *dest, const float *src, float *s, const float *h, std::size_t num_taps,
+                            std::size_t num_vector_elements) CXXPH_NOEXCEPT
+{
+    const std::size_t L = num_taps - 1;
+    const f32x4 xv = f32x4::load(src);
+    const float x0 = src[0], x1 = src[1], x2 = src[2], x3 = src[3];
+    const float y0 = s[0] + h[0] * x0;
+    const float y1 = s[1] + h[1] * x0 + h[0] * x1;
+    const float y2 = s[2] + h[2] * x0 + h[1] * x1 + h[0] * x2;
+    const float y3 = s[3] + h[3] * x0 + h[2] * x1 + h[1] * x2 + h[0] * x3;
+    std::size_t k = 0;
+
+    for (; k < num_vector_elements; k += N) {
+        f32x8 acc = f32x8::load(&s[k + 4]);
+
+        acc = mul_add_lane<0>(f32x8::load(&h[k + 4]), xv, acc);
+        acc = mul_add_lane<1>(f32x8::load(&h[k + 3]), xv, acc);
+        acc = mul_add_lane<2>(f32x8::load(&h[k + 2]), xv, acc);
+        acc = mul_add_lane<3>(f32x8::load(&h[k + 1]), xv, acc);
+
+        acc.store(&s[k]);
+    }
+
+    for (; k < L; ++k) {
+        float acc = ((k + 4) < L) ? s[k + 4] : 0.0f;
+
+        for (std::size_t q = 0; q < 4; ++q) {
+            if ((k + 4 - q) < num_taps) {
+                acc += h[k + 4 - q] * src[q];
+            }
+        }
+
+        s[k] = acc;
+    }
+
+    dest[0] = y0;
+    dest[1] = y1;
+    dest[2] = y2;
+    dest[3] = y3;
+}
+
+void transposed_form_sample(float *dest, const float *src, float *s, const float *h, std::size_t num_taps,
+                            std::size_t num_vector_elements) CXXPH_NOEXCEPT
+{
+    const std::size_t L = num_taps - 1;
+    const float x = *src;
+    const float y = ((L > 0) ? s[0] : 0.0f) + h[0] * x;
+    const f32x8 xv(x);
+    std::size_t k = 0;
+
+    for (; k < num_vector_elements; k += N) {
+        simd::mul_add(f32x8::load(&h[k + 1]), xv, f32x8::load(&s[k + 1])).store(&s[k]);
+    }
+
+    for (; k < L; ++k) {
+        s[k] = (((k + 1) < L) ? s[k + 1] : 0.0f) + h[k + 1] * x;
+    }
+
+    *dest = y;
+}
+
+void transposed_form(float *dest, const float *src, float *s, const float *h, std::size_t num_taps,
+                     std::size_t num_vector_elements_block4, std::size_t num_vector_elements_sample,
+                     std::size_t n) CXXPH_NOEXCEPT
+{
+    std::size_t i = 0;
+
+    for (; (i + 4) <= n; i += 4) {
+        transposed_form_block4(&dest[i], &src[i], s, h, num_taps, num_vector_elements_block4);
+    }
+
+    for (; i < n; ++i) {
+        transposed_form_sample(&dest[i], &src[i], s, h, num_taps, num_vector_elements_sample);
+    }
+}
+
+} // namespace
+
+void direct_form_kernel(float *dest, const float *src, std::size_t stride, const float *coeffs, std::size_t num_taps,
+                        std::size_t n)
+{
+    std::size_t i = 0;
+
+    for (; (i + NUM_ACCUMULATORS * N) <= n; i += NUM_ACCUMULATORS * N) {
+        direct_form_block<NUM_ACCUMULATORS>(&dest[i], &src[i], stride, coeffs, num_taps);
+    }
+
+    for (; (i + N) <= n; i += N) {
+        direct_form_block<1>(&dest[i], &src[i], stride, coeffs, num_taps);
+    }
+
+    for (; i < n; ++i) {
+        const float *x = &src[i + (num_taps - 1) * stride];
+        float acc = 0.0f;
+
+        for (std::size_t k = 0; k < num_taps; ++k) {
+            acc += coeffs[k] * x[-static_cast<std::ptrdiff_t>(k * stride)];
+        }
+
+        dest[i] = acc;
+    }
+}
+
+void transposed_form_kernel(float *dest, const float *src, const float *coeffs, std::size_t num_taps, float *state,
+                            std::size_t n)
+{
+    const std::size_t L = num_taps - 1;
+
+    if (L <= MAX_PADDED_STATE_SIZE) {
+        float s[MAX_PADDED_STATE_SIZE + STATE_PADDING];
+        float h[MAX_PADDED_STATE_SIZE + STATE_PADDING];
+        const std::size_t num_vector_elements = round_up(L, N);
+        const std::size_t padded_size = num_vector_elements + STATE_PADDING;
+
+        std::memcpy(s, state, L * sizeof(float));
+        std::memset(&s[L], 0, (padded_size - L) * sizeof(float));
+        std::memcpy(h, coeffs, num_taps * sizeof(float));
+        std::memset(&h[num_taps], 0, (padded_size - num_taps) * sizeof(float));
+
+        transposed_form(dest, src, s, h, num_taps, num_vector_elements, num_vector_elements, n);
+
+        std::memcpy(state, s, L * sizeof(float));
+    } else {
+        transposed_form(dest, src, state, coeffs, num_taps, num_full_vectors(L, 4), num_full_vectors(L, 1), n);
+    }
+}
+
+} // namespace CXXPH_KERNEL_ISA_NAMESPACE
+} // namespace fir_filter
+} // namespace cxxporthelper
@@ -0,0 +1,167 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include <cxxporthelper/impl/kernel_isa.hpp>
+
+#include <cstring>
+#include <cxxporthelper/fixed_point.hpp>
+
+namespace cxxporthelper {
+namespace fixed_point {
+namespace CXXPH_KERNEL_ISA_NAMESPACE {
+
+using simd::i16x8;
+using simd::i32x8;
+
+namespace {
+
+// Q15: i16x8, Q31: i32x8
+template <typename T>
+struct vec_of;
+
+template <>
+struct vec_of<int16_t> {
+    typedef i16x8 type;
+};
+
+template <>
+struct vec_of<int32_t> {
+    typedef i32x8 type;
+};
+
+struct multiply_op {
+    enum { reads_dest = 0 };
+
+    template <typename V>
+    V operator()(const V &a, const V &b, const V &) const
+    {
+        return simd::mul_round_high(a, b);
+    }
+};
+
+struct multiply_accumulate_op {
+    enum { reads_dest = 1 };
+
+    template <typename V>
+    V operator()(const V &a, const V &b, const V &d) const
+    {
+        return simd::add_sat(d, simd::mul_round_high(a, b));
+    }
+};
+
+struct add_op {
+    enum { reads_dest = 0 };
+
+    template <typename V>
+    V operator()(const V &a, const V &b, const V &) const
+    {
+        return simd::add_sat(a, b);
+    }
+};
+
+struct subtract_op {
+    enum { reads_dest = 0 };
+
+    template <typename V>
+    V operator()(const V &a, const V &b, const V &) const
+    {
+        return simd::sub_sat(a, b);
+    }
+};
+
+// the last partial vector is processed through a zero padded buffer,
+// so every element goes through the same code path
+
+template <typename T, typename Op>
+void transform_binary(T *dest, const T *a, const T *b, std::size_t n, const Op &op)
+{
+    typedef typename vec_of<T>::type V;
+    const std::size_t N = V::num_lanes;
+    std::size_t i = 0;
+    V d = V::zero();
+
+    for (; (i + N) <= n; i += N) {
+        if (Op::reads_dest) {
+            d = V::load(&dest[i]);
+        }
+        op(V::load(&a[i]), V::load(&b[i]), d).store(&dest[i]);
+    }
+
+    if (i < n) {
+        const std::size_t size = sizeof(T) * (n - i);
+        T tmp[3][N] = { { 0 } };
+        std::memcpy(tmp[0], &a[i], size);
+        std::memcpy(tmp[1], &b[i], size);
+        if (Op::reads_dest) {
+            std::memcpy(tmp[2], &dest[i], size);
+        }
+        op(V::load(tmp[0]), V::load(tmp[1]), V::load(tmp[2])).store(tmp[2]);
+        std::memcpy(&dest[i], tmp[2], size);
+    }
+}
+
+template <typename T>
+void scale_array(T *dest, const T *src, T gain, std::size_t n)
+{
+    typedef typename vec_of<T>::type V;
+    const std::size_t N = V::num_lanes;
+    const V g(gain);
+    std::size_t i = 0;
+
+    for (; (i + N) <= n; i += N) {
+        simd::mul_round_high(V::load(&src[i]), g).store(&dest[i]);
+    }
+
+    if (i < n) {
+        const std::size_t size = sizeof(T) * (n - i);
+        T tmp[N] = { 0 };
+        std::memcpy(tmp, &src[i], size);
+        simd::mul_round_high(V::load(tmp), g).store(tmp);
+        std::memcpy(&dest[i], tmp, size);
+    }
+}
+
+} // namespace
+
+#define CXXPH_FIXED_POINT_DEFINE_BINARY_KERNELS(name)                                                                  \
+    void name##_q15_kernel(int16_t *dest, const int16_t *a, const int16_t *b, std::size_t n)                           \
+    {                                                                                                                  \
+        transform_binary(dest, a, b, n, name##_op());                                                                  \
+    }                                                                                                                  \
+                                                                                                                       \
+    void name##_q31_kernel(int32_t *dest, const int32_t *a, const int32_t *b, std::size_t n)                           \
+    {                                                                                                                  \
+        transform_binary(dest, a, b, n, name##_op());                                                                  \
+    }
+
+CXXPH_FIXED_POINT_DEFINE_BINARY_KERNELS(multiply)
+CXXPH_FIXED_POINT_DEFINE_BINARY_KERNELS(multiply_accumulate)
+CXXPH_FIXED_POINT_DEFINE_BINARY_KERNELS(add)
+CXXPH_FIXED_POINT_DEFINE_BINARY_KERNELS(subtract)
+
+void scale_q15_kernel(int16_t *dest, const int16_t *src, int16_t gain, std::size_t n)
+{
+    scale_array(dest, src, gain, n);
+}
+
+void scale_q31_kernel(int32_t *dest, const int32_t *src, int32_t gain, std::size_t n)
+{
+    scale_array(dest, src, gain, n);
+}
+
+} // namespace CXXPH_KERNEL_ISA_NAMESPACE
+} // namespace fixed_point
+} // namespace cxxporthelper
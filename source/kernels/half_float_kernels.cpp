@@ -0,0 +1,165 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include <cxxporthelper/impl/kernel_isa.hpp>
+
+#include <cstring>
+#include <cxxporthelper/half_float.hpp>
+
+#if CXXPH_SIMD_USE_ARM_NEON
+#include <cxxporthelper/arm_neon.hpp>
+#endif
+
+namespace cxxporthelper {
+namespace half_float {
+namespace CXXPH_KERNEL_ISA_NAMESPACE {
+
+using simd::f32x4;
+using simd::f32x8;
+using simd::i16x8;
+using simd::i32x4;
+using simd::i32x8;
+
+namespace {
+
+const std::size_t N = f32x8::num_lanes;
+
+#if CXXPH_SIMD_USE_X86_F16C
+CXXPH_FORCEINLINE f32x8 load_half(const uint16_t *src) CXXPH_NOEXCEPT
+{
+    return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src)));
+}
+
+CXXPH_FORCEINLINE void store_half(uint16_t *dest, const f32x8 &x) CXXPH_NOEXCEPT
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dest), _mm256_cvtps_ph(x.v, _MM_FROUND_TO_NEAREST_INT));
+}
+#elif CXXPH_SIMD_USE_ARM_NEON && CXXPH_SIMD_USE_ARM64
+CXXPH_FORCEINLINE f32x4 load_half4(const uint16_t *src) CXXPH_NOEXCEPT
+{
+    return vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(src)));
+}
+
+CXXPH_FORCEINLINE void store_half4(uint16_t *dest, const f32x4 &x) CXXPH_NOEXCEPT
+{
+    vst1_u16(dest, vreinterpret_u16_f16(vcvt_f16_f32(x.v)));
+}
+
+CXXPH_FORCEINLINE f32x8 load_half(const uint16_t *src) CXXPH_NOEXCEPT
+{
+    return simd::combine(load_half4(src), load_half4(src + 4));
+}
+
+CXXPH_FORCEINLINE void store_half(uint16_t *dest, const f32x8 &x) CXXPH_NOEXCEPT
+{
+    store_half4(dest, simd::low(x));
+    store_half4(dest + 4, simd::high(x));
+}
+#else
+// bit manipulation (the subnormals are rounded by float additions, so the
+// default rounding mode is assumed)
+
+CXXPH_FORCEINLINE f32x8 load_half(const uint16_t *src) CXXPH_NOEXCEPT
+{
+    const i16x8 h16 = i16x8::load(reinterpret_cast<const int16_t *>(src));
+    const i32x8 h = simd::combine(simd::to_i32_lo(h16), simd::to_i32_hi(h16)) & i32x8(0xffff);
+    const i32x8 shifted_exp(0x7c00 << 13);
+    const i32x8 abs_h = h & i32x8(0x7fff);
+
+    // exponent rebias (127 - 15)
+    const i32x8 o = simd::shl<13>(abs_h) + i32x8((127 - 15) << 23);
+    const i32x8 exp = simd::shl<13>(abs_h) & shifted_exp;
+
+    // inf / NaN: exponent 0xff (NaNs quieted)
+    const i32x8 quiet = simd::select(simd::cmp_gt(abs_h, i32x8(0x7c00)), i32x8(0x00400000), i32x8::zero());
+    const i32x8 inf_nan = (o + i32x8((128 - 16) << 23)) | quiet;
+
+    // zero / subnormal: renormalize through a float subtraction
+    const f32x8 magic = simd::bitcast_f32(i32x8(113 << 23));
+    const i32x8 subnormal = simd::bitcast_i32(simd::bitcast_f32(o + i32x8(1 << 23)) - magic);
+
+    const i32x8 r = simd::select(simd::cmp_eq(exp, shifted_exp), inf_nan,
+                                 simd::select(simd::cmp_eq(exp, i32x8::zero()), subnormal, o));
+
+    return simd::bitcast_f32(r | simd::shl<16>(h & i32x8(0x8000)));
+}
+
+CXXPH_FORCEINLINE void store_half(uint16_t *dest, const f32x8 &x) CXXPH_NOEXCEPT
+{
+    const i32x8 bits = simd::bitcast_i32(x);
+    const i32x8 u = bits & i32x8(0x7fffffff);
+
+    // overflow -> inf, NaN -> quiet NaN (upper payload bits kept)
+    const i32x8 nan = i32x8(0x7e00) | (simd::srl<13>(u) & i32x8(0x3ff));
+    const i32x8 inf_nan = simd::select(simd::cmp_gt(u, i32x8(0x7f800000)), nan, i32x8(0x7c00));
+
+    // subnormal: let the float addition round the mantissa
+    const i32x8 denorm_magic(((127 - 15) + (23 - 10) + 1) << 23);
+    const i32x8 subnormal = simd::bitcast_i32(simd::bitcast_f32(u) + simd::bitcast_f32(denorm_magic)) - denorm_magic;
+
+    // normal: rebias (15 - 127 = -112), round to nearest even
+    const i32x8 mant_odd = simd::srl<13>(u) & i32x8(1);
+    const i32x8 normal = simd::srl<13>(u + i32x8(-(112 << 23) + 0xfff) + mant_odd);
+
+    const i32x8 r = simd::select(simd::cmp_lt(u, i32x8(113 << 23)), subnormal,
+                                 simd::select(simd::cmp_lt(u, i32x8((127 + 16) << 23)), normal, inf_nan)) |
+                    simd::srl<16>(bits & i32x8(0x80000000));
+
+    // [0, 0xffff] -> sign extended 16-bit values, so the saturating pack keeps them as is
+    const i32x8 s = simd::sra<16>(simd::shl<16>(r));
+    simd::pack_sat(simd::low(s), simd::high(s)).store(reinterpret_cast<int16_t *>(dest));
+}
+#endif
+
+} // namespace
+
+void to_float_kernel(float *dest, const uint16_t *src, std::size_t n)
+{
+    std::size_t i = 0;
+
+    for (; (i + N) <= n; i += N) {
+        load_half(&src[i]).store(&dest[i]);
+    }
+
+    if (i < n) {
+        uint16_t tmp_src[N] = { 0 };
+        float tmp_dest[N];
+        std::memcpy(tmp_src, &src[i], sizeof(uint16_t) * (n - i));
+        load_half(tmp_src).store(tmp_dest);
+        std::memcpy(&dest[i], tmp_dest, sizeof(float) * (n - i));
+    }
+}
+
+void from_float_kernel(uint16_t *dest, const float *src, std::size_t n)
+{
+    std::size_t i = 0;
+
+    for (; (i + N) <= n; i += N) {
+        store_half(&dest[i], f32x8::load(&src[i]));
+    }
+
+    if (i < n) {
+        float tmp_src[N] = { 0.0f };
+        uint16_t tmp_dest[N];
+        std::memcpy(tmp_src, &src[i], sizeof(float) * (n - i));
+        store_half(tmp_dest, f32x8::load(tmp_src));
+        std::memcpy(&dest[i], tmp_dest, sizeof(uint16_t) * (n - i));
+    }
+}
+
+} // namespace CXXPH_KERNEL_ISA_NAMESPACE
+} // namespace half_float
+} // namespace cxxporthelper
@@ -0,0 +1,749 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+
+#include <cxxporthelper/impl/kernel_isa.hpp>
+
+#include <cmath>
+#include <cstring>
+
+#if CXXPH_COMPILER_IS_MSVC
+#include <cstdlib>
+#endif
+
+namespace cxxporthelper {
+namespace pcm_format {
+namespace CXXPH_KERNEL_ISA_NAMESPACE {
+
+using simd::f32x8;
+using simd::i32x8;
+using simd::i16x8;
+
+namespace {
+
+const std::size_t N = f32x8::num_lanes;
+
+template <bool Round>
+inline i32x8 float_to_int(const f32x8 &x, float lo, float hi) CXXPH_NOEXCEPT
+{
+    const f32x8 y = simd::min(simd::max(x, f32x8(lo)), f32x8(hi));
+
+    if (Round) {
+        return simd::round_to_i32(y);
+    }
+
+    // to_i32() truncates toward zero
+    const f32x8 t = simd::to_f32(simd::to_i32(y));
+    return simd::to_i32(simd::select(simd::cmp_gt(t, y), t - f32x8(1.0f), t));
+}
+
+template <bool Round>
+inline int32_t double_to_int(double x, double lo, double hi) CXXPH_NOEXCEPT
+{
+    // NOTE: NaN is mapped to lo
+    const double y = (x >= lo) ? ((x <= hi) ? x : hi) : lo;
+    return static_cast<int32_t>(Round ? std::nearbyint(y) : std::floor(y));
+}
+
+//
+// S24_PACKED <-> 32 bit lanes
+//
+// 4 samples are packed into 3 words (w0 w1 w2, little endian):
+//
+//   lane 0: w0 << 8
+//   lane 1: ((w0 >> 16) & 0x0000ff00) | (w1 << 16)
+//   lane 2: ((w1 >> 8)  & 0x00ffff00) | (w2 << 24)
+//   lane 3: w2 & 0xffffff00
+//
+// The lanes are shifted and masked as whole vectors to avoid building the
+// vectors from scalars (store forwarding stalls).
+//
+// NOTE: assumes a little endian host
+//
+const int32_t k_s24_mask[9][8] = {
+    { -1, 0, 0, 0, -1, 0, 0, 0 },
+    { 0, 0x0000ff00, 0, 0, 0, 0x0000ff00, 0, 0 },
+    { 0, 0, 0x00ffff00, 0, 0, 0, 0x00ffff00, 0 },
+    { 0, 0, 0, -256, 0, 0, 0, -256 },
+    { 0, -1, 0, 0, 0, -1, 0, 0 },
+    { 0, 0, -1, 0, 0, 0, -1, 0 },
+    { 0x00ffffff, 0, 0, 0, 0x00ffffff, 0, 0, 0 },
+    { 0, 0x0000ffff, 0, 0, 0, 0x0000ffff, 0, 0 },
+    { 0, 0, 0x000000ff, 0, 0, 0, 0x000000ff, 0 },
+};
+
+inline i32x8 s24_mask(int i) CXXPH_NOEXCEPT { return i32x8::load(k_s24_mask[i]); }
+
+// 8 samples -> left-justified 32 bit integers
+inline i32x8 load_s24(const unsigned char *src) CXXPH_NOEXCEPT
+{
+    int32_t w_lo[4];
+    int32_t w_hi[4];
+
+    // words 0-3 (samples 0-3) and words 2-5 (samples 4-7, in words 3-5)
+    std::memcpy(w_lo, &src[0], 16);
+    std::memcpy(w_hi, &src[8], 16);
+
+    const simd::i32x4 v_lo = simd::i32x4::load(w_lo);
+    const simd::i32x4 v_hi = simd::i32x4::load(w_hi);
+
+    // a: (w0, w0, w1, w2), b: (w0, w1, w2, w2) of each group of 4 samples
+    const i32x8 a = simd::combine(simd::shuffle<0, 0, 1, 2>(v_lo), simd::shuffle<1, 1, 2, 3>(v_hi));
+    const i32x8 b = simd::combine(simd::shuffle<0, 1, 2, 2>(v_lo), simd::shuffle<1, 2, 3, 3>(v_hi));
+
+    return (simd::shl<8>(a) & s24_mask(0)) | (simd::srl<16>(a) & s24_mask(1)) | (simd::srl<8>(a) & s24_mask(2)) |
+           (a & s24_mask(3)) | (simd::shl<16>(b) & s24_mask(4)) | (simd::shl<24>(b) & s24_mask(5));
+}
+
+// 8 samples <- right-justified 24 bit integers
+inline void store_s24(unsigned char *dest, const i32x8 &x) CXXPH_NOEXCEPT
+{
+    // words of each group of 4 samples in lanes 0-2, from x: (t0, t1, t2, -) and y: (t1, t2, t3, -)
+    const i32x8 y = simd::shuffle<1, 2, 3, 3>(x);
+    const i32x8 w = (x & s24_mask(6)) | (simd::srl<8>(x) & s24_mask(7)) | (simd::srl<16>(x) & s24_mask(8)) |
+                    (simd::shl<24>(y) & s24_mask(0)) | (simd::shl<16>(y) & s24_mask(4)) |
+                    (simd::shl<8>(y) & s24_mask(5));
+    int32_t w_lo[4];
+    int32_t w_hi[4];
+
+    simd::low(w).store(w_lo);
+    simd::high(w).store(w_hi);
+
+    std::memcpy(&dest[0], w_lo, 12);
+    std::memcpy(&dest[12], w_hi, 12);
+}
+
+//
+// Sample formats
+//
+// Integer formats are loaded as / stored from left-justified 32 bit integers
+// (load_i32() / store_i32()), so integer to integer conversions only differ
+// in the shift amount. F32 is loaded as is (load_f32()) and stored to the
+// integer formats by store_f32(). The F64 conversions are done per sample
+// through load_f64() / store_f64().
+//
+struct s16_format {
+    enum { sample_size = 2 };
+
+    static i32x8 load_i32(const unsigned char *src) CXXPH_NOEXCEPT
+    {
+        const i16x8 x = i16x8::load(reinterpret_cast<const int16_t *>(src));
+        return simd::shl<16>(simd::combine(simd::to_i32_lo(x), simd::to_i32_hi(x)));
+    }
+
+    template <bool Round>
+    static void store_i32(unsigned char *dest, const i32x8 &x) CXXPH_NOEXCEPT
+    {
+        i32x8 y = simd::sra<16>(x);
+
+        if (Round) {
+            y += (simd::srl<15>(x) & i32x8(1));
+        }
+
+        simd::pack_sat(simd::low(y), simd::high(y)).store(reinterpret_cast<int16_t *>(dest));
+    }
+
+    template <bool Round>
+    static void store_f32(unsigned char *dest, const f32x8 &x) CXXPH_NOEXCEPT
+    {
+        const i32x8 y = float_to_int<Round>(x * f32x8(32768.0f), -32768.0f, 32767.0f);
+        simd::pack_sat(simd::low(y), simd::high(y)).store(reinterpret_cast<int16_t *>(dest));
+    }
+
+    static double load_f64(const unsigned char *src) CXXPH_NOEXCEPT
+    {
+        return *reinterpret_cast<const int16_t *>(src) * (1.0 / 32768.0);
+    }
+
+    template <bool Round>
+    static void store_f64(unsigned char *dest, double x) CXXPH_NOEXCEPT
+    {
+        *reinterpret_cast<int16_t *>(dest) = static_cast<int16_t>(double_to_int<Round>(x * 32768.0, -32768.0, 32767.0));
+    }
+};
+
+struct s24_format {
+    enum { sample_size = 3 };
+
+    static i32x8 load_i32(const unsigned char *src) CXXPH_NOEXCEPT { return load_s24(src); }
+
+    template <bool Round>
+    static void store_i32(unsigned char *dest, const i32x8 &x) CXXPH_NOEXCEPT
+    {
+        i32x8 y = simd::sra<8>(x);
+
+        if (Round) {
+            y = simd::min(y + (simd::srl<7>(x) & i32x8(1)), i32x8(0x7fffff));
+        }
+
+        store_s24(dest, y);
+    }
+
+    template <bool Round>
+    static void store_f32(unsigned char *dest, const f32x8 &x) CXXPH_NOEXCEPT
+    {
+        store_s24(dest, float_to_int<Round>(x * f32x8(8388608.0f), -8388608.0f, 8388607.0f));
+    }
+
+    static double load_f64(const unsigned char *src) CXXPH_NOEXCEPT
+    {
+        const int32_t x = static_cast<int32_t>((static_cast<uint32_t>(src[0]) << 8) |
+                                               (static_cast<uint32_t>(src[1]) << 16) |
+                                               (static_cast<uint32_t>(src[2]) << 24));
+        return x * (1.0 / 2147483648.0);
+    }
+
+    template <bool Round>
+    static void store_f64(unsigned char *dest, double x) CXXPH_NOEXCEPT
+    {
+        const int32_t y = double_to_int<Round>(x * 8388608.0, -8388608.0, 8388607.0);
+
+        dest[0] = static_cast<unsigned char>(y);
+        dest[1] = static_cast<unsigned char>(y >> 8);
+        dest[2] = static_cast<unsigned char>(y >> 16);
+    }
+};
+
+struct s32_format {
+    enum { sample_size = 4 };
+
+    static i32x8 load_i32(const unsigned char *src) CXXPH_NOEXCEPT
+    {
+        return i32x8::load(reinterpret_cast<const int32_t *>(src));
+    }
+
+    template <bool Round>
+    static void store_i32(unsigned char *dest, const i32x8 &x) CXXPH_NOEXCEPT
+    {
+        x.store(reinterpret_cast<int32_t *>(dest));
+    }
+
+    template <bool Round>
+    static void store_f32(unsigned char *dest, const f32x8 &x) CXXPH_NOEXCEPT
+    {
+        // NOTE: 2147483520 is the largest float below 2^31, so values >= 2^31 (bit patterns
+        // >= 0x4f000000, +inf included) are saturated to INT32_MAX in the integer domain
+        const f32x8 y = x * f32x8(2147483648.0f);
+        const i32x8 r = float_to_int<Round>(y, -2147483648.0f, 2147483520.0f);
+
+        simd::select(simd::cmp_gt(simd::bitcast_i32(y), i32x8(0x4effffff)), i32x8(0x7fffffff), r)
+            .store(reinterpret_cast<int32_t *>(dest));
+    }
+
+    static double load_f64(const unsigned char *src) CXXPH_NOEXCEPT
+    {
+        return *reinterpret_cast<const int32_t *>(src) * (1.0 / 2147483648.0);
+    }
+
+    template <bool Round>
+    static void store_f64(unsigned char *dest, double x) CXXPH_NOEXCEPT
+    {
+        *reinterpret_cast<int32_t *>(dest) = double_to_int<Round>(x * 2147483648.0, -2147483648.0, 2147483647.0);
+    }
+};
+
+struct f32_format {
+    enum { sample_size = 4 };
+
+    static f32x8 load_f32(const unsigned char *src) CXXPH_NOEXCEPT
+    {
+        return f32x8::load(reinterpret_cast<const float *>(src));
+    }
+
+    template <bool Round>
+    static void store_i32(unsigned char *dest, const i32x8 &x) CXXPH_NOEXCEPT
+    {
+        (simd::to_f32(x) * f32x8(1.0f / 2147483648.0f)).store(reinterpret_cast<float *>(dest));
+    }
+
+    static double load_f64(const unsigned char *src) CXXPH_NOEXCEPT { return *reinterpret_cast<const float *>(src); }
+
+    template <bool Round>
+    static void store_f64(unsigned char *dest, double x) CXXPH_NOEXCEPT
+    {
+        *reinterpret_cast<float *>(dest) = static_cast<float>(x);
+    }
+};
+
+struct f64_format {
+    enum { sample_size = 8 };
+
+    static double load_f64(const unsigned char *src) CXXPH_NOEXCEPT { return *reinterpret_cast<const double *>(src); }
+
+    template <bool Round>
+    static void store_f64(unsigned char *dest, double x) CXXPH_NOEXCEPT
+    {
+        *reinterpret_cast<double *>(dest) = x;
+    }
+};
+
+//
+// Big endian source formats
+//
+// The byte order is reversed in the loaded lanes (pshufb / vrev), fused into
+// the conversion. F64 is swapped per sample; with MOVBE enabled (AVX2 build)
+// the compiler folds the load and the swap into one instruction.
+//
+inline uint64_t byte_swap64(uint64_t x) CXXPH_NOEXCEPT
+{
+#if CXXPH_COMPILER_IS_GCC || CXXPH_COMPILER_IS_CLANG
+    return __builtin_bswap64(x);
+#elif CXXPH_COMPILER_IS_MSVC
+    return _byteswap_uint64(x);
+#else
+    x = ((x & 0x00ff00ff00ff00ffull) << 8) | ((x >> 8) & 0x00ff00ff00ff00ffull);
+    x = ((x & 0x0000ffff0000ffffull) << 16) | ((x >> 16) & 0x0000ffff0000ffffull);
+    return (x << 32) | (x >> 32);
+#endif
+}
+
+struct s16be_format {
+    enum { sample_size = 2 };
+
+    static i32x8 load_i32(const unsigned char *src) CXXPH_NOEXCEPT
+    {
+        const i16x8 x = simd::reverse_bytes(i16x8::load(reinterpret_cast<const int16_t *>(src)));
+        return simd::shl<16>(simd::combine(simd::to_i32_lo(x), simd::to_i32_hi(x)));
+    }
+};
+
+struct s24be_format {
+    enum { sample_size = 3 };
+
+    // (0, b0, b1, b2) -> (b2, b1, b0, 0) -> (0, b2, b1, b0)
+    static i32x8 load_i32(const unsigned char *src) CXXPH_NOEXCEPT
+    {
+        return simd::shl<8>(simd::reverse_bytes(load_s24(src)));
+    }
+};
+
+struct s32be_format {
+    enum { sample_size = 4 };
+
+    static i32x8 load_i32(const unsigned char *src) CXXPH_NOEXCEPT
+    {
+        return simd::reverse_bytes(i32x8::load(reinterpret_cast<const int32_t *>(src)));
+    }
+};
+
+struct f64be_format {
+    enum { sample_size = 8 };
+
+    static double load_f64(const unsigned char *src) CXXPH_NOEXCEPT
+    {
+        uint64_t x;
+        double y;
+
+        std::memcpy(&x, src, sizeof(x));
+        x = byte_swap64(x);
+        std::memcpy(&y, &x, sizeof(y));
+
+        return y;
+    }
+};
+
+//
+// Conversion operations
+//
+template <typename Src, typename Dest, bool Round>
+struct convert_via_i32 {
+    enum { num_samples = N };
+
+    static void convert(unsigned char *dest, const unsigned char *src) CXXPH_NOEXCEPT
+    {
+        Dest::template store_i32<Round>(dest, Src::load_i32(src));
+    }
+};
+
+template <typename Src, typename Dest, bool Round>
+struct convert_via_f32 {
+    enum { num_samples = N };
+
+    static void convert(unsigned char *dest, const unsigned char *src) CXXPH_NOEXCEPT
+    {
+        Dest::template store_f32<Round>(dest, Src::load_f32(src));
+    }
+};
+
+template <typename Src, typename Dest, bool Round>
+struct convert_via_f64 {
+    enum { num_samples = 1 };
+
+    static void convert(unsigned char *dest, const unsigned char *src) CXXPH_NOEXCEPT
+    {
+        Dest::template store_f64<Round>(dest, Src::load_f64(src));
+    }
+};
+
+template <typename Src, typename Dest, typename Op>
+void transform(void *dest, const void *src, std::size_t n) CXXPH_NOEXCEPT
+{
+    unsigned char *d = static_cast<unsigned char *>(dest);
+    const unsigned char *s = static_cast<const unsigned char *>(src);
+    std::size_t i = 0;
+
+    for (; (i + Op::num_samples) <= n; i += Op::num_samples) {
+        Op::convert(&d[i * Dest::sample_size], &s[i * Src::sample_size]);
+    }
+
+    if (i < n) {
+        // NOTE: double, for the alignment of all the sample types
+        double tmp_src[N];
+        double tmp_dest[N];
+        const std::size_t rem = n - i;
+
+        std::memset(tmp_src, 0, sizeof(tmp_src));
+        std::memcpy(tmp_src, &s[i * Src::sample_size], rem * Src::sample_size);
+        Op::convert(reinterpret_cast<unsigned char *>(tmp_dest), reinterpret_cast<const unsigned char *>(tmp_src));
+        std::memcpy(&d[i * Dest::sample_size], tmp_dest, rem * Dest::sample_size);
+    }
+}
+
+//
+// Byte order reversal (32 bytes per step, in place or not)
+//
+template <std::size_t Size>
+struct raw_format {
+    enum { sample_size = Size };
+};
+
+struct swap_bytes_16_op {
+    enum { num_samples = 2 * N };
+
+    static void convert(unsigned char *dest, const unsigned char *src) CXXPH_NOEXCEPT
+    {
+        const i16x8 a = i16x8::load(reinterpret_cast<const int16_t *>(&src[0]));
+        const i16x8 b = i16x8::load(reinterpret_cast<const int16_t *>(&src[16]));
+
+        simd::reverse_bytes(a).store(reinterpret_cast<int16_t *>(&dest[0]));
+        simd::reverse_bytes(b).store(reinterpret_cast<int16_t *>(&dest[16]));
+    }
+};
+
+struct swap_bytes_24_op {
+    enum { num_samples = N };
+
+    // (0, b0, b1, b2) -> (b2, b1, b0, 0), right-justified for store_s24()
+    static void convert(unsigned char *dest, const unsigned char *src) CXXPH_NOEXCEPT
+    {
+        store_s24(dest, simd::reverse_bytes(load_s24(src)));
+    }
+};
+
+struct swap_bytes_32_op {
+    enum { num_samples = N };
+
+    static void convert(unsigned char *dest, const unsigned char *src) CXXPH_NOEXCEPT
+    {
+        simd::reverse_bytes(i32x8::load(reinterpret_cast<const int32_t *>(src)))
+            .store(reinterpret_cast<int32_t *>(dest));
+    }
+};
+
+struct swap_bytes_64_op {
+    enum { num_samples = N / 2 };
+
+    // reversed 32-bit lanes, then the halves of each 64-bit sample exchanged
+    static void convert(unsigned char *dest, const unsigned char *src) CXXPH_NOEXCEPT
+    {
+        const i32x8 x = simd::reverse_bytes(i32x8::load(reinterpret_cast<const int32_t *>(src)));
+        simd::shuffle<1, 0, 3, 2>(x).store(reinterpret_cast<int32_t *>(dest));
+    }
+};
+
+template <typename Src, typename Dest, template <typename, typename, bool> class Op>
+void convert_array(void *dest, const void *src, std::size_t n, bool round) CXXPH_NOEXCEPT
+{
+    if (round) {
+        transform<Src, Dest, Op<Src, Dest, true> >(dest, src, n);
+    } else {
+        transform<Src, Dest, Op<Src, Dest, false> >(dest, src, n);
+    }
+}
+
+//
+// Channel (de)interleaving
+//
+// N frames per step, by a tree of 2-way unzip / zip steps (deinterleave() /
+// interleave() of simd.hpp) and a 3-way step for 6 channels. The 3-way step
+// works on each group of 4 lanes:
+//
+//   a: x0 y0 z0 x1    select    a0 c1 b2 a3    shuffle<0, 3, 2, 1>    x0 x1 x2 x3
+//   b: y1 z1 x2 y2    ----->    b0 a1 c2 b3    shuffle<1, 0, 3, 2>    y0 y1 y2 y3
+//   c: z2 x3 y3 z3              c0 b1 a2 c3    shuffle<2, 1, 0, 3>    z0 z1 z2 z3
+//
+// The shuffles are their own inverse, so interleaving runs the steps backward.
+//
+const float k_lanes_0_3[8] = { 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f };
+const float k_lane_1[8] = { 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f };
+
+struct three_way_masks {
+    f32x8::mask_type lanes_0_3;
+    f32x8::mask_type lane_1;
+
+    three_way_masks()
+        : lanes_0_3(simd::cmp_gt(f32x8::load(k_lanes_0_3), f32x8::zero())),
+          lane_1(simd::cmp_gt(f32x8::load(k_lane_1), f32x8::zero()))
+    {
+    }
+};
+
+// v: C vectors of interleaved samples -> ch: C vectors of channels
+template <std::size_t C>
+struct unzip_tree {
+    static void apply(const three_way_masks &m, const f32x8 *v, f32x8 *ch) CXXPH_NOEXCEPT
+    {
+        f32x8 even[C / 2], odd[C / 2];
+        f32x8 ch_even[C / 2], ch_odd[C / 2];
+
+        for (std::size_t k = 0; k < (C / 2); ++k) {
+            simd::deinterleave(v[2 * k], v[2 * k + 1], &even[k], &odd[k]);
+        }
+
+        unzip_tree<C / 2>::apply(m, even, ch_even);
+        unzip_tree<C / 2>::apply(m, odd, ch_odd);
+
+        for (std::size_t k = 0; k < (C / 2); ++k) {
+            ch[2 * k] = ch_even[k];
+            ch[2 * k + 1] = ch_odd[k];
+        }
+    }
+};
+
+template <>
+struct unzip_tree<1> {
+    static void apply(const three_way_masks &, const f32x8 *v, f32x8 *ch) CXXPH_NOEXCEPT { ch[0] = v[0]; }
+};
+
+template <>
+struct unzip_tree<3> {
+    static void apply(const three_way_masks &m, const f32x8 *v, f32x8 *ch) CXXPH_NOEXCEPT
+    {
+        // gather the groups of 4 frames
+        const f32x8 a = simd::combine(simd::low(v[0]), simd::high(v[1]));
+        const f32x8 b = simd::combine(simd::high(v[0]), simd::low(v[2]));
+        const f32x8 c = simd::combine(simd::low(v[1]), simd::high(v[2]));
+
+        ch[0] = simd::shuffle<0, 3, 2, 1>(simd::select(m.lanes_0_3, a, simd::select(m.lane_1, c, b)));
+        ch[1] = simd::shuffle<1, 0, 3, 2>(simd::select(m.lanes_0_3, b, simd::select(m.lane_1, a, c)));
+        ch[2] = simd::shuffle<2, 1, 0, 3>(simd::select(m.lanes_0_3, c, simd::select(m.lane_1, b, a)));
+    }
+};
+
+// ch: C vectors of channels -> v: C vectors of interleaved samples
+template <std::size_t C>
+struct zip_tree {
+    static void apply(const three_way_masks &m, const f32x8 *ch, f32x8 *v) CXXPH_NOEXCEPT
+    {
+        f32x8 ch_even[C / 2], ch_odd[C / 2];
+        f32x8 even[C / 2], odd[C / 2];
+
+        for (std::size_t k = 0; k < (C / 2); ++k) {
+            ch_even[k] = ch[2 * k];
+            ch_odd[k] = ch[2 * k + 1];
+        }
+
+        zip_tree<C / 2>::apply(m, ch_even, even);
+        zip_tree<C / 2>::apply(m, ch_odd, odd);
+
+        for (std::size_t k = 0; k < (C / 2); ++k) {
+            simd::interleave(even[k], odd[k], &v[2 * k], &v[2 * k + 1]);
+        }
+    }
+};
+
+template <>
+struct zip_tree<1> {
+    static void apply(const three_way_masks &, const f32x8 *ch, f32x8 *v) CXXPH_NOEXCEPT { v[0] = ch[0]; }
+};
+
+template <>
+struct zip_tree<3> {
+    static void apply(const three_way_masks &m, const f32x8 *ch, f32x8 *v) CXXPH_NOEXCEPT
+    {
+        const f32x8 x = simd::shuffle<0, 3, 2, 1>(ch[0]);
+        const f32x8 y = simd::shuffle<1, 0, 3, 2>(ch[1]);
+        const f32x8 z = simd::shuffle<2, 1, 0, 3>(ch[2]);
+        const f32x8 a = simd::select(m.lanes_0_3, x, simd::select(m.lane_1, y, z));
+        const f32x8 b = simd::select(m.lanes_0_3, y, simd::select(m.lane_1, z, x));
+        const f32x8 c = simd::select(m.lanes_0_3, z, simd::select(m.lane_1, x, y));
+
+        // scatter the groups of 4 frames
+        v[0] = simd::combine(simd::low(a), simd::low(b));
+        v[1] = simd::combine(simd::low(c), simd::high(a));
+        v[2] = simd::combine(simd::high(b), simd::high(c));
+    }
+};
+
+void deinterleave_scalar(float *const *dest, const float *src, std::size_t num_channels, std::size_t first_frame,
+                         std::size_t num_frames) CXXPH_NOEXCEPT
+{
+    for (std::size_t i = first_frame; i < num_frames; ++i) {
+        for (std::size_t c = 0; c < num_channels; ++c) {
+            dest[c][i] = src[i * num_channels + c];
+        }
+    }
+}
+
+void interleave_scalar(float *dest, const float *const *src, std::size_t num_channels, std::size_t first_frame,
+                       std::size_t num_frames) CXXPH_NOEXCEPT
+{
+    for (std::size_t i = first_frame; i < num_frames; ++i) {
+        for (std::size_t c = 0; c < num_channels; ++c) {
+            dest[i * num_channels + c] = src[c][i];
+        }
+    }
+}
+
+template <std::size_t C>
+void deinterleave_frames(float *const *dest, const float *src, std::size_t num_frames) CXXPH_NOEXCEPT
+{
+    const three_way_masks m;
+    std::size_t i = 0;
+
+    for (; (i + N) <= num_frames; i += N) {
+        f32x8 v[C], ch[C];
+
+        for (std::size_t k = 0; k < C; ++k) {
+            v[k] = f32x8::load(&src[i * C + k * N]);
+        }
+
+        unzip_tree<C>::apply(m, v, ch);
+
+        for (std::size_t k = 0; k < C; ++k) {
+            ch[k].store(&dest[k][i]);
+        }
+    }
+
+    deinterleave_scalar(dest, src, C, i, num_frames);
+}
+
+template <std::size_t C>
+void interleave_frames(float *dest, const float *const *src, std::size_t num_frames) CXXPH_NOEXCEPT
+{
+    const three_way_masks m;
+    std::size_t i = 0;
+
+    for (; (i + N) <= num_frames; i += N) {
+        f32x8 ch[C], v[C];
+
+        for (std::size_t k = 0; k < C; ++k) {
+            ch[k] = f32x8::load(&src[k][i]);
+        }
+
+        zip_tree<C>::apply(m, ch, v);
+
+        for (std::size_t k = 0; k < C; ++k) {
+            v[k].store(&dest[i * C + k * N]);
+        }
+    }
+
+    interleave_scalar(dest, src, C, i, num_frames);
+}
+
+} // namespace
+
+#define CXXPH_PCM_FORMAT_DEFINE_CONVERSION_KERNEL(from, to, via)                                                       \
+    void from##_to_##to##_kernel(void *dest, const void *src, std::size_t n, bool round)                               \
+    {                                                                                                                  \
+        convert_array<from##_format, to##_format, via>(dest, src, n, round);                                           \
+    }
+
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION_KERNEL(s16, s24, convert_via_i32)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION_KERNEL(s16, s32, convert_via_i32)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION_KERNEL(s16, f32, convert_via_i32)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION_KERNEL(s16, f64, convert_via_f64)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION_KERNEL(s24, s16, convert_via_i32)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION_KERNEL(s24, s32, convert_via_i32)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION_KERNEL(s24, f32, convert_via_i32)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION_KERNEL(s24, f64, convert_via_f64)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION_KERNEL(s32, s16, convert_via_i32)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION_KERNEL(s32, s24, convert_via_i32)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION_KERNEL(s32, f32, convert_via_i32)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION_KERNEL(s32, f64, convert_via_f64)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION_KERNEL(f32, s16, convert_via_f32)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION_KERNEL(f32, s24, convert_via_f32)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION_KERNEL(f32, s32, convert_via_f32)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION_KERNEL(f32, f64, convert_via_f64)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION_KERNEL(f64, s16, convert_via_f64)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION_KERNEL(f64, s24, convert_via_f64)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION_KERNEL(f64, s32, convert_via_f64)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION_KERNEL(f64, f32, convert_via_f64)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION_KERNEL(s16be, f32, convert_via_i32)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION_KERNEL(s24be, f32, convert_via_i32)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION_KERNEL(s32be, f32, convert_via_i32)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION_KERNEL(f64be, f32, convert_via_f64)
+
+#undef CXXPH_PCM_FORMAT_DEFINE_CONVERSION_KERNEL
+
+#define CXXPH_PCM_FORMAT_DEFINE_BYTE_SWAP_KERNEL(bits)                                                                 \
+    void swap_bytes_##bits##_kernel(void *dest, const void *src, std::size_t n)                                        \
+    {                                                                                                                  \
+        transform<raw_format<bits / 8>, raw_format<bits / 8>, swap_bytes_##bits##_op>(dest, src, n);                   \
+    }
+
+CXXPH_PCM_FORMAT_DEFINE_BYTE_SWAP_KERNEL(16)
+CXXPH_PCM_FORMAT_DEFINE_BYTE_SWAP_KERNEL(24)
+CXXPH_PCM_FORMAT_DEFINE_BYTE_SWAP_KERNEL(32)
+CXXPH_PCM_FORMAT_DEFINE_BYTE_SWAP_KERNEL(64)
+
+#undef CXXPH_PCM_FORMAT_DEFINE_BYTE_SWAP_KERNEL
+
+void deinterleave_kernel(float *const *dest, const float *src, std::size_t num_channels, std::size_t num_frames)
+{
+    switch (num_channels) {
+    case 2:
+        deinterleave_frames<2>(dest, src, num_frames);
+        break;
+    case 4:
+        deinterleave_frames<4>(dest, src, num_frames);
+        break;
+    case 6:
+        deinterleave_frames<6>(dest, src, num_frames);
+        break;
+    case 8:
+        deinterleave_frames<8>(dest, src, num_frames);
+        break;
+    default:
+        deinterleave_scalar(dest, src, num_channels, 0, num_frames);
+        break;
+    }
+}
+
+void interleave_kernel(float *dest, const float *const *src, std::size_t num_channels, std::size_t num_frames)
+{
+    switch (num_channels) {
+    case 2:
+        interleave_frames<2>(dest, src, num_frames);
+        break;
+    case 4:
+        interleave_frames<4>(dest, src, num_frames);
+        break;
+    case 6:
+        interleave_frames<6>(dest, src, num_frames);
+        break;
+    case 8:
+        interleave_frames<8>(dest, src, num_frames);
+        break;
+    default:
+        interleave_scalar(dest, src, num_channels, 0, num_frames);
+        break;
+    }
+}
+
+} // namespace CXXPH_KERNEL_ISA_NAMESPACE
+} // namespace pcm_format
+} // namespace cxxporthelper
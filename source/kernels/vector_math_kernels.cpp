@@ -0,0 +1,151 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include <cxxporthelper/impl/kernel_isa.hpp>
+
+#include <cstring>
+#include <cxxporthelper/simd_math.hpp>
+
+namespace cxxporthelper {
+namespace vector_math {
+namespace CXXPH_KERNEL_ISA_NAMESPACE {
+
+using simd::f32x8;
+
+namespace {
+
+struct exp_op {
+    f32x8 operator()(const f32x8 &x) const { return simd::exp(x); }
+};
+
+struct log_op {
+    f32x8 operator()(const f32x8 &x) const { return simd::log(x); }
+};
+
+struct sin_op {
+    f32x8 operator()(const f32x8 &x) const { return simd::sin(x); }
+};
+
+struct cos_op {
+    f32x8 operator()(const f32x8 &x) const { return simd::cos(x); }
+};
+
+struct tanh_op {
+    f32x8 operator()(const f32x8 &x) const { return simd::tanh(x); }
+};
+
+struct sqrt_op {
+    f32x8 operator()(const f32x8 &x) const { return simd::sqrt(x); }
+};
+
+struct rsqrt_op {
+    f32x8 operator()(const f32x8 &x) const { return simd::rsqrt(x); }
+};
+
+struct pow_scalar_exponent_op {
+    f32x8 exponent;
+
+    explicit pow_scalar_exponent_op(float e) : exponent(e) {}
+    f32x8 operator()(const f32x8 &x) const { return simd::pow(x, exponent); }
+};
+
+// the last partial vector is processed through a zero padded buffer,
+// so every element goes through the same code path
+
+template <typename Op>
+void transform(float *dest, const float *src, std::size_t n, const Op &op)
+{
+    const std::size_t N = f32x8::num_lanes;
+    std::size_t i = 0;
+
+    for (; (i + N) <= n; i += N) {
+        op(f32x8::load(&src[i])).store(&dest[i]);
+    }
+
+    if (i < n) {
+        float tmp[N] = { 0.0f };
+        std::memcpy(tmp, &src[i], sizeof(float) * (n - i));
+        op(f32x8::load(tmp)).store(tmp);
+        std::memcpy(&dest[i], tmp, sizeof(float) * (n - i));
+    }
+}
+
+} // namespace
+
+void exp_kernel(float *dest, const float *src, std::size_t n) { transform(dest, src, n, exp_op()); }
+
+void log_kernel(float *dest, const float *src, std::size_t n) { transform(dest, src, n, log_op()); }
+
+void sin_kernel(float *dest, const float *src, std::size_t n) { transform(dest, src, n, sin_op()); }
+
+void cos_kernel(float *dest, const float *src, std::size_t n) { transform(dest, src, n, cos_op()); }
+
+void tanh_kernel(float *dest, const float *src, std::size_t n) { transform(dest, src, n, tanh_op()); }
+
+void sqrt_kernel(float *dest, const float *src, std::size_t n) { transform(dest, src, n, sqrt_op()); }
+
+void rsqrt_kernel(float *dest, const float *src, std::size_t n) { transform(dest, src, n, rsqrt_op()); }
+
+void pow_scalar_exponent_kernel(float *dest, const float *base, float exponent, std::size_t n)
+{
+    transform(dest, base, n, pow_scalar_exponent_op(exponent));
+}
+
+void pow_array_exponent_kernel(float *dest, const float *base, const float *exponent, std::size_t n)
+{
+    const std::size_t N = f32x8::num_lanes;
+    std::size_t i = 0;
+
+    for (; (i + N) <= n; i += N) {
+        simd::pow(f32x8::load(&base[i]), f32x8::load(&exponent[i])).store(&dest[i]);
+    }
+
+    if (i < n) {
+        float tmp_base[N] = { 0.0f };
+        float tmp_exponent[N] = { 0.0f };
+        std::memcpy(tmp_base, &base[i], sizeof(float) * (n - i));
+        std::memcpy(tmp_exponent, &exponent[i], sizeof(float) * (n - i));
+        simd::pow(f32x8::load(tmp_base), f32x8::load(tmp_exponent)).store(tmp_base);
+        std::memcpy(&dest[i], tmp_base, sizeof(float) * (n - i));
+    }
+}
+
+void sincos_kernel(float *dest_sin, float *dest_cos, const float *src, std::size_t n)
+{
+    const std::size_t N = f32x8::num_lanes;
+    std::size_t i = 0;
+    f32x8 s, c;
+
+    for (; (i + N) <= n; i += N) {
+        simd::sincos(f32x8::load(&src[i]), &s, &c);
+        s.store(&dest_sin[i]);
+        c.store(&dest_cos[i]);
+    }
+
+    if (i < n) {
+        float tmp[N] = { 0.0f };
+        std::memcpy(tmp, &src[i], sizeof(float) * (n - i));
+        simd::sincos(f32x8::load(tmp), &s, &c);
+        s.store(tmp);
+        std::memcpy(&dest_sin[i], tmp, sizeof(float) * (n - i));
+        c.store(tmp);
+        std::memcpy(&dest_cos[i], tmp, sizeof(float) * (n - i));
+    }
+}
+
+} // namespace CXXPH_KERNEL_ISA_NAMESPACE
+} // namespace vector_math
+} // namespace cxxporthelper
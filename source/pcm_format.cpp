@@ -0,0 +1,224 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+
+#include <cxxporthelper/pcm_format.hpp>
+
+#include <cstring>
+#include <cxxporthelper/dispatch.hpp>
+#include <cxxporthelper/impl/kernel_isa.hpp>
+
+namespace cxxporthelper {
+namespace pcm_format {
+
+typedef void (*conversion_func_t)(void *, const void *, std::size_t, bool);
+typedef void (*deinterleave_func_t)(float *const *, const float *, std::size_t, std::size_t);
+typedef void (*interleave_func_t)(float *, const float *const *, std::size_t, std::size_t);
+typedef void (*byte_swap_func_t)(void *, const void *, std::size_t);
+
+#define CXXPH_PCM_FORMAT_DEFINE_CONVERSION(from, to)                                                                   \
+    CXXPH_KERNEL_DECLARE_VARIANTS(void, from##_to_##to##_kernel,                                                       \
+                                  (void *dest, const void *src, std::size_t n, bool round))                            \
+                                                                                                                       \
+    static const dispatch::kernel_variant<conversion_func_t> from##_to_##to##_variants[] = {                           \
+        CXXPH_KERNEL_VARIANT_TABLE_ENTRIES(from##_to_##to##_kernel)                                                    \
+    };                                                                                                                 \
+                                                                                                                       \
+    CXXPH_DISPATCH_DEFINE_FUNCTION(void, from##_to_##to, (void *dest, const void *src, std::size_t n, bool round),     \
+                                   (dest, src, n, round), from##_to_##to##_variants)
+
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION(s16, s24)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION(s16, s32)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION(s16, f32)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION(s16, f64)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION(s24, s16)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION(s24, s32)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION(s24, f32)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION(s24, f64)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION(s32, s16)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION(s32, s24)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION(s32, f32)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION(s32, f64)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION(f32, s16)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION(f32, s24)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION(f32, s32)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION(f32, f64)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION(f64, s16)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION(f64, s24)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION(f64, s32)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION(f64, f32)
+
+// big endian sources
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION(s16be, f32)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION(s24be, f32)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION(s32be, f32)
+CXXPH_PCM_FORMAT_DEFINE_CONVERSION(f64be, f32)
+
+#undef CXXPH_PCM_FORMAT_DEFINE_CONVERSION
+
+// [src_format][dest_format] (nullptr: same format)
+static const conversion_func_t conversion_table[NUM_SAMPLE_FORMATS][NUM_SAMPLE_FORMATS] = {
+    { nullptr, &s16_to_s24, &s16_to_s32, &s16_to_f32, &s16_to_f64 },
+    { &s24_to_s16, nullptr, &s24_to_s32, &s24_to_f32, &s24_to_f64 },
+    { &s32_to_s16, &s32_to_s24, nullptr, &s32_to_f32, &s32_to_f64 },
+    { &f32_to_s16, &f32_to_s24, &f32_to_s32, nullptr, &f32_to_f64 },
+    { &f64_to_s16, &f64_to_s24, &f64_to_s32, &f64_to_f32, nullptr },
+};
+
+// byte order reversal
+#define CXXPH_PCM_FORMAT_DEFINE_BYTE_SWAP(bits)                                                                        \
+    CXXPH_KERNEL_DECLARE_VARIANTS(void, swap_bytes_##bits##_kernel, (void *dest, const void *src, std::size_t n))      \
+                                                                                                                       \
+    static const dispatch::kernel_variant<byte_swap_func_t> swap_bytes_##bits##_variants[] = {                         \
+        CXXPH_KERNEL_VARIANT_TABLE_ENTRIES(swap_bytes_##bits##_kernel)                                                 \
+    };                                                                                                                 \
+                                                                                                                       \
+    CXXPH_DISPATCH_DEFINE_FUNCTION(void, swap_bytes_##bits, (void *dest, const void *src, std::size_t n),              \
+                                   (dest, src, n), swap_bytes_##bits##_variants)
+
+CXXPH_PCM_FORMAT_DEFINE_BYTE_SWAP(16)
+CXXPH_PCM_FORMAT_DEFINE_BYTE_SWAP(24)
+CXXPH_PCM_FORMAT_DEFINE_BYTE_SWAP(32)
+CXXPH_PCM_FORMAT_DEFINE_BYTE_SWAP(64)
+
+#undef CXXPH_PCM_FORMAT_DEFINE_BYTE_SWAP
+
+// channel (de)interleaving
+CXXPH_KERNEL_DECLARE_VARIANTS(void, deinterleave_kernel,
+                              (float *const *dest, const float *src, std::size_t num_channels, std::size_t num_frames))
+CXXPH_KERNEL_DECLARE_VARIANTS(void, interleave_kernel,
+                              (float *dest, const float *const *src, std::size_t num_channels, std::size_t num_frames))
+
+static const dispatch::kernel_variant<deinterleave_func_t> deinterleave_variants[] = {
+    CXXPH_KERNEL_VARIANT_TABLE_ENTRIES(deinterleave_kernel)
+};
+
+static const dispatch::kernel_variant<interleave_func_t> interleave_variants[] = {
+    CXXPH_KERNEL_VARIANT_TABLE_ENTRIES(interleave_kernel)
+};
+
+CXXPH_DISPATCH_DEFINE_FUNCTION(void, deinterleave,
+                               (float *const *dest, const float *src, std::size_t num_channels, std::size_t num_frames),
+                               (dest, src, num_channels, num_frames), deinterleave_variants)
+
+CXXPH_DISPATCH_DEFINE_FUNCTION(void, interleave,
+                               (float *dest, const float *const *src, std::size_t num_channels, std::size_t num_frames),
+                               (dest, src, num_channels, num_frames), interleave_variants)
+
+std::size_t get_sample_size(sample_format_t format) CXXPH_NOEXCEPT
+{
+    switch (format) {
+    case SAMPLE_FORMAT_S16:
+        return 2;
+    case SAMPLE_FORMAT_S24_PACKED:
+        return 3;
+    case SAMPLE_FORMAT_S32:
+        return 4;
+    case SAMPLE_FORMAT_F32:
+        return 4;
+    case SAMPLE_FORMAT_F64:
+        return 8;
+    default:
+        return 0;
+    }
+}
+
+bool convert(void *dest, sample_format_t dest_format, const void *src, sample_format_t src_format, std::size_t n,
+             rounding_mode_t rounding)
+{
+    const std::size_t dest_size = get_sample_size(dest_format);
+    const std::size_t src_size = get_sample_size(src_format);
+
+    if (dest_size == 0 || src_size == 0) {
+        return false;
+    }
+
+    if (n == 0) {
+        return true;
+    }
+
+    const conversion_func_t func = conversion_table[src_format][dest_format];
+
+    if (func) {
+        func(dest, src, n, (rounding == ROUNDING_MODE_NEAREST));
+    } else if (dest != src) {
+        std::memmove(dest, src, n * src_size);
+    }
+
+    return true;
+}
+
+bool swap_byte_order(void *dest, const void *src, std::size_t sample_size, std::size_t n)
+{
+    byte_swap_func_t func;
+
+    switch (sample_size) {
+    case 2:
+        func = &swap_bytes_16;
+        break;
+    case 3:
+        func = &swap_bytes_24;
+        break;
+    case 4:
+        func = &swap_bytes_32;
+        break;
+    case 8:
+        func = &swap_bytes_64;
+        break;
+    default:
+        return false;
+    }
+
+    if (n != 0) {
+        func(dest, src, n);
+    }
+
+    return true;
+}
+
+bool convert_from_big_endian(float *dest, const void *src, sample_format_t src_format, std::size_t n)
+{
+    conversion_func_t func;
+
+    switch (src_format) {
+    case SAMPLE_FORMAT_S16:
+        func = &s16be_to_f32;
+        break;
+    case SAMPLE_FORMAT_S24_PACKED:
+        func = &s24be_to_f32;
+        break;
+    case SAMPLE_FORMAT_S32:
+        func = &s32be_to_f32;
+        break;
+    case SAMPLE_FORMAT_F32:
+        // same sample size, only the byte order differs
+        return swap_byte_order(dest, src, sizeof(float), n);
+    case SAMPLE_FORMAT_F64:
+        func = &f64be_to_f32;
+        break;
+    default:
+        return false;
+    }
+
+    if (n != 0) {
+        func(dest, src, n, true);
+    }
+
+    return true;
+}
+
+} // namespace pcm_format
+} // namespace cxxporthelper
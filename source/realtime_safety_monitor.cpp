@@ -0,0 +1,158 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include <cxxporthelper/realtime_safety_monitor.hpp>
+
+#if CXXPH_CONFIG_ENABLE_REALTIME_SAFETY_MONITOR
+
+#include <cxxporthelper/atomic>
+
+// RUSAGE_THREAD is Linux specific
+#if (CXXPH_TARGET_PLATFORM == CXXPH_PLATFORM_LINUX) || (CXXPH_TARGET_PLATFORM == CXXPH_PLATFORM_ANDROID)
+#include <sys/resource.h>
+#if defined(RUSAGE_THREAD)
+#define CXXPH_RTSAFETY_HAS_THREAD_RUSAGE 1
+#endif
+#endif
+
+#ifndef CXXPH_RTSAFETY_HAS_THREAD_RUSAGE
+#define CXXPH_RTSAFETY_HAS_THREAD_RUSAGE 0
+#endif
+
+namespace cxxporthelper {
+namespace realtime_safety {
+
+struct thread_state_t {
+    int depth;
+    bool has_last_report;
+    long start_minor_faults;
+    long start_major_faults;
+    section_report current;
+    section_report last;
+};
+
+static CXXPH_THREAD_LOCAL thread_state_t tls_state;
+
+static std::atomic<report_callback_t> g_callback(nullptr);
+static std::atomic<void *> g_callback_user_data(nullptr);
+
+static inline bool get_fault_counts(long *minor_faults, long *major_faults) CXXPH_NOEXCEPT
+{
+#if CXXPH_RTSAFETY_HAS_THREAD_RUSAGE
+    struct rusage usage;
+
+    if (::getrusage(RUSAGE_THREAD, &usage) == 0) {
+        (*minor_faults) = usage.ru_minflt;
+        (*major_faults) = usage.ru_majflt;
+        return true;
+    }
+#endif
+    (*minor_faults) = 0;
+    (*major_faults) = 0;
+    return false;
+}
+
+void set_report_callback(report_callback_t callback, void *user_data) CXXPH_NOEXCEPT
+{
+    g_callback_user_data.store(user_data, std::memory_order_relaxed);
+    g_callback.store(callback, std::memory_order_release);
+}
+
+void enter_section(const char *name) CXXPH_NOEXCEPT
+{
+    thread_state_t &state = tls_state;
+
+    if (state.depth++ > 0) {
+        return;
+    }
+
+    state.current.name = name;
+    state.current.alloc_count = 0;
+    state.current.free_count = 0;
+    state.current.minor_faults = 0;
+    state.current.major_faults = 0;
+    state.current.faults_available = get_fault_counts(&state.start_minor_faults, &state.start_major_faults);
+}
+
+void leave_section() CXXPH_NOEXCEPT
+{
+    thread_state_t &state = tls_state;
+
+    if (state.depth <= 0) {
+        return;
+    }
+
+    if (--state.depth > 0) {
+        return;
+    }
+
+    long minor_faults = 0;
+    long major_faults = 0;
+
+    if (state.current.faults_available && get_fault_counts(&minor_faults, &major_faults)) {
+        state.current.minor_faults = static_cast<uint32_t>(minor_faults - state.start_minor_faults);
+        state.current.major_faults = static_cast<uint32_t>(major_faults - state.start_major_faults);
+    }
+
+    state.last = state.current;
+    state.has_last_report = true;
+
+    if (state.last.has_violation()) {
+        const report_callback_t callback = g_callback.load(std::memory_order_acquire);
+
+        if (callback) {
+            callback(state.last, g_callback_user_data.load(std::memory_order_relaxed));
+        }
+    }
+}
+
+bool in_section() CXXPH_NOEXCEPT { return (tls_state.depth > 0); }
+
+bool get_last_report(section_report *report) CXXPH_NOEXCEPT
+{
+    const thread_state_t &state = tls_state;
+
+    if (!(report && state.has_last_report)) {
+        return false;
+    }
+
+    (*report) = state.last;
+
+    return true;
+}
+
+void notify_alloc() CXXPH_NOEXCEPT
+{
+    thread_state_t &state = tls_state;
+
+    if (state.depth > 0) {
+        state.current.alloc_count += 1;
+    }
+}
+
+void notify_free() CXXPH_NOEXCEPT
+{
+    thread_state_t &state = tls_state;
+
+    if (state.depth > 0) {
+        state.current.free_count += 1;
+    }
+}
+
+} // namespace realtime_safety
+} // namespace cxxporthelper
+
+#endif // CXXPH_CONFIG_ENABLE_REALTIME_SAFETY_MONITOR
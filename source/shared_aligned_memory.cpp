@@ -0,0 +1,363 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include <cxxporthelper/shared_aligned_memory.hpp>
+
+#include <cstring>
+
+#include <cxxporthelper/atomic>
+
+#if (CXXPH_TARGET_PLATFORM == CXXPH_PLATFORM_LINUX) || (CXXPH_TARGET_PLATFORM == CXXPH_PLATFORM_ANDROID) ||            \
+    (CXXPH_TARGET_PLATFORM == CXXPH_PLATFORM_UNIX) || (CXXPH_TARGET_PLATFORM == CXXPH_PLATFORM_OSX)
+#define CXXPH_SHARED_MEMORY_POSIX 1
+#else
+#define CXXPH_SHARED_MEMORY_POSIX 0
+#endif
+
+#if CXXPH_SHARED_MEMORY_POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if (CXXPH_TARGET_PLATFORM == CXXPH_PLATFORM_LINUX) || (CXXPH_TARGET_PLATFORM == CXXPH_PLATFORM_ANDROID)
+#include <sys/syscall.h>
+#endif
+#endif
+
+// shm_open() is not provided by bionic
+#if CXXPH_SHARED_MEMORY_POSIX && (CXXPH_TARGET_PLATFORM != CXXPH_PLATFORM_ANDROID)
+#define CXXPH_SHARED_MEMORY_HAS_SHM_OPEN 1
+#else
+#define CXXPH_SHARED_MEMORY_HAS_SHM_OPEN 0
+#endif
+
+#if CXXPH_SHARED_MEMORY_POSIX && defined(SYS_memfd_create)
+#define CXXPH_SHARED_MEMORY_HAS_MEMFD 1
+#else
+#define CXXPH_SHARED_MEMORY_HAS_MEMFD 0
+#endif
+
+namespace cxxporthelper {
+
+typedef shared_aligned_memory_header header_type;
+
+template <typename T>
+static inline bool is_pow_of_two(T x) CXXPH_NOEXCEPT
+{
+    return ((x > 0) && ((x & (x - 1)) == 0));
+}
+
+static inline std::size_t round_up(std::size_t x, std::size_t alignment) CXXPH_NOEXCEPT
+{
+    return (x + (alignment - 1)) & ~(alignment - 1);
+}
+
+#if CXXPH_SHARED_MEMORY_POSIX
+static int create_anonymous_fd() CXXPH_NOEXCEPT
+{
+#if CXXPH_SHARED_MEMORY_HAS_MEMFD
+    return static_cast<int>(::syscall(SYS_memfd_create, "cxxporthelper", 0));
+#else
+    return -1;
+#endif
+}
+
+static int create_named_fd(const char *name) CXXPH_NOEXCEPT
+{
+#if CXXPH_SHARED_MEMORY_HAS_SHM_OPEN
+    return ::shm_open(name, O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+#else
+    (void)name;
+    return -1;
+#endif
+}
+
+static int open_named_fd(const char *name, bool read_only) CXXPH_NOEXCEPT
+{
+#if CXXPH_SHARED_MEMORY_HAS_SHM_OPEN
+    return ::shm_open(name, (read_only) ? O_RDONLY : O_RDWR, 0);
+#else
+    (void)name;
+    (void)read_only;
+    return -1;
+#endif
+}
+#endif
+
+shared_memory_block::shared_memory_block() CXXPH_NOEXCEPT : fd_(-1),
+                                                            base_(nullptr),
+                                                            mapped_size_(0),
+                                                            header_(nullptr),
+                                                            data_(nullptr),
+                                                            num_elements_(0)
+{
+}
+
+shared_memory_block::shared_memory_block(shared_memory_block &&other) CXXPH_NOEXCEPT : fd_(-1),
+                                                                                       base_(nullptr),
+                                                                                       mapped_size_(0),
+                                                                                       header_(nullptr),
+                                                                                       data_(nullptr),
+                                                                                       num_elements_(0)
+{
+    swap(other);
+}
+
+shared_memory_block::~shared_memory_block() { close(); }
+
+shared_memory_block &shared_memory_block::operator=(shared_memory_block &&other) CXXPH_NOEXCEPT
+{
+    if (this != &other) {
+        close();
+        swap(other);
+    }
+    return (*this);
+}
+
+bool shared_memory_block::create(const char *name, std::size_t element_size, std::size_t num_elements,
+                                 std::size_t alignment, bool zero_clear) CXXPH_NOEXCEPT
+{
+    close();
+
+#if CXXPH_SHARED_MEMORY_POSIX
+    const std::size_t page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+
+    // mmap() returns page aligned address, so larger alignment can not be guaranteed
+    if (!is_pow_of_two(alignment) || alignment > page_size || element_size == 0) {
+        return false;
+    }
+
+    const std::size_t data_offset = round_up(sizeof(header_type), alignment);
+
+    if (num_elements > (static_cast<std::size_t>(-1) - data_offset - page_size) / element_size) {
+        return false;
+    }
+
+    const std::size_t mapped_size = round_up(data_offset + element_size * num_elements, page_size);
+
+    const int fd = (name) ? create_named_fd(name) : create_anonymous_fd();
+
+    if (fd < 0) {
+        return false;
+    }
+
+    if (::ftruncate(fd, static_cast<off_t>(mapped_size)) != 0) {
+        ::close(fd);
+        if (name) {
+            unlink(name);
+        }
+        return false;
+    }
+
+    void *base = ::mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    if (base == MAP_FAILED) {
+        ::close(fd);
+        if (name) {
+            unlink(name);
+        }
+        return false;
+    }
+
+    // NOTE: ftruncate() fills the area with zero, so zero_clear only matters
+    // for reused pages on exotic platforms
+    if (zero_clear) {
+        ::memset(static_cast<char *>(base) + data_offset, 0, mapped_size - data_offset);
+    }
+
+    header_type *header = static_cast<header_type *>(base);
+
+    header->version = header_type::VERSION;
+    header->header_size = sizeof(header_type);
+    header->alignment = static_cast<uint32_t>(alignment);
+    header->element_size = element_size;
+    header->num_elements = num_elements;
+    header->data_offset = data_offset;
+    header->mapped_size = mapped_size;
+
+    // publish the header (magic is checked last by the readers)
+    std::atomic_thread_fence(std::memory_order_release);
+    header->magic = header_type::MAGIC;
+
+    fd_ = fd;
+    base_ = base;
+    mapped_size_ = mapped_size;
+    header_ = header;
+    data_ = static_cast<char *>(base) + data_offset;
+    num_elements_ = num_elements;
+
+    return true;
+#else
+    (void)name;
+    (void)element_size;
+    (void)num_elements;
+    (void)alignment;
+    (void)zero_clear;
+    return false;
+#endif
+}
+
+bool shared_memory_block::open(const char *name, std::size_t element_size, bool read_only) CXXPH_NOEXCEPT
+{
+    close();
+
+#if CXXPH_SHARED_MEMORY_POSIX
+    if (!name) {
+        return false;
+    }
+
+    const int fd = open_named_fd(name, read_only);
+
+    if (fd < 0) {
+        return false;
+    }
+
+    if (!map(fd, element_size, read_only)) {
+        ::close(fd);
+        return false;
+    }
+
+    return true;
+#else
+    (void)name;
+    (void)element_size;
+    (void)read_only;
+    return false;
+#endif
+}
+
+bool shared_memory_block::attach(int fd, std::size_t element_size, bool read_only) CXXPH_NOEXCEPT
+{
+    close();
+
+#if CXXPH_SHARED_MEMORY_POSIX
+    if (fd < 0) {
+        return false;
+    }
+
+    const int dup_fd = ::dup(fd);
+
+    if (dup_fd < 0) {
+        return false;
+    }
+
+    if (!map(dup_fd, element_size, read_only)) {
+        ::close(dup_fd);
+        return false;
+    }
+
+    return true;
+#else
+    (void)fd;
+    (void)element_size;
+    (void)read_only;
+    return false;
+#endif
+}
+
+void shared_memory_block::close() CXXPH_NOEXCEPT
+{
+#if CXXPH_SHARED_MEMORY_POSIX
+    if (base_) {
+        ::munmap(base_, mapped_size_);
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+#endif
+
+    fd_ = -1;
+    base_ = nullptr;
+    mapped_size_ = 0;
+    header_ = nullptr;
+    data_ = nullptr;
+    num_elements_ = 0;
+}
+
+bool shared_memory_block::unlink(const char *name) CXXPH_NOEXCEPT
+{
+#if CXXPH_SHARED_MEMORY_HAS_SHM_OPEN
+    return (name) && (::shm_unlink(name) == 0);
+#else
+    (void)name;
+    return false;
+#endif
+}
+
+bool shared_memory_block::map(int fd, std::size_t element_size, bool read_only) CXXPH_NOEXCEPT
+{
+#if CXXPH_SHARED_MEMORY_POSIX
+    struct stat st;
+
+    if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(header_type)) {
+        return false;
+    }
+
+    const std::size_t file_size = static_cast<std::size_t>(st.st_size);
+    const std::size_t page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    const int prot = (read_only) ? PROT_READ : (PROT_READ | PROT_WRITE);
+
+    void *base = ::mmap(nullptr, file_size, prot, MAP_SHARED, fd, 0);
+
+    if (base == MAP_FAILED) {
+        return false;
+    }
+
+    const header_type *header = static_cast<const header_type *>(base);
+
+    bool valid = (header->magic == header_type::MAGIC);
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    valid = valid && (element_size != 0) && (header->version == header_type::VERSION) &&
+            (header->header_size == sizeof(header_type)) && (header->element_size == element_size) &&
+            (header->mapped_size == file_size) && (header->data_offset >= sizeof(header_type)) &&
+            is_pow_of_two(header->alignment) && (header->alignment <= page_size) &&
+            ((header->data_offset & (header->alignment - 1)) == 0) && (header->data_offset <= file_size) &&
+            (header->num_elements <= (file_size - header->data_offset) / element_size);
+
+    if (!valid) {
+        ::munmap(base, file_size);
+        return false;
+    }
+
+    fd_ = fd;
+    base_ = base;
+    mapped_size_ = file_size;
+    header_ = header;
+    data_ = static_cast<char *>(base) + header->data_offset;
+    num_elements_ = static_cast<std::size_t>(header->num_elements);
+
+    return true;
+#else
+    (void)fd;
+    (void)element_size;
+    (void)read_only;
+    return false;
+#endif
+}
+
+void shared_memory_block::swap(shared_memory_block &other) CXXPH_NOEXCEPT
+{
+    std::swap(fd_, other.fd_);
+    std::swap(base_, other.base_);
+    std::swap(mapped_size_, other.mapped_size_);
+    std::swap(header_, other.header_);
+    std::swap(data_, other.data_);
+    std::swap(num_elements_, other.num_elements_);
+}
+
+} // namespace cxxporthelper
@@ -0,0 +1,84 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include <cxxporthelper/vector_math.hpp>
+
+#include <cxxporthelper/dispatch.hpp>
+#include <cxxporthelper/impl/kernel_isa.hpp>
+
+namespace cxxporthelper {
+namespace vector_math {
+
+typedef void (*unary_func_t)(float *, const float *, std::size_t);
+typedef void (*pow_array_exponent_func_t)(float *, const float *, const float *, std::size_t);
+typedef void (*pow_scalar_exponent_func_t)(float *, const float *, float, std::size_t);
+typedef void (*sincos_func_t)(float *, float *, const float *, std::size_t);
+
+#define CXXPH_VECTOR_MATH_DEFINE_UNARY_FUNCTION(name)                                                                  \
+    CXXPH_KERNEL_DECLARE_VARIANTS(void, name##_kernel, (float *dest, const float *src, std::size_t n))                 \
+                                                                                                                       \
+    static const dispatch::kernel_variant<unary_func_t> name##_variants[] = {                                          \
+        CXXPH_KERNEL_VARIANT_TABLE_ENTRIES(name##_kernel)                                                              \
+    };                                                                                                                 \
+                                                                                                                       \
+    CXXPH_DISPATCH_DEFINE_FUNCTION(void, name, (float *dest, const float *src, std::size_t n), (dest, src, n),         \
+                                   name##_variants)
+
+CXXPH_VECTOR_MATH_DEFINE_UNARY_FUNCTION(exp)
+CXXPH_VECTOR_MATH_DEFINE_UNARY_FUNCTION(log)
+CXXPH_VECTOR_MATH_DEFINE_UNARY_FUNCTION(sin)
+CXXPH_VECTOR_MATH_DEFINE_UNARY_FUNCTION(cos)
+CXXPH_VECTOR_MATH_DEFINE_UNARY_FUNCTION(tanh)
+CXXPH_VECTOR_MATH_DEFINE_UNARY_FUNCTION(sqrt)
+CXXPH_VECTOR_MATH_DEFINE_UNARY_FUNCTION(rsqrt)
+
+#undef CXXPH_VECTOR_MATH_DEFINE_UNARY_FUNCTION
+
+// pow()
+CXXPH_KERNEL_DECLARE_VARIANTS(void, pow_array_exponent_kernel,
+                              (float *dest, const float *base, const float *exponent, std::size_t n))
+CXXPH_KERNEL_DECLARE_VARIANTS(void, pow_scalar_exponent_kernel,
+                              (float *dest, const float *base, float exponent, std::size_t n))
+
+static const dispatch::kernel_variant<pow_array_exponent_func_t> pow_array_exponent_variants[] = {
+    CXXPH_KERNEL_VARIANT_TABLE_ENTRIES(pow_array_exponent_kernel)
+};
+
+static const dispatch::kernel_variant<pow_scalar_exponent_func_t> pow_scalar_exponent_variants[] = {
+    CXXPH_KERNEL_VARIANT_TABLE_ENTRIES(pow_scalar_exponent_kernel)
+};
+
+CXXPH_DISPATCH_DEFINE_FUNCTION(void, pow_array_exponent,
+                               (float *dest, const float *base, const float *exponent, std::size_t n),
+                               (dest, base, exponent, n), pow_array_exponent_variants)
+
+CXXPH_DISPATCH_DEFINE_FUNCTION(void, pow_scalar_exponent,
+                               (float *dest, const float *base, float exponent, std::size_t n),
+                               (dest, base, exponent, n), pow_scalar_exponent_variants)
+
+// sincos()
+CXXPH_KERNEL_DECLARE_VARIANTS(void, sincos_kernel,
+                              (float *dest_sin, float *dest_cos, const float *src, std::size_t n))
+
+static const dispatch::kernel_variant<sincos_func_t> sincos_variants[] = {
+    CXXPH_KERNEL_VARIANT_TABLE_ENTRIES(sincos_kernel)
+};
+
+CXXPH_DISPATCH_DEFINE_FUNCTION(void, sincos, (float *dest_sin, float *dest_cos, const float *src, std::size_t n),
+                               (dest_sin, dest_cos, src, n), sincos_variants)
+
+} // namespace vector_math
+} // namespace cxxporthelper
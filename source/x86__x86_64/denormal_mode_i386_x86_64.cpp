@@ -0,0 +1,139 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include <cxxporthelper/compiler.hpp>
+
+#if (CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)
+
+#include <cstring>
+
+#include <cxxporthelper/cstdint>
+#include <cxxporthelper/denormal_mode.hpp>
+#include <cxxporthelper/platform_info.hpp>
+#include <cxxporthelper/x86_intrinsics.hpp>
+
+namespace cxxporthelper {
+namespace denormal_mode {
+
+#if CXXPH_COMPILER_SUPPORTS_X86_SSE
+static const uint32_t MXCSR_DAZ = (1u << 6);
+static const uint32_t MXCSR_FTZ = (1u << 15);
+
+// NOTE: DAZ is not implemented on some early SSE/SSE2 CPUs (setting it raises #GP),
+// MXCSR_MASK stored by FXSAVE tells whether it is writable.
+static uint32_t get_mxcsr_mask() CXXPH_NOEXCEPT
+{
+    CXXPH_ALIGNAS(16) unsigned char area[512];
+    uint32_t mask;
+
+    std::memset(area, 0, sizeof(area));
+#if CXXPH_COMPILER_IS_MSVC
+    ::_fxsave(area);
+#else
+    __asm__ __volatile__("fxsave %0" : "=m"(area));
+#endif
+    std::memcpy(&mask, &area[28], sizeof(mask));
+
+    // zero means the default mask (DAZ not supported)
+    return (mask != 0) ? mask : 0x0000ffbfu;
+}
+
+static unsigned int detect_supported_modes() CXXPH_NOEXCEPT
+{
+    if (!platform_info::support_sse()) {
+        return 0;
+    }
+
+    unsigned int modes = MODE_FLUSH_TO_ZERO;
+
+    if (get_mxcsr_mask() & MXCSR_DAZ) {
+        modes |= MODE_DENORMALS_ARE_ZERO;
+    }
+
+    return modes;
+}
+
+static inline unsigned int mxcsr_to_mode(uint32_t csr) CXXPH_NOEXCEPT
+{
+    unsigned int mode = 0;
+
+    if (csr & MXCSR_FTZ) {
+        mode |= MODE_FLUSH_TO_ZERO;
+    }
+    if (csr & MXCSR_DAZ) {
+        mode |= MODE_DENORMALS_ARE_ZERO;
+    }
+
+    return mode;
+}
+
+unsigned int get_supported_modes() CXXPH_NOEXCEPT
+{
+    static const unsigned int modes = detect_supported_modes();
+    return modes;
+}
+
+unsigned int get_mode() CXXPH_NOEXCEPT
+{
+    if (!get_supported_modes()) {
+        return 0;
+    }
+
+    return mxcsr_to_mode(_mm_getcsr());
+}
+
+unsigned int set_mode(unsigned int mode) CXXPH_NOEXCEPT
+{
+    const unsigned int supported = get_supported_modes();
+
+    if (!supported) {
+        return 0;
+    }
+
+    const uint32_t csr = _mm_getcsr();
+    uint32_t new_csr = csr & ~(MXCSR_FTZ | MXCSR_DAZ);
+
+    mode &= supported;
+
+    if (mode & MODE_FLUSH_TO_ZERO) {
+        new_csr |= MXCSR_FTZ;
+    }
+    if (mode & MODE_DENORMALS_ARE_ZERO) {
+        new_csr |= MXCSR_DAZ;
+    }
+
+    if (new_csr != csr) {
+        _mm_setcsr(new_csr);
+    }
+
+    return mxcsr_to_mode(csr);
+}
+#else
+unsigned int get_supported_modes() CXXPH_NOEXCEPT { return 0; }
+
+unsigned int get_mode() CXXPH_NOEXCEPT { return 0; }
+
+unsigned int set_mode(unsigned int mode) CXXPH_NOEXCEPT
+{
+    (void)mode;
+    return 0;
+}
+#endif
+
+} // namespace denormal_mode
+} // namespace cxxporthelper
+
+#endif
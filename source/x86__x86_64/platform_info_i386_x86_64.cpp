@@ -58,7 +58,21 @@ static inline void cpuid(uint32_t in_eax, uint32_t in_ecx, cpuid_info *info)
 #else
 static inline void cpuid(uint32_t in_eax, uint32_t in_ecx, cpuid_info *info)
 {
-    ::__get_cpuid(in_eax, &(info->eax), &(info->ebx), &(info->ecx), &(info->edx));
+    // NOTE: __get_cpuid() does not set the sub-leaf index (ecx)
+    __cpuid_count(in_eax, in_ecx, info->eax, info->ebx, info->ecx, info->edx);
+}
+#endif
+
+// read extended control register (requires OSXSAVE)
+#if CXXPH_COMPILER_IS_MSVC
+static inline uint64_t xgetbv(uint32_t index) { return static_cast<uint64_t>(::_xgetbv(index)); }
+#else
+static inline uint64_t xgetbv(uint32_t index)
+{
+    uint32_t eax, edx;
+    // NOTE: xgetbv is emitted as raw bytes for old assemblers (_xgetbv() requires -mxsave)
+    __asm__ __volatile__(".byte 0x0f, 0x01, 0xd0" : "=a"(eax), "=d"(edx) : "c"(index));
+    return ((static_cast<uint64_t>(edx) << 32) | eax);
 }
 #endif
 
@@ -68,6 +82,8 @@ void i386_x86_64_collect_platform_info(std::bitset<platform_info_provider::NUM_F
 
     uint32_t num_ids = 0;
     uint32_t num_ex_ids = 0;
+    bool os_saves_ymm = false;
+    bool os_saves_zmm = false;
 #ifdef CPUID_DEBUG
     union {
         uint32_t u32[3];
@@ -118,6 +134,14 @@ void i386_x86_64_collect_platform_info(std::bitset<platform_info_provider::NUM_F
         features.set(flags::FEATURE_INDEX_X86_FMA, ecx[12]);
         features.set(flags::FEATURE_INDEX_X86_MOVBE, ecx[22]);
         features.set(flags::FEATURE_INDEX_X86_POPCNT, ecx[23]);
+        features.set(flags::FEATURE_INDEX_X86_F16C, ecx[29]);
+
+        // check the OS saves the YMM / ZMM registers on context switch (OSXSAVE)
+        if (ecx[27]) {
+            const uint64_t xcr0 = xgetbv(0);
+            os_saves_ymm = ((xcr0 & 0x06) == 0x06);
+            os_saves_zmm = ((xcr0 & 0xe6) == 0xe6);
+        }
     }
 
     // get extended features (eax = 7, ecx = 0)
@@ -127,7 +151,9 @@ void i386_x86_64_collect_platform_info(std::bitset<platform_info_provider::NUM_F
 
         const std::bitset<32> ebx(info.ebx);
 
+        features.set(flags::FEATURE_INDEX_X86_BMI1, ebx[3]);
         features.set(flags::FEATURE_INDEX_X86_AVX2, ebx[5]);
+        features.set(flags::FEATURE_INDEX_X86_BMI2, ebx[8]);
         features.set(flags::FEATURE_INDEX_X86_AVX512F, ebx[16]);
         features.set(flags::FEATURE_INDEX_X86_AVX512DQ, ebx[17]);
         features.set(flags::FEATURE_INDEX_X86_AVX512PF, ebx[26]);
@@ -151,9 +177,28 @@ void i386_x86_64_collect_platform_info(std::bitset<platform_info_provider::NUM_F
 
         const std::bitset<32> ecx(info.ecx);
 
+        features.set(flags::FEATURE_INDEX_X86_LZCNT, ecx[5]);
         features.set(flags::FEATURE_INDEX_X86_SSE4A, ecx[6]);
     }
 
+    // AVX family instructions cannot be used without the OS support
+    if (!os_saves_ymm) {
+        features.reset(flags::FEATURE_INDEX_X86_AVX);
+        features.reset(flags::FEATURE_INDEX_X86_AVX2);
+        features.reset(flags::FEATURE_INDEX_X86_FMA);
+        features.reset(flags::FEATURE_INDEX_X86_F16C);
+    }
+
+    if (!os_saves_zmm) {
+        features.reset(flags::FEATURE_INDEX_X86_AVX512F);
+        features.reset(flags::FEATURE_INDEX_X86_AVX512CD);
+        features.reset(flags::FEATURE_INDEX_X86_AVX512DQ);
+        features.reset(flags::FEATURE_INDEX_X86_AVX512BW);
+        features.reset(flags::FEATURE_INDEX_X86_AVX512VL);
+        features.reset(flags::FEATURE_INDEX_X86_AVX512PF);
+        features.reset(flags::FEATURE_INDEX_X86_AVX512ER);
+    }
+
 #ifdef CPUID_DEBUG
     // get processor brand string (eax = 0x80000002, 0x80000003, 0x80000004)
     if (num_ex_ids >= 5) {
@@ -183,6 +228,10 @@ void i386_x86_64_collect_platform_info(std::bitset<platform_info_provider::NUM_F
     printf("avx = %d\n", static_cast<bool>(features[flags::FEATURE_INDEX_X86_AVX]));
     printf("movbe = %d\n", static_cast<bool>(features[flags::FEATURE_INDEX_X86_MOVBE]));
     printf("popcnt = %d\n", static_cast<bool>(features[flags::FEATURE_INDEX_X86_POPCNT]));
+    printf("f16c = %d\n", static_cast<bool>(features[flags::FEATURE_INDEX_X86_F16C]));
+    printf("bmi1 = %d\n", static_cast<bool>(features[flags::FEATURE_INDEX_X86_BMI1]));
+    printf("bmi2 = %d\n", static_cast<bool>(features[flags::FEATURE_INDEX_X86_BMI2]));
+    printf("lzcnt = %d\n", static_cast<bool>(features[flags::FEATURE_INDEX_X86_LZCNT]));
 #endif
 }
 